@@ -63,11 +63,41 @@
 /// 
 /// 
 /// 
-/// query.groupby(keymap [, keyequal])
-/// ====================================
+/// query.groupby(keymap [, keyless])
+/// ===================================
 /// Result: Query of groups. Each group has a 'key' field, and is a query of elements from the input.
 /// Powers: forward
 /// 
+/// Groups appear in the order of their first element in the input, and the elements of each group
+/// keep their input order. Keys that std::hash supports are found through a hash table. Other keys,
+/// or any keys when `keyless` is given, are found through an ordered map.
+/// 
+/// 
+/// 
+/// query.distinct([hash, eq]), query.union_with(second [, hash, eq]), 
+/// query.intersect(second [, hash, eq]), query.except(second [, hash, eq])
+/// ===========================================================================
+/// -   Result: Query
+/// -   Powers: input
+/// 
+/// Set operators over a hash set of the elements seen so far, evaluated lazily. `distinct` produces 
+/// the first occurrence of each element. `union_with` produces the distinct elements of the query 
+/// and then those of `second` that were not already produced. `intersect` and `except` produce the 
+/// distinct elements of the query that are, or are not, in `second`; `second` is read into a hash 
+/// set when the query is first enumerated. All keep the order of the query.
+/// 
+/// 
+/// 
+/// query.join(inner, outerkey, innerkey, result)
+/// ==============================================
+/// -   Result: Query
+/// -   Powers: input, forward
+/// 
+/// For each pair of `x` in the query and `y` in `inner` with equal keys, computes `result(x, y)`.
+/// When the query is first enumerated, `inner` is read into a hash table by key and the query is 
+/// streamed against it. Results follow the order of the query, and the matches of each `x` follow 
+/// the order of `inner`.
+/// 
 /// 
 /// 
 /// query.any([pred])
@@ -98,6 +128,23 @@
 /// 
 /// 
 /// 
+/// query.order_by(keymap [, keyless]), query.order_by_descending(keymap [, keyless])
+/// ==================================================================================
+/// -   Result: Ordered query
+/// -   Powers: random access
+/// 
+/// Sorts the sequence by `keymap(x)`, when the query is first enumerated. The sort is stable, and
+/// `keymap` is called once per element: the keys are stored next to the elements while sorting.
+/// 
+/// `then_by(keymap [, keyless])` and `then_by_descending(keymap [, keyless])` add keys that order 
+/// the elements with equal earlier keys.
+/// 
+/// `take(n)` on an ordered query selects the first `n` elements with a bounded heap, instead of 
+/// sorting the whole sequence. The result is a query, not an ordered query, so `then_by` cannot 
+/// follow it.
+/// 
+/// 
+/// 
 /// query.skip(n)
 /// =============
 /// -   Result: query
@@ -110,6 +157,19 @@
 /// 
 /// 
 /// 
+/// query.parallel([n])
+/// ====================
+/// -   Result: Parallel query
+/// -   Requires: random access
+/// 
+/// Splits the sequence into `n` contiguous partitions, one per thread (default: one per hardware
+/// thread). The parallel query supports `select` and `where`, which run on each partition, and
+/// `aggregate`, `count`, `sum`, `min`, `max` and `to_vector`, which merge the results of the partitions
+/// in partition order. Selectors and predicates must be safe to call concurrently, and the function
+/// passed to `aggregate` must be associative.
+/// 
+/// 
+/// 
 /// query.count([pred])
 /// ===================
 /// -   Result: std::size_t
@@ -141,6 +201,8 @@
 #include <list>
 #include <map>
 #include <set>
+#include <unordered_set>
+#include <unordered_map>
 #include <memory>
 #include <utility>
 #include <type_traits>
@@ -176,9 +238,13 @@
 #include "linq_take.hpp"
 #include "linq_skip.hpp"
 #include "linq_groupby.hpp"
+#include "linq_distinct.hpp"
+#include "linq_join.hpp"
+#include "linq_orderby.hpp"
 #include "linq_where.hpp"
 #include "linq_last.hpp"
 #include "linq_selectmany.hpp"
+#include "linq_parallel.hpp"
 
 
 
@@ -226,6 +292,7 @@ public:
         iterator;
 
     linq_driver(Collection c) : c(c) {}
+    linq_driver(const linq_driver& other) : c(other.c) {}
 
 
     // -------------------- linq core methods --------------------
@@ -236,9 +303,18 @@ public:
         return linq_groupby<Collection, KeyFn>(c, std::move(fn) );
     }
 
-    // TODO: groupby(keyfn, eq)
+    template <class KeyFn, class Compare>
+    linq_driver< linq_groupby<Collection, KeyFn, Compare> > groupby(KeyFn fn, Compare less)
+    {
+        return linq_groupby<Collection, KeyFn, Compare>(c, std::move(fn), std::move(less) );
+    }
 
-    // TODO: join...
+    template <class Inner, class OuterKey, class InnerKey, class Result>
+    linq_driver< linq_join<Collection, linq_driver<Inner>, OuterKey, InnerKey, Result> > 
+        join(const linq_driver<Inner>& inner, OuterKey outerKey, InnerKey innerKey, Result result) const
+    {
+        return linq_join<Collection, linq_driver<Inner>, OuterKey, InnerKey, Result>(c, inner, std::move(outerKey), std::move(innerKey), std::move(result));
+    }
 
     template <class Selector>
     linq_driver< linq_select<Collection, Selector> > select(Selector sel) const {
@@ -329,8 +405,16 @@ public:
 
     // TODO: default_if_empty
     
-    // TODO: distinct()
-    // TODO: distinct(cmp)
+    linq_driver< linq_distinct<Collection, std::hash<element_type>, std::equal_to<element_type>> > distinct() const
+    {
+        return distinct(std::hash<element_type>(), std::equal_to<element_type>());
+    }
+
+    template <class Hash, class Eq>
+    linq_driver< linq_distinct<Collection, Hash, Eq> > distinct(Hash hash, Eq eq) const
+    {
+        return linq_distinct<Collection, Hash, Eq>(c, std::move(hash), std::move(eq));
+    }
 
     reference_type element_at(std::size_t ix) const {
         auto cur = c.get_cursor();
@@ -356,8 +440,19 @@ public:
         return !this->any();
     }
 
-    // TODO: except(second)
-    // TODO: except(second, eq)
+    template <class Second>
+    linq_driver< linq_set_filter<Collection, linq_driver<Second>, std::hash<element_type>, std::equal_to<element_type>> > 
+        except(const linq_driver<Second>& second) const
+    {
+        return except(second, std::hash<element_type>(), std::equal_to<element_type>());
+    }
+
+    template <class Second, class Hash, class Eq>
+    linq_driver< linq_set_filter<Collection, linq_driver<Second>, Hash, Eq> > 
+        except(const linq_driver<Second>& second, Hash hash, Eq eq) const
+    {
+        return linq_set_filter<Collection, linq_driver<Second>, Hash, Eq>(c, second, std::move(hash), std::move(eq), false);
+    }
 
     reference_type first() const {
         auto cur = c.get_cursor();
@@ -391,8 +486,19 @@ public:
         else             { return cur.get(); }
     }
     
-    // TODO: intersect(second)
-    // TODO: intersect(second, eq)
+    template <class Second>
+    linq_driver< linq_set_filter<Collection, linq_driver<Second>, std::hash<element_type>, std::equal_to<element_type>> > 
+        intersect(const linq_driver<Second>& second) const
+    {
+        return intersect(second, std::hash<element_type>(), std::equal_to<element_type>());
+    }
+
+    template <class Second, class Hash, class Eq>
+    linq_driver< linq_set_filter<Collection, linq_driver<Second>, Hash, Eq> > 
+        intersect(const linq_driver<Second>& second, Hash hash, Eq eq) const
+    {
+        return linq_set_filter<Collection, linq_driver<Second>, Hash, Eq>(c, second, std::move(hash), std::move(eq), true);
+    }
 
     // note: forward cursors and beyond can provide a clone, so we can refer to the element directly
     typename std::conditional< 
@@ -455,10 +561,33 @@ public:
         return *it;
     }
 
-    // TODO: order_by(sel)
-    // TODO: order_by(sel, less)
-    // TODO: order_by_descending(sel)
-    // TODO: order_by_descending(sel, less)
+    template <class Selector>
+    linq_driver< linq_orderby<Collection, detail::orderby_keys_step<element_type, detail::orderby_keys_root<element_type>, Selector, default_less>> >
+        order_by(Selector sel) const
+    {
+        return order_by(std::move(sel), default_less());
+    }
+
+    template <class Selector, class Less>
+    linq_driver< linq_orderby<Collection, detail::orderby_keys_step<element_type, detail::orderby_keys_root<element_type>, Selector, Less>> >
+        order_by(Selector sel, Less less) const
+    {
+        return order_by_(std::move(sel), std::move(less), false);
+    }
+
+    template <class Selector>
+    linq_driver< linq_orderby<Collection, detail::orderby_keys_step<element_type, detail::orderby_keys_root<element_type>, Selector, default_less>> >
+        order_by_descending(Selector sel) const
+    {
+        return order_by_descending(std::move(sel), default_less());
+    }
+
+    template <class Selector, class Less>
+    linq_driver< linq_orderby<Collection, detail::orderby_keys_step<element_type, detail::orderby_keys_root<element_type>, Selector, Less>> >
+        order_by_descending(Selector sel, Less less) const
+    {
+        return order_by_(std::move(sel), std::move(less), true);
+    }
 
     // TODO: sequence_equal(second)
     // TODO: sequence_equal(second, eq)
@@ -471,6 +600,18 @@ public:
 
     // TODO: skip_while(pred)
 
+    linq_parallel<Collection> parallel(std::size_t n) const {
+        static_assert(util::less_or_equal_cursor_category<
+                          random_access_cursor_tag,
+                          typename Collection::cursor::cursor_category>::value,
+                      "parallel() requires a random access collection");
+        return linq_parallel<Collection>(c, n);
+    }
+
+    linq_parallel<Collection> parallel() const {
+        return parallel(std::thread::hardware_concurrency());
+    }
+
     template<typename ITEM = element_type>
     typename std::enable_if<std::is_default_constructible<ITEM>::value, ITEM>::type sum() const {
         ITEM seed{};
@@ -491,18 +632,60 @@ public:
         return from(begin(), end()).select(sel).sum(seed);			
     }
 
-    linq_driver<linq_take<Collection>> take(std::size_t n) const {
-        return linq_take<Collection>(c, n);
+    auto take(std::size_t n) const
+    -> linq_driver<decltype(detail::take_(*static_cast<const Collection*>(0), n))>
+    {
+        return detail::take_(c, n);
     }
 
     // TODO: take_while
 
-    // TODO: then_by / then_by_descending ?
+    // then_by is only available on the result of order_by or then_by
+
+    template <class Selector, class C = Collection>
+    auto then_by(Selector sel) const
+    -> linq_driver<decltype(static_cast<const C*>(0)->then_by(sel, default_less(), false))>
+    {
+        return c.then_by(std::move(sel), default_less(), false);
+    }
+
+    template <class Selector, class Less, class C = Collection>
+    auto then_by(Selector sel, Less less) const
+    -> linq_driver<decltype(static_cast<const C*>(0)->then_by(sel, less, false))>
+    {
+        return c.then_by(std::move(sel), std::move(less), false);
+    }
+
+    template <class Selector, class C = Collection>
+    auto then_by_descending(Selector sel) const
+    -> linq_driver<decltype(static_cast<const C*>(0)->then_by(sel, default_less(), true))>
+    {
+        return c.then_by(std::move(sel), default_less(), true);
+    }
+
+    template <class Selector, class Less, class C = Collection>
+    auto then_by_descending(Selector sel, Less less) const
+    -> linq_driver<decltype(static_cast<const C*>(0)->then_by(sel, less, true))>
+    {
+        return c.then_by(std::move(sel), std::move(less), true);
+    }
 
     // TODO: to_...
 
-    // TODO: union(second)
-    // TODO: union(eq)
+    // union is a keyword
+    template <class Second>
+    linq_driver< linq_union<Collection, linq_driver<Second>, std::hash<element_type>, std::equal_to<element_type>> > 
+        union_with(const linq_driver<Second>& second) const
+    {
+        return union_with(second, std::hash<element_type>(), std::equal_to<element_type>());
+    }
+
+    template <class Second, class Hash, class Eq>
+    linq_driver< linq_union<Collection, linq_driver<Second>, Hash, Eq> > 
+        union_with(const linq_driver<Second>& second, Hash hash, Eq eq) const
+    {
+        return linq_union<Collection, linq_driver<Second>, Hash, Eq>(c, second, std::move(hash), std::move(eq));
+    }
 
     // TODO: zip
     
@@ -539,7 +722,7 @@ public:
     // -------------------- collection methods (leaky abstraction) --------------------
 
     typedef typename Collection::cursor cursor;
-    cursor get_cursor() { return c.get_cursor(); }
+    cursor get_cursor() const { return c.get_cursor(); }
 
     linq_driver< dynamic_collection<typename Collection::cursor::reference_type> >
         late_bind() const
@@ -548,6 +731,14 @@ public:
     }
 
 private: 
+    template <class Selector, class Less>
+    linq_driver< linq_orderby<Collection, detail::orderby_keys_step<element_type, detail::orderby_keys_root<element_type>, Selector, Less>> >
+        order_by_(Selector sel, Less less, bool descending) const
+    {
+        typedef detail::orderby_keys_step<element_type, detail::orderby_keys_root<element_type>, Selector, Less> keys_type;
+        return linq_orderby<Collection, keys_type>(c, keys_type(detail::orderby_keys_root<element_type>(), std::move(sel), std::move(less), descending));
+    }
+
     Collection c;
 };
  
@@ -169,8 +169,8 @@ namespace cpplinq {
         }
         
         void skip(std::ptrdiff_t n) { current += n; }
-        std::size_t size() { return fin-start; }
-        void position() { return current-start; }
+        std::size_t size() const { return fin-start; }
+        std::size_t position() const { return current-start; }
         void truncate(std::size_t n) {
             if (n > fin-current) {
                 fin = current + n;
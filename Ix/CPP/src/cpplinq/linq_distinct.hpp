@@ -0,0 +1,206 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#if !defined(CPPLINQ_LINQ_DISTINCT_HPP)
+#define CPPLINQ_LINQ_DISTINCT_HPP
+#pragma once
+
+#include <unordered_set>
+
+namespace cpplinq
+{
+    // the set operators remember the elements they have seen in a hash set
+    //   that is shared by copies of a cursor, so their cursors are onepass.
+
+    template <class Collection, class Hash, class Eq>
+    class linq_distinct
+    {
+        typedef typename Collection::cursor
+            inner_cursor;
+    public:
+        struct cursor {
+            typedef onepass_cursor_tag
+                cursor_category;
+            typedef typename inner_cursor::element_type
+                element_type;
+            typedef typename inner_cursor::reference_type
+                reference_type;
+            typedef std::unordered_set<element_type, Hash, Eq>
+                set_type;
+
+            cursor(const inner_cursor& cur, std::shared_ptr<set_type> seen) : cur(cur), seen(std::move(seen))
+            {
+                if (!this->cur.empty() && !this->seen->insert(this->cur.get()).second) {
+                    this->inc();
+                }
+            }
+
+            bool empty() const { return cur.empty(); }
+            void inc() {
+                for (;;) {
+                    cur.inc();
+                    if (cur.empty() || seen->insert(cur.get()).second) break;
+                }
+            }
+            reference_type get() const {
+                return cur.get();
+            }
+
+        private:
+            inner_cursor cur;
+            std::shared_ptr<set_type> seen;
+        };
+
+        linq_distinct(const Collection& c, Hash hash, Eq eq) : c(c), hash(hash), eq(eq) {}
+
+        cursor get_cursor() const {
+            return cursor(c.get_cursor(), std::make_shared<typename cursor::set_type>(0, hash, eq));
+        }
+
+    private:
+        Collection c;
+        Hash       hash;
+        Eq         eq;
+    };
+
+    // the distinct elements of the first sequence followed by the distinct
+    //   elements of the second sequence that were not in the first.
+    template <class Collection, class Second, class Hash, class Eq>
+    class linq_union
+    {
+        typedef typename Collection::cursor
+            inner_cursor;
+        typedef typename Second::cursor
+            second_cursor;
+    public:
+        struct cursor {
+            typedef onepass_cursor_tag
+                cursor_category;
+            typedef typename inner_cursor::element_type
+                element_type;
+            typedef element_type
+                reference_type;
+            typedef std::unordered_set<element_type, Hash, Eq>
+                set_type;
+
+            cursor(const inner_cursor& cur, const second_cursor& cur2, std::shared_ptr<set_type> seen)
+            : cur(cur), cur2(cur2), seen(std::move(seen))
+            {
+                if (!empty() && !this->seen->insert(get()).second) {
+                    this->inc();
+                }
+            }
+
+            bool empty() const { return cur.empty() && cur2.empty(); }
+            void inc() {
+                for (;;) {
+                    if (!cur.empty()) {
+                        cur.inc();
+                    } else {
+                        cur2.inc();
+                    }
+                    if (empty() || seen->insert(get()).second) break;
+                }
+            }
+            reference_type get() const {
+                if (!cur.empty()) {
+                    return cur.get();
+                }
+                return cur2.get();
+            }
+
+        private:
+            inner_cursor  cur;
+            second_cursor cur2;
+            std::shared_ptr<set_type> seen;
+        };
+
+        linq_union(const Collection& c, const Second& second, Hash hash, Eq eq) : c(c), second(second), hash(hash), eq(eq) {}
+
+        cursor get_cursor() const {
+            return cursor(c.get_cursor(), second.get_cursor(), std::make_shared<typename cursor::set_type>(0, hash, eq));
+        }
+
+    private:
+        Collection c;
+        Second     second;
+        Hash       hash;
+        Eq         eq;
+    };
+
+    // intersect keeps the distinct elements of the first sequence that are
+    //   in the second, except keeps the distinct elements that are not. the
+    //   second sequence is read into a hash set when the first cursor is
+    //   requested and the first sequence is streamed.
+    template <class Collection, class Second, class Hash, class Eq>
+    class linq_set_filter
+    {
+        typedef typename Collection::cursor
+            inner_cursor;
+    public:
+        struct cursor {
+            typedef onepass_cursor_tag
+                cursor_category;
+            typedef typename inner_cursor::element_type
+                element_type;
+            typedef typename inner_cursor::reference_type
+                reference_type;
+            typedef std::unordered_set<element_type, Hash, Eq>
+                set_type;
+
+            cursor(const inner_cursor& cur, std::shared_ptr<set_type> set, bool intersect)
+            : cur(cur), set(std::move(set)), intersect(intersect)
+            {
+                if (!this->cur.empty() && !accept()) {
+                    this->inc();
+                }
+            }
+
+            bool empty() const { return cur.empty(); }
+            void inc() {
+                for (;;) {
+                    cur.inc();
+                    if (cur.empty() || accept()) break;
+                }
+            }
+            reference_type get() const {
+                return cur.get();
+            }
+
+        private:
+            // intersect removes each accepted element from the set and except
+            //   adds it, so that each element is produced once.
+            bool accept() {
+                if (intersect) {
+                    return set->erase(cur.get()) != 0;
+                }
+                return set->insert(cur.get()).second;
+            }
+
+            inner_cursor cur;
+            std::shared_ptr<set_type> set;
+            bool intersect;
+        };
+
+        linq_set_filter(const Collection& c, const Second& second, Hash hash, Eq eq, bool intersect)
+        : c(c), second(second), hash(hash), eq(eq), intersect(intersect)
+        {
+        }
+
+        cursor get_cursor() const {
+            auto set = std::make_shared<typename cursor::set_type>(0, hash, eq);
+            for (auto cur = second.get_cursor(); !cur.empty(); cur.inc()) {
+                set->insert(cur.get());
+            }
+            return cursor(c.get_cursor(), std::move(set), intersect);
+        }
+
+    private:
+        Collection c;
+        Second     second;
+        Hash       hash;
+        Eq         eq;
+        bool       intersect;
+    };
+}
+
+#endif // !defined(CPPLINQ_LINQ_DISTINCT_HPP)
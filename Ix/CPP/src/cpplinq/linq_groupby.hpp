@@ -42,18 +42,52 @@ struct default_less
     }
 };
 
-// progressively constructs grouping as user iterates over groups and elements
-//   within each group. Performs this task by building a std::list of element 
-//   iterators with equal elements within each group.
+namespace detail
+{
+    // maps each key to the index of its group. hashable keys use a hash
+    // table, unless a comparer was given to groupby.
+    template <class Key, class Compare, bool Hashed>
+    struct group_index
+    {
+        std::map<Key, std::size_t, Compare> index;
+
+        explicit group_index(Compare comp) : index(comp)
+        {
+        }
+
+        // returns the index of the group for key, adding next if the key is new
+        std::size_t find_or_add(const Key& key, std::size_t next)
+        {
+            return index.insert(std::make_pair(key, next)).first->second;
+        }
+    };
+
+    template <class Key, class Compare>
+    struct group_index<Key, Compare, true>
+    {
+        std::unordered_map<Key, std::size_t, std::hash<Key>, default_equality> index;
+
+        explicit group_index(Compare)
+        {
+        }
+
+        std::size_t find_or_add(const Key& key, std::size_t next)
+        {
+            return index.insert(std::make_pair(key, next)).first->second;
+        }
+    };
+}
+
+// constructs the grouping when the first cursor is requested. each element 
+//   is tagged with the index of its group, found through a hash table or
+//   an ordered map, and the elements are then placed so that each group is
+//   a contiguous chunk of one vector.
 // 
 // invariants:
 //   - relative order of groups corresponds to relative order of each group's first 
 //     element, as they appeared in the input sequence.
 //   - relative order of elements within a group correspond to relative order
 //     as they appeared in the input sequence.
-// 
-// requires:
-//   Iter must be a forward iterator.
 template <class Collection, class KeyFn, class Compare = default_less>
 class linq_groupby
 {
@@ -63,73 +97,82 @@ class linq_groupby
     typedef typename util::result_of<KeyFn(typename inner_cursor::element_type)>::type
         key_type;
 
-    typedef std::list<typename inner_cursor::element_type>
+    typedef std::vector<typename inner_cursor::element_type>
         element_list_type;
 
     typedef group<typename element_list_type::iterator, key_type> 
         group_type;
 
-    typedef std::list<group_type>
+    typedef std::vector<group_type>
         group_list_type;
 
+    // the default comparer only orders keys, so hashable keys use a hash
+    //   table instead. an explicit comparer keeps the ordered index.
+    typedef detail::group_index<
+            typename std::decay<key_type>::type,
+            Compare,
+            std::is_same<Compare, default_less>::value &&
+                util::is_hashable<typename std::decay<key_type>::type>::value>
+        group_index_type;
+
 private:
     struct impl_t
     {
-        // TODO: would be faster to use a chunked list, where
-        //   pointers are invalidated but iterators are not. Need 
-        //   benchmarks first
-
         element_list_type                           elements;
-        std::list<group_type>                       groups;
-        std::map<key_type, group_type*, Compare>    groupIndex;
-
+        group_list_type                             groups;
 
-
-        KeyFn keySelector;
-        Compare comp;
-        
         impl_t(inner_cursor cur,
                KeyFn keySelector,
                Compare comp = Compare()) 
-        : keySelector(keySelector)
-        , groupIndex(comp)
         {
             // TODO: make lazy
-            insert_all(std::move(cur));
-        }
+            group_index_type                        groupIndex(comp);
+            std::vector<key_type>                   keys;
+            std::vector<std::size_t>                sizes;
+
+            element_list_type                       items;
+            std::vector<std::size_t>                itemGroups;
 
-        void insert_all(inner_cursor cur)
-        {
             while(!cur.empty()) {
-                insert(cur.get());
+                typename inner_cursor::reference_type element = cur.get();
+                key_type key = keySelector(element);
+                std::size_t groupIx = groupIndex.find_or_add(key, keys.size());
+                if (groupIx == keys.size()) {
+                    // new group
+                    keys.push_back(key);
+                    sizes.push_back(0);
+                }
+                ++sizes[groupIx];
+                items.push_back(element);
+                itemGroups.push_back(groupIx);
                 cur.inc();
             }
-        }
-        void insert(typename inner_cursor::reference_type element)
-        {
-            key_type key = keySelector(element);
-            auto groupPos = groupIndex.find(key);
-            if(groupPos == groupIndex.end()) {
-                // new group
-                bool firstGroup = groups.empty();
-
-                elements.push_back(element);
-                if(!firstGroup) {
-                    // pop new element out of previous group
-                    --groups.back().fin; 
-                }
 
-                // build new group
-                groups.push_back(group_type(key));
-                group_type& newGroup = groups.back();
+            // the offset of each group in elements
+            std::vector<std::size_t> next(sizes.size());
+            std::size_t offset = 0;
+            for (std::size_t g = 0; g < sizes.size(); ++g) {
+                next[g] = offset;
+                offset += sizes[g];
+            }
 
-                groupIndex.insert( std::make_pair(key, &newGroup) );
+            // a stable counting sort of the items by group
+            std::vector<std::size_t> order(items.size());
+            for (std::size_t i = 0; i < items.size(); ++i) {
+                order[next[itemGroups[i]]++] = i;
+            }
+            elements.reserve(items.size());
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                elements.push_back(std::move(items[order[i]]));
+            }
 
-                newGroup.fin = elements.end();
-                --(newGroup.start = newGroup.fin);
-            } else {
-                // add to existing group at end
-                elements.insert(groupPos->second->end(), element);
+            groups.reserve(keys.size());
+            auto start = elements.begin();
+            for (std::size_t g = 0; g < keys.size(); ++g) {
+                groups.push_back(group_type(keys[g]));
+                group_type& newGroup = groups.back();
+                newGroup.start = start;
+                newGroup.fin = (start += sizes[g]);
             }
         }
     };
@@ -170,8 +213,8 @@ public:
         
     private:
         std::shared_ptr<impl_t> impl;
-        typename std::list<group_type>::iterator inner;
-        typename std::list<group_type>::iterator fin;
+        typename group_list_type::iterator inner;
+        typename group_list_type::iterator fin;
     };
 
     linq_groupby(Collection     c, 
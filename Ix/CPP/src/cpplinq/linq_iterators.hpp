@@ -114,7 +114,9 @@ namespace cpplinq {
     // decays into a onepass/forward iterator
     template <class Cursor>
     class cursor_iterator 
-        : public std::iterator<std::forward_iterator_tag, 
+        : public std::iterator<typename std::conditional<std::is_convertible<typename Cursor::cursor_category, forward_cursor_tag>::value,
+                                                         std::forward_iterator_tag,
+                                                         std::input_iterator_tag>::type, 
                 typename Cursor::element_type,
                 std::ptrdiff_t,
                 typename std::conditional<std::is_reference<typename Cursor::reference_type>::value,
@@ -162,7 +164,7 @@ namespace cpplinq {
         
     private:
         bool empty() const {
-            !cur || cur->empty();
+            return !cur || cur->empty();
         }
 
         util::maybe<Cursor> cur;
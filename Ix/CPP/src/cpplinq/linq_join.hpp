@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#if !defined(CPPLINQ_LINQ_JOIN_HPP)
+#define CPPLINQ_LINQ_JOIN_HPP
+#pragma once
+
+#include <unordered_map>
+
+namespace cpplinq
+{
+    // an inner equijoin. when the first cursor is requested the inner
+    //   sequence is read into a hash table by key and the outer sequence is
+    //   streamed against it. when the inner size is known (random access) the
+    //   table reserves room for it up front.
+    //
+    // results follow the order of the outer sequence; the matches of each
+    //   outer element follow the order of the inner sequence.
+    template <class Collection, class Inner, class OuterKey, class InnerKey, class Result>
+    class linq_join
+    {
+        typedef typename Collection::cursor
+            outer_cursor;
+        typedef typename Inner::cursor
+            inner_cursor;
+        typedef typename outer_cursor::element_type
+            outer_element;
+        typedef typename inner_cursor::element_type
+            inner_element;
+        typedef typename std::decay<
+                typename util::result_of<OuterKey(const outer_element&)>::type>::type
+            key_type;
+
+        struct state_type
+        {
+            state_type(OuterKey outerKey, InnerKey innerKey, Result result)
+            : outerKey(std::move(outerKey)), innerKey(std::move(innerKey)), result(std::move(result))
+            {
+            }
+
+            OuterKey outerKey;
+            InnerKey innerKey;
+            Result   result;
+            std::unordered_map<key_type, std::vector<inner_element>> innerTable;
+        };
+
+    public:
+        struct cursor {
+            typedef typename util::min_iterator_category<
+                    forward_cursor_tag,
+                    typename util::min_iterator_category<
+                        typename outer_cursor::cursor_category,
+                        typename inner_cursor::cursor_category>::type>::type
+                cursor_category;
+            typedef typename std::decay<
+                    typename util::result_of<Result(const outer_element&, const inner_element&)>::type>::type
+                element_type;
+            typedef element_type
+                reference_type;
+
+            cursor(std::shared_ptr<const state_type> state, const outer_cursor& outer)
+            : state(std::move(state)), outer(outer), innerMatches(nullptr), match(0)
+            {
+                find_matches();
+            }
+
+            bool empty() const {
+                return outer.empty();
+            }
+            void inc() {
+                if (++match < innerMatches->size()) {
+                    return;
+                }
+                match = 0;
+                outer.inc();
+                find_matches();
+            }
+            reference_type get() const {
+                return state->result(outer.get(), (*innerMatches)[match]);
+            }
+
+        private:
+            // moves the outer cursor to the next element with matches
+            void find_matches() {
+                for (; !outer.empty(); outer.inc()) {
+                    auto it = state->innerTable.find(state->outerKey(outer.get()));
+                    if (it != state->innerTable.end()) {
+                        innerMatches = &it->second;
+                        break;
+                    }
+                }
+            }
+
+            std::shared_ptr<const state_type> state;
+            outer_cursor outer;
+            const std::vector<inner_element>* innerMatches;
+            std::size_t match;
+        };
+
+        linq_join(const Collection& c, const Inner& inner, OuterKey outerKey, InnerKey innerKey, Result result)
+        : c(c), inner(inner), outerKey(std::move(outerKey)), innerKey(std::move(innerKey)), result(std::move(result))
+        {
+        }
+
+        cursor get_cursor() const {
+            auto state = std::make_shared<state_type>(outerKey, innerKey, result);
+            auto innerCur = inner.get_cursor();
+            reserve(state->innerTable, innerCur, typename inner_cursor::cursor_category());
+            for (auto cur = innerCur; !cur.empty(); cur.inc()) {
+                inner_element e = cur.get();
+                key_type key(state->innerKey(e));
+                state->innerTable[std::move(key)].push_back(std::move(e));
+            }
+            return cursor(std::move(state), c.get_cursor());
+        }
+
+    private:
+        template <class Table>
+        static void reserve(Table& table, const inner_cursor& innerCur, random_access_cursor_tag) {
+            table.reserve(innerCur.size());
+        }
+        template <class Table>
+        static void reserve(Table&, const inner_cursor&, onepass_cursor_tag) {
+        }
+
+        Collection c;
+        Inner      inner;
+        OuterKey   outerKey;
+        InnerKey   innerKey;
+        Result     result;
+    };
+}
+
+#endif // !defined(CPPLINQ_LINQ_JOIN_HPP)
@@ -0,0 +1,289 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#if !defined(CPPLINQ_LINQ_ORDERBY_HPP)
+#define CPPLINQ_LINQ_ORDERBY_HPP
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+namespace cpplinq
+{
+    namespace detail
+    {
+        // the keys of an order_by/then_by chain. each step adds one key
+        //   to the keys computed by the previous steps, so the selectors are
+        //   called once per element and the sort compares stored keys.
+        template <class Element>
+        struct orderby_keys_root
+        {
+            struct keys_type {};
+
+            keys_type keys(const Element&) const { return keys_type(); }
+            int compare(const keys_type&, const keys_type&) const { return 0; }
+        };
+
+        template <class Element, class Previous, class Selector, class Less>
+        struct orderby_keys_step
+        {
+            typedef typename std::decay<
+                    typename util::result_of<Selector(const Element&)>::type>::type
+                key_type;
+            typedef std::pair<typename Previous::keys_type, key_type>
+                keys_type;
+
+            orderby_keys_step(Previous previous, Selector sel, Less less, bool descending)
+            : previous(std::move(previous)), sel(std::move(sel)), less(std::move(less)), descending(descending)
+            {
+            }
+
+            keys_type keys(const Element& e) const {
+                return keys_type(previous.keys(e), sel(e));
+            }
+            // <0, 0 or >0 as a sorts before, with or after b
+            int compare(const keys_type& a, const keys_type& b) const {
+                int c = previous.compare(a.first, b.first);
+                if (c != 0) {
+                    return c;
+                }
+                if (less(a.second, b.second)) {
+                    return descending ? 1 : -1;
+                }
+                if (less(b.second, a.second)) {
+                    return descending ? -1 : 1;
+                }
+                return 0;
+            }
+
+            Previous previous;
+            Selector sel;
+            Less     less;
+            bool     descending;
+        };
+    }
+
+    template <class Collection, class Keys>
+    class linq_orderby_take;
+
+    // sorts the input when the first cursor is requested. the sort is
+    //   stable: elements with equal keys keep their input order.
+    //
+    // when a limit was set by take(n), only the first n elements are kept.
+    //   they are selected with a bounded heap, so the rest of the input is
+    //   never sorted or stored.
+    template <class Collection, class Keys>
+    class linq_orderby
+    {
+        friend class linq_orderby_take<Collection, Keys>;
+
+        typedef typename Collection::cursor
+            inner_cursor;
+        typedef typename inner_cursor::element_type
+            element_type;
+        typedef typename Keys::keys_type
+            keys_type;
+
+        struct entry
+        {
+            keys_type    keys;
+            std::size_t  index;
+            element_type element;
+
+            entry(keys_type keys, std::size_t index, element_type element)
+            : keys(std::move(keys)), index(index), element(std::move(element))
+            {
+            }
+        };
+
+        struct entry_less
+        {
+            const Keys* keys;
+            bool operator()(const entry& a, const entry& b) const {
+                int c = keys->compare(a.keys, b.keys);
+                return c < 0 || (c == 0 && a.index < b.index);
+            }
+        };
+
+        typedef std::vector<element_type>
+            element_list_type;
+
+    public:
+        struct cursor {
+            typedef typename linq_orderby::element_type
+                element_type;
+            typedef element_type
+                reference_type;
+            typedef random_access_cursor_tag
+                cursor_category;
+
+            cursor(std::shared_ptr<element_list_type> elements)
+            : elements(std::move(elements)), start(0), current(0), fin(this->elements->size())
+            {
+            }
+
+            void forget() { start = current; }
+            bool empty() const { return current == fin; }
+            void inc() {
+                if (current == fin) {
+                    throw std::logic_error("attempt to iterate past end of range");
+                }
+                ++current;
+            }
+            reference_type get() const {
+                return (*elements)[current];
+            }
+
+            bool atbegin() const { return current == start; }
+            void dec() {
+                if (current == start) {
+                    throw std::logic_error("attempt to iterate past begin of range");
+                }
+                --current;
+            }
+
+            void skip(std::ptrdiff_t n) { current += n; }
+            std::size_t size() const { return fin - start; }
+            std::size_t position() const { return current - start; }
+            void truncate(std::size_t n) {
+                if (n < fin - current) {
+                    fin = current + n;
+                }
+            }
+
+        private:
+            std::shared_ptr<element_list_type> elements;
+            std::size_t start, current, fin;
+        };
+
+        linq_orderby(Collection c, Keys keys)
+        : c(c), keys(std::move(keys)), limit((std::numeric_limits<std::size_t>::max)())
+        {
+        }
+
+        cursor get_cursor() const {
+            return cursor(std::make_shared<element_list_type>(sorted()));
+        }
+
+        // -------------------- chaining --------------------
+
+        template <class Selector, class Less>
+        linq_orderby<Collection, detail::orderby_keys_step<element_type, Keys, Selector, Less>>
+            then_by(Selector sel, Less less, bool descending) const
+        {
+            return linq_orderby<Collection, detail::orderby_keys_step<element_type, Keys, Selector, Less>>(
+                c, detail::orderby_keys_step<element_type, Keys, Selector, Less>(keys, std::move(sel), std::move(less), descending));
+        }
+
+        // take(n) on an ordered query keeps only the first n elements
+        linq_orderby_take<Collection, Keys> take(std::size_t n) const
+        {
+            return linq_orderby_take<Collection, Keys>(linq_orderby(c, keys, n));
+        }
+
+    private:
+        linq_orderby(Collection c, Keys keys, std::size_t limit)
+        : c(c), keys(std::move(keys)), limit(limit)
+        {
+        }
+
+        element_list_type sorted() const
+        {
+            entry_less less = {&keys};
+            std::vector<entry> entries;
+
+            auto cur = c.get_cursor();
+            std::size_t index = 0;
+            if (limit == (std::numeric_limits<std::size_t>::max)()) {
+                for (; !cur.empty(); cur.inc(), ++index) {
+                    element_type element = cur.get();
+                    keys_type k = keys.keys(element);
+                    entries.push_back(entry(std::move(k), index, std::move(element)));
+                }
+                // the index breaks ties, so std::sort is stable here
+                std::sort(entries.begin(), entries.end(), less);
+            } else if (limit > 0) {
+                // a max-heap of the first limit entries seen so far
+                for (; !cur.empty(); cur.inc(), ++index) {
+                    element_type element = cur.get();
+                    keys_type k = keys.keys(element);
+                    entry next(std::move(k), index, std::move(element));
+                    if (entries.size() < limit) {
+                        entries.push_back(std::move(next));
+                        std::push_heap(entries.begin(), entries.end(), less);
+                    } else if (less(next, entries.front())) {
+                        std::pop_heap(entries.begin(), entries.end(), less);
+                        entries.back() = std::move(next);
+                        std::push_heap(entries.begin(), entries.end(), less);
+                    }
+                }
+                std::sort_heap(entries.begin(), entries.end(), less);
+            }
+
+            element_list_type result;
+            result.reserve(entries.size());
+            for (auto& e : entries) {
+                result.push_back(std::move(e.element));
+            }
+            return result;
+        }
+
+        Collection  c;
+        Keys        keys;
+        std::size_t limit;
+    };
+
+    // the first n elements of an ordered query. this is not an ordered
+    //   query itself, so then_by after take does not compile.
+    template <class Collection, class Keys>
+    class linq_orderby_take
+    {
+        typedef linq_orderby<Collection, Keys>
+            ordered_type;
+
+    public:
+        typedef typename ordered_type::cursor
+            cursor;
+
+        explicit linq_orderby_take(ordered_type ordered)
+        : ordered(std::move(ordered))
+        {
+        }
+
+        cursor get_cursor() const {
+            return ordered.get_cursor();
+        }
+
+        linq_orderby_take take(std::size_t n) const
+        {
+            return linq_orderby_take(ordered_type(ordered.c, ordered.keys, (std::min)(n, ordered.limit)));
+        }
+
+    private:
+        ordered_type ordered;
+    };
+
+    namespace detail
+    {
+        // take(n) is a linq_take, except on ordered queries, which only
+        //   select the first n elements instead of sorting all of them.
+        template <class Collection>
+        linq_take<Collection> take_(const Collection& c, std::size_t n)
+        {
+            return linq_take<Collection>(c, n);
+        }
+
+        template <class Collection, class Keys>
+        linq_orderby_take<Collection, Keys> take_(const linq_orderby<Collection, Keys>& c, std::size_t n)
+        {
+            return c.take(n);
+        }
+
+        template <class Collection, class Keys>
+        linq_orderby_take<Collection, Keys> take_(const linq_orderby_take<Collection, Keys>& c, std::size_t n)
+        {
+            return c.take(n);
+        }
+    }
+}
+
+#endif // !defined(CPPLINQ_LINQ_ORDERBY_HPP)
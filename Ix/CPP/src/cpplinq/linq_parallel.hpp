@@ -0,0 +1,335 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#if !defined(CPPLINQ_LINQ_PARALLEL_HPP)
+#define CPPLINQ_LINQ_PARALLEL_HPP
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace cpplinq
+{
+    template <class Collection>
+    class linq_driver;
+
+    namespace detail
+    {
+        // the cursors of one partition: a random access cursor limited to
+        //   the elements of the partition
+        template <class Cursor>
+        struct parallel_partition
+        {
+            typedef linq_take_cursor<Cursor> cursor;
+
+            parallel_partition(Cursor cur, std::size_t n) : cur(cur), n(n) {}
+
+            cursor get_cursor() const { return cursor(cur, n); }
+
+        private:
+            Cursor      cur;
+            std::size_t n;
+        };
+
+        // joins each joinable thread when it goes out of scope
+        struct parallel_joiner
+        {
+            explicit parallel_joiner(std::vector<std::thread>& threads) : threads(threads) {}
+            ~parallel_joiner()
+            {
+                for (auto& t : threads) {
+                    if (t.joinable()) {
+                        t.join();
+                    }
+                }
+            }
+
+        private:
+            parallel_joiner(const parallel_joiner&);
+            parallel_joiner& operator=(const parallel_joiner&);
+
+            std::vector<std::thread>& threads;
+        };
+
+        // the steps of the query that run on each partition
+        struct parallel_source_step
+        {
+            template <class Partition>
+            linq_driver<Partition> operator()(const Partition& p) const
+            {
+                return linq_driver<Partition>(p);
+            }
+        };
+
+        template <class Previous, class Selector>
+        struct parallel_select_step
+        {
+            Previous previous;
+            Selector sel;
+
+            parallel_select_step(Previous previous, Selector sel) : previous(std::move(previous)), sel(std::move(sel)) {}
+
+            template <class Partition>
+            auto operator()(const Partition& p) const
+            -> decltype(previous(p).select(sel))
+            {
+                return previous(p).select(sel);
+            }
+        };
+
+        template <class Previous, class Predicate>
+        struct parallel_where_step
+        {
+            Previous  previous;
+            Predicate pred;
+
+            parallel_where_step(Previous previous, Predicate pred) : previous(std::move(previous)), pred(std::move(pred)) {}
+
+            template <class Partition>
+            auto operator()(const Partition& p) const
+            -> decltype(previous(p).where(pred))
+            {
+                return previous(p).where(pred);
+            }
+        };
+    }
+
+    // runs a query over a random access collection in parallel. the
+    //   collection is split into contiguous partitions, the select and where
+    //   steps of the query run on each partition on its own thread, and the
+    //   results of the partitions are merged in the order of the partitions.
+    //
+    // requires:
+    //   the selectors and predicates must be safe to call concurrently.
+    template <class Collection, class Pipeline = detail::parallel_source_step>
+    class linq_parallel
+    {
+        typedef typename Collection::cursor
+            inner_cursor;
+
+        typedef detail::parallel_partition<inner_cursor>
+            partition_type;
+
+        typedef decltype(std::declval<const Pipeline&>()(std::declval<const partition_type&>()))
+            query_type;
+
+    public:
+        typedef typename query_type::cursor::element_type
+            element_type;
+
+        linq_parallel(Collection c, std::size_t partitions, Pipeline pipeline = Pipeline())
+        : c(c), partitions(partitions ? partitions : 1), pipeline(std::move(pipeline))
+        {
+        }
+
+        // -------------------- steps run on each partition --------------------
+
+        template <class Selector>
+        linq_parallel<Collection, detail::parallel_select_step<Pipeline, Selector>> select(Selector sel) const
+        {
+            return linq_parallel<Collection, detail::parallel_select_step<Pipeline, Selector>>(
+                c, partitions, detail::parallel_select_step<Pipeline, Selector>(pipeline, std::move(sel)));
+        }
+
+        template <class Predicate>
+        linq_parallel<Collection, detail::parallel_where_step<Pipeline, Predicate>> where(Predicate p) const
+        {
+            return linq_parallel<Collection, detail::parallel_where_step<Pipeline, Predicate>>(
+                c, partitions, detail::parallel_where_step<Pipeline, Predicate>(pipeline, std::move(p)));
+        }
+
+        // -------------------- merged reductions --------------------
+
+        // fn must be associative. returns element_type() for an empty sequence.
+        template <class Fn>
+        element_type aggregate(Fn fn) const
+        {
+            auto partials = run<util::maybe<element_type>>([&](const query_type& q) {
+                return q.empty() ? util::maybe<element_type>() : util::maybe<element_type>(q.aggregate(fn));
+            });
+            return merge(partials, fn, element_type());
+        }
+
+        // seed is used for each partition, so it must be an identity of fn.
+        //   combine merges the results of two partitions.
+        template <class T, class Fn, class Combine>
+        T aggregate(T seed, Fn fn, Combine combine) const
+        {
+            auto partials = run<T>([&](const query_type& q) {
+                return q.aggregate(seed, fn);
+            });
+            return std::accumulate(partials.begin() + 1, partials.end(), partials.front(), combine);
+        }
+
+        std::ptrdiff_t count() const
+        {
+            auto partials = run<std::ptrdiff_t>([](const query_type& q) {
+                return static_cast<std::ptrdiff_t>(q.count());
+            });
+            return std::accumulate(partials.begin(), partials.end(), std::ptrdiff_t(0));
+        }
+
+        template <class Predicate>
+        std::ptrdiff_t count(Predicate p) const
+        {
+            return where(std::move(p)).count();
+        }
+
+        element_type sum() const
+        {
+            return sum(element_type());
+        }
+
+        element_type sum(element_type seed) const
+        {
+            auto partials = run<element_type>([](const query_type& q) {
+                return q.sum();
+            });
+            return std::accumulate(partials.begin(), partials.end(), seed);
+        }
+
+        element_type max() const
+        {
+            return max(std::less<element_type>());
+        }
+
+        template <class Compare>
+        element_type max(Compare less) const
+        {
+            auto partials = run<util::maybe<element_type>>([&](const query_type& q) {
+                return q.empty() ? util::maybe<element_type>() : util::maybe<element_type>(q.max(less));
+            });
+            auto best = merge(partials, [&](const element_type& a, const element_type& b) {
+                return less(a, b) ? b : a;
+            });
+            if (!best)
+                throw std::logic_error("max performed on empty range");
+
+            return *best;
+        }
+
+        element_type min() const
+        {
+            return min(std::less<element_type>());
+        }
+
+        template <class Compare>
+        element_type min(Compare less) const
+        {
+            auto partials = run<util::maybe<element_type>>([&](const query_type& q) {
+                return q.empty() ? util::maybe<element_type>() : util::maybe<element_type>(q.min(less));
+            });
+            auto best = merge(partials, [&](const element_type& a, const element_type& b) {
+                return less(b, a) ? b : a;
+            });
+            if (!best)
+                throw std::logic_error("min performed on empty range");
+
+            return *best;
+        }
+
+        std::vector<element_type> to_vector() const
+        {
+            auto partials = run<std::vector<element_type>>([](const query_type& q) {
+                return q.to_vector();
+            });
+            std::size_t size = 0;
+            for (auto& part : partials) {
+                size += part.size();
+            }
+            std::vector<element_type> result;
+            result.reserve(size);
+            for (auto& part : partials) {
+                std::move(part.begin(), part.end(), std::back_inserter(result));
+            }
+            return result;
+        }
+
+    private:
+        // calls fn with the query of each partition, each on its own thread,
+        //   and returns the results in partition order. the first exception
+        //   thrown by a partition is rethrown once all the partitions finish.
+        //   partitions that cannot get a thread run on the calling thread.
+        template <class Result, class Fn>
+        std::vector<Result> run(Fn fn) const
+        {
+            auto whole = c.get_cursor();
+            std::size_t size = whole.size();
+            std::size_t count = std::min(partitions, size ? size : std::size_t(1));
+
+            std::vector<Result> results(count);
+            std::vector<std::exception_ptr> errors(count);
+
+            auto work = [&](std::size_t p) {
+                try {
+                    // spread the remainder over the first partitions
+                    std::size_t first = p * (size / count) + std::min(p, size % count);
+                    std::size_t length = size / count + (p < size % count ? 1 : 0);
+                    auto cur = whole;
+                    cur.skip(first);
+                    results[p] = fn(pipeline(partition_type(cur, length)));
+                } catch (...) {
+                    errors[p] = std::current_exception();
+                }
+            };
+
+            {
+                std::vector<std::thread> threads;
+                // joins the threads that started, even when the rest unwinds
+                detail::parallel_joiner joiner(threads);
+                threads.reserve(count - 1);
+                std::size_t started = 1;
+                try {
+                    for (; started < count; ++started) {
+                        threads.emplace_back(work, started);
+                    }
+                } catch (const std::system_error&) {
+                    // no more threads, the remaining partitions run inline
+                }
+                for (std::size_t p = started; p < count; ++p) {
+                    work(p);
+                }
+                work(0);
+            }
+
+            for (auto& e : errors) {
+                if (e) {
+                    std::rethrow_exception(e);
+                }
+            }
+            return results;
+        }
+
+        template <class Fn>
+        static util::maybe<element_type> merge(const std::vector<util::maybe<element_type>>& partials, Fn fn)
+        {
+            util::maybe<element_type> result;
+            for (auto& part : partials) {
+                if (!part) {
+                    continue;
+                }
+                if (!result) {
+                    result.set(*part);
+                } else {
+                    result.set(fn(*result, *part));
+                }
+            }
+            return result;
+        }
+
+        template <class Fn>
+        static element_type merge(const std::vector<util::maybe<element_type>>& partials, Fn fn, element_type empty)
+        {
+            auto result = merge(partials, fn);
+            return result ? *result : empty;
+        }
+
+        Collection  c;
+        std::size_t partitions;
+        Pipeline    pipeline;
+    };
+}
+
+#endif // !defined(CPPLINQ_LINQ_PARALLEL_HPP)
@@ -111,6 +111,22 @@ namespace cpplinq { namespace util {
     using std::result_of;
 #endif
 
+    // true when std::hash<T> can hash a T. keys that are not hashable fall
+    // back to ordered indexes.
+    template <class T>
+    struct is_hashable
+    {
+    private:
+        typedef char yes;
+        typedef struct { char c1,c2; } no;
+        template <class U>
+        static yes invoke(decltype(std::hash<U>()(*static_cast<const U*>(0)))*);
+        template <class U>
+        static no invoke(...);
+    public:
+        enum { value = (sizeof(invoke<T>(0)) == sizeof(yes)) };
+    };
+
     template<class Type>
     struct identity 
     {
@@ -9,8 +9,12 @@
 #include <iterator>
 #include <string>
 #include <complex>
+#include <list>
+#include <map>
+#include <cmath>
 
 #include <ctime>
+#include <chrono>
 #include <cstddef>
 
 #include <boost/lambda/core.hpp>
@@ -261,6 +265,56 @@ TEST(test_groupby)
     }
 }
 
+TEST(test_groupby_order)
+{
+    vector<int> xs = {13, 4, 23, 7, 3, 14, 17, 33, 24};
+
+    auto grouped = 
+        from(xs)
+        .groupby([](int i){return i % 10; });
+
+    // groups in order of their first element
+    vector<int> keys = {3, 4, 7};
+    // elements of each group in input order
+    vector<int> elements = {13, 23, 3, 33, 4, 14, 24, 7, 17};
+
+    VERIFY_EQ(3, from(grouped).count());
+    std::size_t key = 0;
+    std::size_t elem = 0;
+    for(auto it = begin(grouped); it != end(grouped); ++it) {
+        auto group = *it;
+        VERIFY_EQ(keys[key++], group.key);
+        for (auto x = group.begin(); x != group.end(); ++x) {
+            VERIFY_EQ(elements[elem++], *x);
+        }
+    }
+    VERIFY_EQ(elements.size(), elem);
+}
+
+TEST(test_groupby_ordered_index)
+{
+    // pairs are not hashable, so the ordered index is used
+    vector<int> xs = {13, 4, 23, 7, 3, 14};
+
+    auto grouped = 
+        from(xs)
+        .groupby([](int i){return std::make_pair(i % 10, i % 2); });
+
+    VERIFY_EQ(3, from(grouped).count());
+    VERIFY_EQ(3, from(grouped).first().key.first);
+    VERIFY_EQ(7, from(grouped).last().key.first);
+
+    // an explicit comparer selects the ordered index for hashable keys
+    auto compared = 
+        from(xs)
+        .groupby([](int i){return i % 10; }, std::greater<int>());
+
+    VERIFY_EQ(3, from(compared).count());
+    auto first = from(compared).first();
+    VERIFY_EQ(3, first.key);
+    VERIFY_EQ(3, from(first).count());
+}
+
 TEST(test_symbolname)
 {
     auto complexQuery = 
@@ -419,17 +473,19 @@ TEST(test_late_bind)
     cout << "typeof q1.late_bind() ==> " << typeid(q1.late_bind()).name() << endl;
 }
 
+// measures wall time. clock() adds up the processor time of all the
+// threads, which hides the speedup of parallel queries.
 struct stopwatch
 {
-    time_t t0, t1;
+    std::chrono::steady_clock::time_point t0, t1;
     void start() {
-        t1 = t0 = clock();
+        t1 = t0 = std::chrono::steady_clock::now();
     }
     void stop() {
-        t1 = clock();
+        t1 = std::chrono::steady_clock::now();
     }
     double value() const {
-        return double(t1-t0)/CLOCKS_PER_SEC;
+        return std::chrono::duration<double>(t1-t0).count();
     }
 };
 
@@ -514,6 +570,427 @@ TEST(test_performance)
 #endif
 }
 
+struct group_key
+{
+    template <class Group>
+    auto operator()(const Group& g) const -> decltype(g.key) { return g.key; }
+};
+
+// the grouping that groupby used before the hash index. each element is
+// spliced into a std::list after the last element of its group and the
+// groups are found through a std::map. returns the keys in group order.
+template <class Key, class KeyFn>
+vector<Key> list_groupby_keys(const vector<int>& xs, KeyFn keyFn)
+{
+    typedef std::list<int>::iterator iterator;
+    struct list_group
+    {
+        Key key;
+        iterator start;
+        iterator fin;
+    };
+
+    std::list<int> elements;
+    std::list<list_group> groups;
+    std::map<Key, list_group*> groupIndex;
+    for (auto x : xs) {
+        Key key = keyFn(x);
+        auto groupPos = groupIndex.find(key);
+        if (groupPos == groupIndex.end()) {
+            elements.push_back(x);
+            if (!groups.empty()) {
+                --groups.back().fin;
+            }
+            list_group newGroup;
+            newGroup.key = key;
+            newGroup.fin = elements.end();
+            --(newGroup.start = newGroup.fin);
+            groups.push_back(newGroup);
+            groupIndex.insert(std::make_pair(key, &groups.back()));
+        } else {
+            elements.insert(groupPos->second->fin, x);
+        }
+    }
+
+    vector<Key> keys;
+    for (auto& g : groups) {
+        keys.push_back(g.key);
+    }
+    return keys;
+}
+
+TEST(test_groupby_performance)
+{
+    // group a pseudo-random sequence by many keys with the hash index, with
+    // the ordered index and with the std::list of the earlier groupby
+    vector<int> xs(100000);
+    unsigned int seed = 1;
+    for (auto& x : xs) {
+        seed = seed * 1103515245 + 12345;
+        x = int((seed >> 8) % 1000000);
+    }
+    auto key = [](int x){ return x % 10007; };
+
+    std::size_t hashedGroups = 0, orderedGroups = 0;
+    auto hashed = [&](int n){
+        for (int i = 0; i < n; ++i) {
+            auto grouped = from(xs).groupby(key);
+            hashedGroups = from(grouped).count();
+        }
+    };
+    auto ordered = [&](int n){
+        for (int i = 0; i < n; ++i) {
+            auto grouped = from(xs).groupby(key, std::less<int>());
+            orderedGroups = from(grouped).count();
+        }
+    };
+    std::size_t listGroups = 0;
+    auto listed = [&](int n){
+        for (int i = 0; i < n; ++i) {
+            listGroups = list_groupby_keys<int>(xs, key).size();
+        }
+    };
+
+    hashed(1);
+    ordered(1);
+    listed(1);
+    VERIFY_EQ(orderedGroups, hashedGroups);
+    VERIFY_EQ(listGroups, hashedGroups);
+
+    auto hashedKeys = from(xs).groupby(key).select(group_key()).to_vector();
+    auto orderedKeys = from(xs).groupby(key, std::less<int>()).select(group_key()).to_vector();
+    VERIFY(hashedKeys == orderedKeys);
+    VERIFY(hashedKeys == list_groupby_keys<int>(xs, key));
+
+#ifdef PERF
+    cout << "groupby with the hash index:" << endl;
+    test_perf(hashed);
+    cout << endl;
+    cout << "groupby with the ordered index:" << endl;
+    test_perf(ordered);
+    cout << endl;
+    cout << "grouping with the std::list of the earlier groupby:" << endl;
+    test_perf(listed);
+    cout << endl;
+#endif
+}
+
+bool is_negative(int x)
+{
+    return x < 0;
+}
+
+TEST(test_parallel)
+{
+    vector<int> xs = vector_range(0, 1001);
+    auto odd = [](int x){ return x % 2 == 1; };
+    auto square = [](int x){ return (long long)x * x; };
+
+    for (std::size_t n = 1; n <= 8; ++n) {
+        auto par = from(xs).parallel(n);
+
+        VERIFY_EQ(1001, par.count());
+        VERIFY_EQ(500, par.count(odd));
+        VERIFY_EQ(500500, par.sum());
+        VERIFY_EQ(0, par.min());
+        VERIFY_EQ(1000, par.max());
+        VERIFY_EQ(
+            from(xs).where(odd).select(square).sum(),
+            par.where(odd).select(square).sum());
+        VERIFY_EQ(
+            from(xs).select(square).where(odd).aggregate(std::plus<long long>()),
+            par.select(square).where(odd).aggregate(std::plus<long long>()));
+        VERIFY_EQ(
+            from(xs).aggregate(0, std::plus<int>()),
+            par.aggregate(0, std::plus<int>(), std::plus<int>()));
+        VERIFY(from(xs).where(odd).to_vector() == par.where(odd).to_vector());
+    }
+
+    // partitions that are all empty
+    auto none = from(xs).parallel(4).where(is_negative);
+    VERIFY_EQ(0, none.count());
+    VERIFY_EQ(0, none.sum());
+    VERIFY(none.to_vector().empty());
+
+    bool thrown = false;
+    try {
+        none.max();
+    } catch (std::logic_error&) {
+        thrown = true;
+    }
+    VERIFY(thrown);
+
+    // an exception from a partition is rethrown on the calling thread
+    thrown = false;
+    try {
+        from(xs).parallel(4).where([](int x) -> bool {
+            if (x == 900) throw std::logic_error("where failed");
+            return true;
+        }).count();
+    } catch (std::logic_error&) {
+        thrown = true;
+    }
+    VERIFY(thrown);
+}
+
+TEST(test_parallel_performance)
+{
+    vector<int> xs = vector_range(0, 10000000);
+    auto query = [](int x) { return x % 3 == 0; };
+    auto work = [](int x) { return std::sqrt(double(x)); };
+
+    double sequentialSum = 0, parallelSum = 0;
+    auto sequential = [&](int n){
+        for (int i = 0; i < n; ++i) {
+            sequentialSum = from(xs).where(query).select(work).sum();
+        }
+    };
+    auto parallel = [&](int n){
+        for (int i = 0; i < n; ++i) {
+            parallelSum = from(xs).parallel().where(query).select(work).sum();
+        }
+    };
+
+    sequential(1);
+    parallel(1);
+    VERIFY(std::abs(sequentialSum - parallelSum) < 1e-6 * sequentialSum);
+
+#ifdef PERF
+    cout << "sequential where/select/sum:" << endl;
+    test_perf(sequential);
+    cout << endl;
+    cout << "parallel where/select/sum:" << endl;
+    test_perf(parallel);
+    cout << endl;
+#endif
+}
+
+struct person
+{
+    std::string name;
+    int age;
+    int id;
+};
+
+TEST(test_order_by)
+{
+    vector<person> people = {
+        {"carol", 35, 0}, {"alice", 30, 1}, {"bob", 35, 2},
+        {"dave", 30, 3}, {"alice", 25, 4}, {"erin", 35, 5}};
+    auto id = [](const person& p){ return p.id; };
+
+    // stable: equal keys keep their input order
+    auto byAge = from(people).order_by([](const person& p){ return p.age; }).select(id).to_vector();
+    VERIFY((byAge == vector<int>{4, 1, 3, 0, 2, 5}));
+
+    auto byAgeDescending = from(people).order_by_descending([](const person& p){ return p.age; }).select(id).to_vector();
+    VERIFY((byAgeDescending == vector<int>{0, 2, 5, 1, 3, 4}));
+
+    auto byAgeThenName = 
+        from(people)
+        .order_by_descending([](const person& p){ return p.age; })
+        .then_by([](const person& p){ return p.name; })
+        .select(id)
+        .to_vector();
+    VERIFY((byAgeThenName == vector<int>{2, 0, 5, 1, 3, 4}));
+
+    auto byNameThenAge = 
+        from(people)
+        .order_by([](const person& p){ return p.name; }, std::less<std::string>())
+        .then_by_descending([](const person& p){ return p.age; })
+        .select(id)
+        .to_vector();
+    VERIFY((byNameThenAge == vector<int>{1, 4, 2, 0, 3, 5}));
+
+    // the key selector is called once per element
+    int calls = 0;
+    auto counted = from(people).order_by([&](const person& p){ ++calls; return p.age; }).to_vector();
+    VERIFY_EQ(people.size(), counted.size());
+    VERIFY_EQ(int(people.size()), calls);
+}
+
+TEST(test_order_by_take)
+{
+    vector<int> xs;
+    unsigned int seed = 7;
+    for (int i = 0; i < 1000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        xs.push_back(int((seed >> 8) % 100));
+    }
+    auto key = [](int x){ return x / 10; };
+
+    auto sorted = from(xs).order_by(key).to_vector();
+    for (std::size_t k = 0; k < 20; ++k) {
+        auto top = from(xs).order_by(key).take(k).to_vector();
+        VERIFY_EQ(k, top.size());
+        // the same elements, in the same order, as the prefix of the full sort
+        VERIFY(std::equal(top.begin(), top.end(), sorted.begin()));
+    }
+
+    auto all = from(xs).order_by(key).take(5000).to_vector();
+    VERIFY(all == sorted);
+
+    auto highest = from(xs).order_by_descending(key).take(3).take(10).to_vector();
+    VERIFY_EQ(3, highest.size());
+    VERIFY_EQ(9, highest[0] / 10);
+}
+
+TEST(test_order_by_performance)
+{
+    vector<int> xs(10000000);
+    unsigned int seed = 1;
+    for (auto& x : xs) {
+        seed = seed * 1103515245 + 12345;
+        x = int(seed >> 1);
+    }
+    auto key = [](int x){ return x; };
+
+    vector<int> sortedTop, top;
+    auto full = [&](int n){
+        for (int i = 0; i < n; ++i) {
+            auto sorted = from(xs).order_by(key).to_vector();
+            sortedTop.assign(sorted.begin(), sorted.begin() + 10);
+        }
+    };
+    auto topk = [&](int n){
+        for (int i = 0; i < n; ++i) {
+            top = from(xs).order_by(key).take(10).to_vector();
+        }
+    };
+
+    full(1);
+    topk(1);
+    VERIFY(sortedTop == top);
+
+#ifdef PERF
+    cout << "order_by then to_vector:" << endl;
+    test_perf(full);
+    cout << endl;
+    cout << "order_by then take(10):" << endl;
+    test_perf(topk);
+    cout << endl;
+#endif
+}
+
+TEST(test_distinct)
+{
+    vector<int> xs = {3, 1, 3, 2, 1, 4, 2, 5};
+    vector<int> ys = {4, 6, 2, 6, 7};
+
+    auto distinct = from(xs).distinct().to_vector();
+    VERIFY((distinct == vector<int>{3, 1, 2, 4, 5}));
+    VERIFY_EQ(5, from(xs).distinct().count());
+
+    auto unioned = from(xs).union_with(from(ys)).to_vector();
+    VERIFY((unioned == vector<int>{3, 1, 2, 4, 5, 6, 7}));
+
+    auto intersected = from(xs).intersect(from(ys)).to_vector();
+    VERIFY((intersected == vector<int>{2, 4}));
+
+    auto excepted = from(xs).except(from(ys)).to_vector();
+    VERIFY((excepted == vector<int>{3, 1, 5}));
+
+    vector<int> none;
+    VERIFY(from(none).distinct().empty());
+    VERIFY((from(none).union_with(from(ys)).to_vector() == vector<int>{4, 6, 2, 7}));
+    VERIFY(from(xs).intersect(from(none)).empty());
+    VERIFY_EQ(5, from(xs).except(from(none)).count());
+
+    // nothing is read until the query is enumerated
+    int reads = 0;
+    auto counted = from(xs).select([&](int x){ ++reads; return x % 3; }).distinct();
+    VERIFY_EQ(0, reads);
+    VERIFY((counted.to_vector() == vector<int>{0, 1, 2}));
+    VERIFY(reads > 0);
+
+    // hash and equality on the key
+    auto byParity = from(xs).distinct(
+        [](int x){ return std::hash<int>()(x % 2); },
+        [](int a, int b){ return a % 2 == b % 2; }).to_vector();
+    VERIFY((byParity == vector<int>{3, 2}));
+
+    static_assert(std::is_same<decltype(from(xs).distinct().get_cursor())::cursor_category, onepass_cursor_tag>::value,
+        "distinct cursors share their set, so they are onepass");
+}
+
+TEST(test_join)
+{
+    vector<person> people = {
+        {"carol", 35, 0}, {"alice", 30, 1}, {"bob", 35, 2}};
+    vector<std::pair<int, std::string>> pets = {
+        {2, "rex"}, {0, "tom"}, {9, "stray"}, {2, "fido"}, {1, "kit"}};
+    vector<std::pair<int, std::string>> manyPets;
+    for (int i = 0; i < 10; ++i) {
+        manyPets.insert(manyPets.end(), pets.begin(), pets.end());
+    }
+
+    auto personId = [](const person& p){ return p.id; };
+    auto owner = [](const std::pair<int, std::string>& pet){ return pet.first; };
+    auto describe = [](const person& p, const std::pair<int, std::string>& pet){ return p.name + ":" + pet.second; };
+
+    // results follow the people, and the pets of each person follow the pets
+    auto owned = from(people).join(from(pets), personId, owner, describe).to_vector();
+    VERIFY((owned == vector<std::string>{"carol:tom", "alice:kit", "bob:rex", "bob:fido"}));
+
+    // the order does not depend on which sequence is larger
+    vector<person> crowd;
+    for (int i = 0; i < 3; ++i) {
+        crowd.insert(crowd.end(), people.begin(), people.end());
+    }
+    vector<std::pair<int, std::string>> fewPets(pets.begin(), pets.begin() + 2);
+    auto crowdOwned = from(crowd).join(from(fewPets), personId, owner, describe).to_vector();
+    VERIFY((crowdOwned == vector<std::string>{"carol:tom", "bob:rex", "carol:tom", "bob:rex", "carol:tom", "bob:rex"}));
+
+    VERIFY_EQ(40, from(people).join(from(manyPets), personId, owner, describe).count());
+
+    // a forward sequence joins in the same order
+    std::list<person> listed(people.begin(), people.end());
+    auto listOwned = from(listed).join(from(pets), personId, owner, describe).to_vector();
+    VERIFY((listOwned == vector<std::string>{"carol:tom", "alice:kit", "bob:rex", "bob:fido"}));
+
+    vector<person> nobody;
+    VERIFY(from(nobody).join(from(pets), personId, owner, describe).empty());
+    VERIFY(from(people).join(from(nobody), personId, personId, [](const person& a, const person&){ return a.id; }).empty());
+
+    static_assert(std::is_same<decltype(from(people).join(from(pets), personId, owner, describe).get_cursor())::cursor_category, forward_cursor_tag>::value,
+        "join cursors are forward over forward inputs");
+}
+
+TEST(test_distinct_performance)
+{
+    vector<int> xs(1000000);
+    unsigned int seed = 3;
+    for (auto& x : xs) {
+        seed = seed * 1103515245 + 12345;
+        x = int((seed >> 8) % 100000);
+    }
+
+    std::size_t ordered = 0, hashed = 0;
+    auto viaSet = [&](int n){
+        for (int i = 0; i < n; ++i) {
+            ordered = from(xs).to_set().size();
+        }
+    };
+    auto viaDistinct = [&](int n){
+        for (int i = 0; i < n; ++i) {
+            hashed = from(xs).distinct().count();
+        }
+    };
+
+    viaSet(1);
+    viaDistinct(1);
+    VERIFY_EQ(ordered, hashed);
+
+#ifdef PERF
+    cout << "to_set then size:" << endl;
+    test_perf(viaSet);
+    cout << endl;
+    cout << "distinct then count:" << endl;
+    test_perf(viaDistinct);
+    cout << endl;
+#endif
+}
+
 // SUM TESTS
 
 TEST(test_sum_ints)
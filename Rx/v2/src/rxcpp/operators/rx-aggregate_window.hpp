@@ -0,0 +1,840 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-aggregate_window.hpp
+
+    \brief Return an observable that emits one aggregate of the items from this observable for each time window.
+
+    \tparam Aggregator    the type of the aggregator.
+    \tparam Coordination  the type of the scheduler (optional).
+
+    \param window        tumbling_window(size), hopping_window(size, hop) or session_window(gap).
+    \param aggregator    aggregate_sum(), aggregate_count(), aggregate_min(), aggregate_max() or aggregate_with(lift, combine, optional result).
+    \param coordination  the scheduler for the windows (optional).
+
+    \return  Observable that emits the aggregate of each window that received at least one item.
+
+    The windows are:
+    - tumbling_window(size) starts a new window every size, the windows do not overlap.
+    - hopping_window(size, hop) starts a new window of the given size every hop. the windows overlap when hop < size and leave gaps when hop > size.
+    - session_window(gap) keeps a window open until no item has arrived for gap.
+
+    Time windows start when the observable is subscribed and an empty window does not emit. on_completed emits the
+    windows that are open and have received items.
+
+    An aggregator has three functions:
+    - lift(item) returns an accumulator for one item.
+    - combine(older, newer) returns an accumulator for both. It must be associative.
+    - result(accumulator) returns the value that is emitted for a window.
+
+    Each item is combined once into the pane that it arrives in. Each hop is split into at most two panes at the
+    points where windows start and end, so every window is made of whole panes. Overlapping windows share the panes
+    and the aggregate of a window is kept up to date as panes enter and leave it, so the cost per item does not depend
+    on the number of windows that overlap.
+
+    size and hop must be greater than zero, otherwise std::invalid_argument is thrown. The same holds for the gap of
+    a session window.
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_AGGREGATE_WINDOW_HPP)
+#define RXCPP_OPERATORS_RX_AGGREGATE_WINDOW_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+/// windows of size that start every hop
+struct hopping_window
+{
+    typedef rxsc::scheduler::clock_type::duration duration_type;
+
+    hopping_window(duration_type s, duration_type h)
+        : size(s)
+        , hop(h)
+    {
+        if (size <= duration_type::zero() || hop <= duration_type::zero()) {
+            rxu::throw_exception(std::invalid_argument("hopping_window size and hop must be greater than zero"));
+        }
+    }
+    duration_type size;
+    duration_type hop;
+};
+
+/// windows of size that start when the previous window ends
+inline hopping_window tumbling_window(hopping_window::duration_type size) {
+    return hopping_window(size, size);
+}
+
+/// a window that ends when no item has arrived for gap
+struct session_window
+{
+    typedef rxsc::scheduler::clock_type::duration duration_type;
+
+    explicit session_window(duration_type g)
+        : gap(g)
+    {
+        if (gap <= duration_type::zero()) {
+            rxu::throw_exception(std::invalid_argument("session_window gap must be greater than zero"));
+        }
+    }
+    duration_type gap;
+};
+
+/// the sum of the items in each window
+struct aggregate_sum
+{
+    template<class T>
+    T lift(const T& v) const {
+        return v;
+    }
+    template<class A>
+    A combine(A older, const A& newer) const {
+        return older + newer;
+    }
+    template<class A>
+    A result(A a) const {
+        return a;
+    }
+};
+
+/// the number of items in each window
+struct aggregate_count
+{
+    template<class T>
+    int lift(const T&) const {
+        return 1;
+    }
+    int combine(int older, int newer) const {
+        return older + newer;
+    }
+    int result(int a) const {
+        return a;
+    }
+};
+
+/// the smallest item in each window, the first one when several are equal
+struct aggregate_min
+{
+    template<class T>
+    T lift(const T& v) const {
+        return v;
+    }
+    template<class A>
+    A combine(A older, A newer) const {
+        return newer < older ? std::move(newer) : std::move(older);
+    }
+    template<class A>
+    A result(A a) const {
+        return a;
+    }
+};
+
+/// the largest item in each window, the first one when several are equal
+struct aggregate_max
+{
+    template<class T>
+    T lift(const T& v) const {
+        return v;
+    }
+    template<class A>
+    A combine(A older, A newer) const {
+        return older < newer ? std::move(newer) : std::move(older);
+    }
+    template<class A>
+    A result(A a) const {
+        return a;
+    }
+};
+
+namespace detail {
+
+struct aggregate_identity
+{
+    template<class A>
+    A operator()(A a) const {
+        return a;
+    }
+};
+
+}
+
+/// an aggregator made from functions
+template<class Lift, class Combine, class Result>
+struct aggregate_functions
+{
+    typedef rxu::decay_t<Lift> lift_type;
+    typedef rxu::decay_t<Combine> combine_type;
+    typedef rxu::decay_t<Result> result_type;
+
+    aggregate_functions(lift_type l, combine_type c, result_type r)
+        : lifter(std::move(l))
+        , combiner(std::move(c))
+        , resulter(std::move(r))
+    {
+    }
+
+    template<class T>
+    auto lift(const T& v) const
+        -> rxu::decay_t<decltype(std::declval<const lift_type&>()(v))> {
+        return lifter(v);
+    }
+    template<class A>
+    A combine(A older, A newer) const {
+        return combiner(std::move(older), std::move(newer));
+    }
+    template<class A>
+    auto result(A a) const
+        -> rxu::decay_t<decltype(std::declval<const result_type&>()(std::move(a)))> {
+        return resulter(std::move(a));
+    }
+
+    lift_type lifter;
+    combine_type combiner;
+    result_type resulter;
+};
+
+/// an aggregator from a lift(item) function and an associative combine(older, newer) function
+template<class Lift, class Combine>
+auto aggregate_with(Lift&& l, Combine&& c)
+    ->      aggregate_functions<Lift, Combine, detail::aggregate_identity> {
+    return  aggregate_functions<Lift, Combine, detail::aggregate_identity>(std::forward<Lift>(l), std::forward<Combine>(c), detail::aggregate_identity());
+}
+
+/// an aggregator from lift(item), an associative combine(older, newer) and a result(accumulator) function
+template<class Lift, class Combine, class Result>
+auto aggregate_with(Lift&& l, Combine&& c, Result&& r)
+    ->      aggregate_functions<Lift, Combine, Result> {
+    return  aggregate_functions<Lift, Combine, Result>(std::forward<Lift>(l), std::forward<Combine>(c), std::forward<Result>(r));
+}
+
+namespace detail {
+
+template<class... AN>
+struct aggregate_window_invalid_arguments {};
+
+template<class... AN>
+struct aggregate_window_invalid : public rxo::operator_base<aggregate_window_invalid_arguments<AN...>> {
+    using type = observable<aggregate_window_invalid_arguments<AN...>, aggregate_window_invalid<AN...>>;
+};
+template<class... AN>
+using aggregate_window_invalid_t = typename aggregate_window_invalid<AN...>::type;
+
+template<class T, class Aggregator>
+struct aggregate_window_types
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Aggregator> aggregator_type;
+    typedef rxu::decay_t<decltype(std::declval<const aggregator_type&>().lift(std::declval<const source_value_type&>()))> accumulator_type;
+    typedef rxu::decay_t<decltype(std::declval<const aggregator_type&>().result(std::declval<accumulator_type>()))> value_type;
+    typedef rxu::maybe<accumulator_type> maybe_accumulator;
+
+    static maybe_accumulator combine(const aggregator_type& a, maybe_accumulator older, maybe_accumulator newer) {
+        if (older.empty()) {
+            return newer;
+        }
+        if (newer.empty()) {
+            return older;
+        }
+        return maybe_accumulator(a.combine(std::move(older.get()), std::move(newer.get())));
+    }
+};
+
+/// a fifo of pane accumulators that answers the combination of all the
+/// panes it holds. the newer panes are pushed onto one stack with a running
+/// total. when the oldest pane is popped and the other stack is empty, the
+/// panes are moved across and each entry stores the total of itself and all
+/// the panes that are newer than it. push and pop are amortized O(1) and call
+/// combine at most twice per pane. query calls combine once per call.
+template<class T, class Aggregator>
+struct aggregate_panes
+{
+    typedef aggregate_window_types<T, Aggregator> types;
+    typedef typename types::aggregator_type aggregator_type;
+    typedef typename types::maybe_accumulator maybe_accumulator;
+
+    explicit aggregate_panes(aggregator_type a)
+        : aggregator(std::move(a))
+    {
+    }
+
+    std::size_t size() const {
+        return older.size() + newer.size();
+    }
+
+    void push(maybe_accumulator pane) {
+        newer_total = types::combine(aggregator, std::move(newer_total), pane);
+        newer.push_back(std::move(pane));
+    }
+
+    void pop() {
+        if (older.empty()) {
+            for (auto it = newer.rbegin(); it != newer.rend(); ++it) {
+                older.push_back(types::combine(aggregator, std::move(*it), older.empty() ? maybe_accumulator() : older.back()));
+            }
+            newer.clear();
+            newer_total.reset();
+        }
+        older.pop_back();
+    }
+
+    maybe_accumulator query() const {
+        return types::combine(aggregator, older.empty() ? maybe_accumulator() : older.back(), newer_total);
+    }
+
+    /// true when a pane holds an item. does not call combine
+    bool has_items() const {
+        return (!older.empty() && !older.back().empty()) || !newer_total.empty();
+    }
+
+    void clear() {
+        older.clear();
+        newer.clear();
+        newer_total.reset();
+    }
+
+    aggregator_type aggregator;
+    // back() is the oldest pane, holding the total of all the older panes
+    std::vector<maybe_accumulator> older;
+    std::vector<maybe_accumulator> newer;
+    maybe_accumulator newer_total;
+};
+
+template<class T, class Aggregator, class Coordination>
+struct aggregate_window_hopping
+{
+    typedef aggregate_window_types<T, Aggregator> types;
+    typedef typename types::source_value_type source_value_type;
+    typedef typename types::aggregator_type aggregator_type;
+    typedef typename types::maybe_accumulator maybe_accumulator;
+    typedef typename types::value_type value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+
+    struct aggregate_window_values
+    {
+        aggregate_window_values(hopping_window w, aggregator_type a, coordination_type c)
+            : window(w)
+            , aggregator(std::move(a))
+            , coordination(c)
+        {
+        }
+        hopping_window window;
+        aggregator_type aggregator;
+        coordination_type coordination;
+    };
+    aggregate_window_values initial;
+
+    aggregate_window_hopping(hopping_window window, aggregator_type aggregator, coordination_type coordination)
+        : initial(window, std::move(aggregator), coordination)
+    {
+    }
+
+    template<class Subscriber>
+    struct aggregate_window_observer
+    {
+        typedef aggregate_window_observer<Subscriber> this_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<T, this_type> observer_type;
+        typedef rxsc::scheduler::clock_type::time_point time_point_type;
+
+        struct aggregate_window_subscriber_values : public aggregate_window_values
+        {
+            aggregate_window_subscriber_values(composite_subscription cs, dest_type d, aggregate_window_values v, coordinator_type c)
+                : aggregate_window_values(v)
+                , cs(std::move(cs))
+                , dest(std::move(d))
+                , coordinator(std::move(c))
+                , worker(coordinator.get_worker())
+                , origin(worker.now())
+                , hop_ticks(this->window.hop.count())
+                , split_ticks(this->window.size.count() % hop_ticks)
+                , hop_panes(split_ticks == 0 ? 1 : 2)
+                , window_panes((this->window.size.count() / hop_ticks) * hop_panes + (split_ticks == 0 ? 0 : 1))
+                , pane(0)
+                , panes(this->aggregator)
+            {
+            }
+            composite_subscription cs;
+            dest_type dest;
+            coordinator_type coordinator;
+            rxsc::worker worker;
+            time_point_type origin;
+
+            // each hop is one pane, or two panes split where the windows end
+            long long hop_ticks;
+            long long split_ticks;
+            long long hop_panes;
+            long long window_panes;
+
+            mutable std::mutex lock;
+            // the index of the pane that is accumulating items
+            long long pane;
+            maybe_accumulator current;
+            // the closed panes of the newest window
+            aggregate_panes<T, Aggregator> panes;
+            // windows that have closed and are waiting to be emitted on the worker
+            std::deque<value_type> ready;
+
+            void close_pane() {
+                panes.push(std::move(current));
+                current.reset();
+                if (static_cast<long long>(panes.size()) > window_panes) {
+                    panes.pop();
+                }
+                auto start = ++pane - window_panes;
+                if (start >= 0 && start % hop_panes == 0) {
+                    auto total = panes.query();
+                    if (!total.empty()) {
+                        ready.push_back(this->aggregator.result(std::move(total.get())));
+                    }
+                }
+            }
+
+            // the index of the pane that holds now
+            long long pane_at(time_point_type now) const {
+                auto ticks = (now - origin).count();
+                auto target = (ticks / hop_ticks) * hop_panes;
+                if (split_ticks != 0 && ticks % hop_ticks >= split_ticks) {
+                    ++target;
+                }
+                return target;
+            }
+
+            // close every pane that ended before now. requires lock
+            void advance(time_point_type now) {
+                auto target = pane_at(now);
+                while (pane < target) {
+                    if (current.empty() && !panes.has_items()) {
+                        // every window until target is empty
+                        panes.clear();
+                        pane = target;
+                        break;
+                    }
+                    close_pane();
+                }
+            }
+
+            // close the panes of every window that holds an item. requires lock
+            void flush() {
+                while (!current.empty() || panes.has_items()) {
+                    close_pane();
+                }
+            }
+        };
+        std::shared_ptr<aggregate_window_subscriber_values> state;
+
+        aggregate_window_observer(composite_subscription cs, dest_type d, aggregate_window_values v, coordinator_type c)
+            : state(std::make_shared<aggregate_window_subscriber_values>(std::move(cs), std::move(d), std::move(v), std::move(c)))
+        {
+            auto localState = state;
+
+            auto disposer = [=](const rxsc::schedulable&){
+                localState->cs.unsubscribe();
+                localState->dest.unsubscribe();
+                localState->worker.unsubscribe();
+            };
+            auto selectedDisposer = on_exception(
+                [&](){return localState->coordinator.act(disposer);},
+                localState->dest);
+            if (selectedDisposer.empty()) {
+                return;
+            }
+
+            localState->dest.add([=](){
+                localState->worker.schedule(selectedDisposer.get());
+            });
+            localState->cs.add([=](){
+                localState->worker.schedule(selectedDisposer.get());
+            });
+
+            auto produce = [localState](const rxsc::schedulable&) {
+                std::deque<value_type> ready;
+                {
+                    std::unique_lock<std::mutex> guard(localState->lock);
+                    localState->advance(localState->worker.now());
+                    swap(ready, localState->ready);
+                }
+                for (auto& v : ready) {
+                    localState->dest.on_next(std::move(v));
+                }
+            };
+            auto selectedProduce = on_exception(
+                [&](){return localState->coordinator.act(produce);},
+                localState->dest);
+            if (selectedProduce.empty()) {
+                return;
+            }
+
+            // a window ends every hop, starting with the first window
+            state->worker.schedule_periodically(
+                state->origin + state->window.size,
+                state->window.hop,
+                [localState, selectedProduce](const rxsc::schedulable&) {
+                    localState->worker.schedule(selectedProduce.get());
+                });
+        }
+
+        void on_next(T v) const {
+            auto localState = state;
+            auto now = localState->worker.now();
+            auto item = localState->aggregator.lift(v);
+            std::unique_lock<std::mutex> guard(localState->lock);
+            localState->advance(now);
+            if (localState->current.empty()) {
+                localState->current.reset(std::move(item));
+            } else {
+                localState->current.reset(localState->aggregator.combine(std::move(localState->current.get()), std::move(item)));
+            }
+        }
+        void on_error(rxu::error_ptr e) const {
+            auto localState = state;
+            auto work = [e, localState](const rxsc::schedulable&){
+                localState->dest.on_error(e);
+            };
+            auto selectedWork = on_exception(
+                [&](){return localState->coordinator.act(work);},
+                localState->dest);
+            if (selectedWork.empty()) {
+                return;
+            }
+            localState->worker.schedule(selectedWork.get());
+        }
+        void on_completed() const {
+            auto localState = state;
+            auto work = [localState](const rxsc::schedulable&){
+                auto done = on_exception(
+                    [&](){
+                        std::deque<value_type> ready;
+                        {
+                            std::unique_lock<std::mutex> guard(localState->lock);
+                            localState->advance(localState->worker.now());
+                            localState->flush();
+                            swap(ready, localState->ready);
+                        }
+                        for (auto& v : ready) {
+                            localState->dest.on_next(std::move(v));
+                        }
+                        return true;
+                    },
+                    localState->dest);
+                if (done.empty()) {
+                    return;
+                }
+                localState->dest.on_completed();
+            };
+            auto selectedWork = on_exception(
+                [&](){return localState->coordinator.act(work);},
+                localState->dest);
+            if (selectedWork.empty()) {
+                return;
+            }
+            localState->worker.schedule(selectedWork.get());
+        }
+
+        static subscriber<T, observer_type> make(dest_type d, aggregate_window_values v) {
+            auto cs = composite_subscription();
+            auto coordinator = v.coordination.create_coordinator();
+
+            return make_subscriber<T>(cs, observer_type(this_type(cs, std::move(d), std::move(v), std::move(coordinator))));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(aggregate_window_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      aggregate_window_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+template<class T, class Aggregator, class Coordination>
+struct aggregate_window_session
+{
+    typedef aggregate_window_types<T, Aggregator> types;
+    typedef typename types::source_value_type source_value_type;
+    typedef typename types::aggregator_type aggregator_type;
+    typedef typename types::maybe_accumulator maybe_accumulator;
+    typedef typename types::value_type value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+
+    struct aggregate_window_values
+    {
+        aggregate_window_values(session_window w, aggregator_type a, coordination_type c)
+            : window(w)
+            , aggregator(std::move(a))
+            , coordination(c)
+        {
+        }
+        session_window window;
+        aggregator_type aggregator;
+        coordination_type coordination;
+    };
+    aggregate_window_values initial;
+
+    aggregate_window_session(session_window window, aggregator_type aggregator, coordination_type coordination)
+        : initial(window, std::move(aggregator), coordination)
+    {
+    }
+
+    template<class Subscriber>
+    struct aggregate_window_observer
+    {
+        typedef aggregate_window_observer<Subscriber> this_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<T, this_type> observer_type;
+        typedef rxsc::scheduler::clock_type::time_point time_point_type;
+
+        struct aggregate_window_subscriber_values : public aggregate_window_values
+        {
+            aggregate_window_subscriber_values(composite_subscription cs, dest_type d, aggregate_window_values v, coordinator_type c)
+                : aggregate_window_values(v)
+                , cs(std::move(cs))
+                , dest(std::move(d))
+                , coordinator(std::move(c))
+                , worker(coordinator.get_worker())
+                , armed(false)
+            {
+            }
+            composite_subscription cs;
+            dest_type dest;
+            coordinator_type coordinator;
+            rxsc::worker worker;
+
+            // a single timer is armed while a session is open. it is
+            // re-armed for the last item when it fires early.
+            mutable std::mutex lock;
+            maybe_accumulator session;
+            time_point_type last;
+            bool armed;
+            rxu::maybe<rxsc::schedulable> timer;
+            // sessions that have closed and are waiting to be emitted on the worker
+            std::deque<value_type> ready;
+
+            // requires lock
+            void close_session() {
+                ready.push_back(this->aggregator.result(std::move(session.get())));
+                session.reset();
+            }
+        };
+        std::shared_ptr<aggregate_window_subscriber_values> state;
+
+        aggregate_window_observer(composite_subscription cs, dest_type d, aggregate_window_values v, coordinator_type c)
+            : state(std::make_shared<aggregate_window_subscriber_values>(std::move(cs), std::move(d), std::move(v), std::move(c)))
+        {
+            auto localState = state;
+
+            auto disposer = [=](const rxsc::schedulable&){
+                localState->cs.unsubscribe();
+                localState->dest.unsubscribe();
+                localState->worker.unsubscribe();
+            };
+            auto selectedDisposer = on_exception(
+                [&](){return localState->coordinator.act(disposer);},
+                localState->dest);
+            if (selectedDisposer.empty()) {
+                return;
+            }
+
+            localState->dest.add([=](){
+                localState->worker.schedule(selectedDisposer.get());
+            });
+            localState->cs.add([=](){
+                localState->worker.schedule(selectedDisposer.get());
+            });
+
+            std::weak_ptr<aggregate_window_subscriber_values> weakState = localState;
+            auto expire = [weakState](const rxsc::schedulable& self){
+                auto localState = weakState.lock();
+                if (!localState) {
+                    return;
+                }
+                std::deque<value_type> ready;
+                {
+                    std::unique_lock<std::mutex> guard(localState->lock);
+                    if (!localState->session.empty()) {
+                        auto due = localState->last + localState->window.gap;
+                        if (due > localState->worker.now()) {
+                            self.schedule(due);
+                        } else {
+                            localState->close_session();
+                        }
+                    }
+                    localState->armed = !localState->session.empty();
+                    swap(ready, localState->ready);
+                }
+                for (auto& v : ready) {
+                    localState->dest.on_next(std::move(v));
+                }
+            };
+            auto selectedExpire = on_exception(
+                [&](){return localState->coordinator.act(expire);},
+                localState->dest);
+            if (selectedExpire.empty()) {
+                return;
+            }
+            localState->timer.reset(rxsc::make_schedulable(localState->worker, selectedExpire.get()));
+        }
+
+        void on_next(T v) const {
+            auto localState = state;
+            if (localState->timer.empty()) {
+                return;
+            }
+            auto now = localState->worker.now();
+            auto item = localState->aggregator.lift(v);
+            bool arm = false;
+            {
+                std::unique_lock<std::mutex> guard(localState->lock);
+                if (!localState->session.empty() && now - localState->last >= localState->window.gap) {
+                    // the timer has not run yet, it will emit this session
+                    localState->close_session();
+                }
+                if (localState->session.empty()) {
+                    localState->session.reset(std::move(item));
+                } else {
+                    localState->session.reset(localState->aggregator.combine(std::move(localState->session.get()), std::move(item)));
+                }
+                localState->last = now;
+                arm = !localState->armed;
+                localState->armed = true;
+            }
+            if (arm) {
+                localState->timer.get().schedule(now + localState->window.gap);
+            }
+        }
+        void on_error(rxu::error_ptr e) const {
+            auto localState = state;
+            auto work = [e, localState](const rxsc::schedulable&){
+                localState->dest.on_error(e);
+            };
+            auto selectedWork = on_exception(
+                [&](){return localState->coordinator.act(work);},
+                localState->dest);
+            if (selectedWork.empty()) {
+                return;
+            }
+            localState->worker.schedule(selectedWork.get());
+        }
+        void on_completed() const {
+            auto localState = state;
+            auto work = [localState](const rxsc::schedulable&){
+                auto done = on_exception(
+                    [&](){
+                        std::deque<value_type> ready;
+                        {
+                            std::unique_lock<std::mutex> guard(localState->lock);
+                            if (!localState->session.empty()) {
+                                localState->close_session();
+                            }
+                            swap(ready, localState->ready);
+                        }
+                        for (auto& v : ready) {
+                            localState->dest.on_next(std::move(v));
+                        }
+                        return true;
+                    },
+                    localState->dest);
+                if (done.empty()) {
+                    return;
+                }
+                localState->dest.on_completed();
+            };
+            auto selectedWork = on_exception(
+                [&](){return localState->coordinator.act(work);},
+                localState->dest);
+            if (selectedWork.empty()) {
+                return;
+            }
+            localState->worker.schedule(selectedWork.get());
+        }
+
+        static subscriber<T, observer_type> make(dest_type d, aggregate_window_values v) {
+            auto cs = composite_subscription();
+            auto coordinator = v.coordination.create_coordinator();
+
+            return make_subscriber<T>(cs, observer_type(this_type(cs, std::move(d), std::move(v), std::move(coordinator))));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(aggregate_window_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      aggregate_window_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+}
+
+/*! @copydoc rx-aggregate_window.hpp
+*/
+template<class... AN>
+auto aggregate_window(AN&&... an)
+    ->      operator_factory<aggregate_window_tag, AN...> {
+     return operator_factory<aggregate_window_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<aggregate_window_tag>
+{
+    template<class Observable, class Aggregator,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class AggregateWindow = rxo::detail::aggregate_window_hopping<SourceValue, rxu::decay_t<Aggregator>, identity_one_worker>,
+        class Value = rxu::value_type_t<AggregateWindow>>
+    static auto member(Observable&& o, rxo::hopping_window w, Aggregator&& a)
+        -> decltype(o.template lift<Value>(AggregateWindow(w, std::forward<Aggregator>(a), identity_current_thread()))) {
+        return      o.template lift<Value>(AggregateWindow(w, std::forward<Aggregator>(a), identity_current_thread()));
+    }
+
+    template<class Observable, class Aggregator, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_coordination<Coordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class AggregateWindow = rxo::detail::aggregate_window_hopping<SourceValue, rxu::decay_t<Aggregator>, rxu::decay_t<Coordination>>,
+        class Value = rxu::value_type_t<AggregateWindow>>
+    static auto member(Observable&& o, rxo::hopping_window w, Aggregator&& a, Coordination&& cn)
+        -> decltype(o.template lift<Value>(AggregateWindow(w, std::forward<Aggregator>(a), std::forward<Coordination>(cn)))) {
+        return      o.template lift<Value>(AggregateWindow(w, std::forward<Aggregator>(a), std::forward<Coordination>(cn)));
+    }
+
+    template<class Observable, class Aggregator,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class AggregateWindow = rxo::detail::aggregate_window_session<SourceValue, rxu::decay_t<Aggregator>, identity_one_worker>,
+        class Value = rxu::value_type_t<AggregateWindow>>
+    static auto member(Observable&& o, rxo::session_window w, Aggregator&& a)
+        -> decltype(o.template lift<Value>(AggregateWindow(w, std::forward<Aggregator>(a), identity_current_thread()))) {
+        return      o.template lift<Value>(AggregateWindow(w, std::forward<Aggregator>(a), identity_current_thread()));
+    }
+
+    template<class Observable, class Aggregator, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_coordination<Coordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class AggregateWindow = rxo::detail::aggregate_window_session<SourceValue, rxu::decay_t<Aggregator>, rxu::decay_t<Coordination>>,
+        class Value = rxu::value_type_t<AggregateWindow>>
+    static auto member(Observable&& o, rxo::session_window w, Aggregator&& a, Coordination&& cn)
+        -> decltype(o.template lift<Value>(AggregateWindow(w, std::forward<Aggregator>(a), std::forward<Coordination>(cn)))) {
+        return      o.template lift<Value>(AggregateWindow(w, std::forward<Aggregator>(a), std::forward<Coordination>(cn)));
+    }
+
+    template<class... AN>
+    static operators::detail::aggregate_window_invalid_t<AN...> member(AN...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "aggregate_window takes (tumbling_window|hopping_window|session_window, Aggregator, optional Coordination)");
+    }
+};
+
+}
+
+#endif
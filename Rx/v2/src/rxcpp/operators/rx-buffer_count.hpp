@@ -9,6 +9,11 @@
 
     \param count  the maximum size of each buffers before it should be emitted.
     \param skip   how many items need to be skipped before starting a new buffers (optional).
+    \param shared_buffers  emit shared_buffer<T> views instead of std::vector<T> (optional).
+
+    When shared_buffers is passed, each item is stored once in a contiguous store that is shared by all the
+    overlapping buffers. Each buffer is emitted as a shared_buffer<T>, a refcounted view that keeps its part of
+    the store alive. Use shared_buffer<T>::to_vector() to copy a buffer that must be modified.
 
     \return  Observable that emits connected, non-overlapping buffers, each containing at most count items from the source observable.
              If the skip parameter is set, return an Observable that emits buffers every skip items containing at most count items from the source observable.
@@ -31,6 +36,79 @@ namespace rxcpp {
 
 namespace operators {
 
+/// selects the buffer overload that emits shared_buffer<T> views
+struct shared_buffers {};
+
+/// a read-only, contiguous view of a buffer emitted by buffer(count, skip, shared_buffers()).
+/// copies of the view share the same storage.
+template<class T>
+class shared_buffer
+{
+public:
+    typedef T value_type;
+    typedef const T* const_iterator;
+    typedef const_iterator iterator;
+    typedef const T& const_reference;
+    typedef const_reference reference;
+    typedef std::size_t size_type;
+
+    shared_buffer()
+        : first(nullptr)
+        , last(nullptr)
+    {
+    }
+    shared_buffer(std::shared_ptr<const void> s, const T* f, const T* l)
+        : store(std::move(s))
+        , first(f)
+        , last(l)
+    {
+    }
+
+    const_iterator begin() const {
+        return first;
+    }
+    const_iterator end() const {
+        return last;
+    }
+    const T* data() const {
+        return first;
+    }
+    size_type size() const {
+        return static_cast<size_type>(last - first);
+    }
+    bool empty() const {
+        return first == last;
+    }
+    const_reference operator[](size_type i) const {
+        return first[i];
+    }
+    const_reference front() const {
+        return *first;
+    }
+    const_reference back() const {
+        return *(last - 1);
+    }
+
+    /// copy the items out of the shared storage
+    std::vector<T> to_vector() const {
+        return std::vector<T>(first, last);
+    }
+
+private:
+    std::shared_ptr<const void> store;
+    const T* first;
+    const T* last;
+};
+
+template<class T>
+bool operator==(const shared_buffer<T>& lhs, const shared_buffer<T>& rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+template<class T>
+bool operator!=(const shared_buffer<T>& lhs, const shared_buffer<T>& rhs) {
+    return !(lhs == rhs);
+}
+
 namespace detail {
 
 template<class... AN>
@@ -128,6 +206,113 @@ struct buffer_count
     }
 };
 
+template<class T>
+struct buffer_count_shared
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef shared_buffer<source_value_type> value_type;
+
+    typedef typename buffer_count<T>::buffer_count_values buffer_count_values;
+
+    buffer_count_values initial;
+
+    buffer_count_shared(int count, int skip)
+        : initial(count, skip)
+    {
+    }
+
+    template<class Subscriber>
+    struct buffer_count_shared_observer : public buffer_count_values
+    {
+        typedef buffer_count_shared_observer<Subscriber> this_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef std::vector<source_value_type> store_type;
+        typedef std::shared_ptr<store_type> store_ptr;
+        dest_type dest;
+        // the absolute index of the next item
+        mutable long long cursor;
+        // the absolute index of the first item in the oldest open buffer
+        mutable long long next;
+        // the absolute index of store->front()
+        mutable long long base;
+        mutable store_ptr store;
+
+        buffer_count_shared_observer(dest_type d, buffer_count_values v)
+            : buffer_count_values(v)
+            , dest(std::move(d))
+            , cursor(0)
+            , next(0)
+            , base(0)
+        {
+        }
+
+        // the store never reallocates, so emitted views stay valid while
+        // later items are appended. when it is full, the items of the open
+        // buffers are moved to a new store and the old store is released
+        // by the last view that refers to it.
+        void append(source_value_type v) const {
+            auto capacity = std::size_t(this->count) * 2;
+            // a gap between buffers (skip > count) also starts a new store
+            if (!store || store->size() == capacity || base + (long long)store->size() != cursor) {
+                auto replacement = std::make_shared<store_type>();
+                replacement->reserve(capacity);
+                if (!!store && next < cursor) {
+                    replacement->insert(replacement->end(), store->begin() + (next - base), store->end());
+                }
+                base = !!store && next < cursor ? next : cursor;
+                store = std::move(replacement);
+            }
+            store->push_back(std::move(v));
+        }
+
+        shared_buffer<source_value_type> view(long long first, long long last) const {
+            const source_value_type* data = store->data();
+            return shared_buffer<source_value_type>(store, data + (first - base), data + (last - base));
+        }
+
+        void on_next(T v) const {
+            auto index = cursor;
+            // items in the gap between buffers (skip > count) are not stored
+            if (index >= next && index - next < this->count) {
+                append(std::move(v));
+            }
+            ++cursor;
+            if (cursor - next == this->count) {
+                dest.on_next(view(next, cursor));
+                next += this->skip;
+            }
+        }
+        void on_error(rxu::error_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            auto done = on_exception(
+                [&](){
+                    for (; next < cursor; next += this->skip) {
+                        dest.on_next(view(next, cursor));
+                    }
+                    return true;
+                },
+                dest);
+            if (done.empty()) {
+                return;
+            }
+            dest.on_completed();
+        }
+
+        static subscriber<T, observer<T, this_type>> make(dest_type d, buffer_count_values v) {
+            auto cs = d.get_subscription();
+            return make_subscriber<T>(std::move(cs), this_type(std::move(d), std::move(v)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(buffer_count_shared_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      buffer_count_shared_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
 }
 
 /*! @copydoc rx-buffer_count.hpp
@@ -165,11 +350,33 @@ struct member_overload<buffer_count_tag>
         return      o.template lift<Value>(BufferCount(count, count));
     }
 
+    template<class Observable,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class BufferCount = rxo::detail::buffer_count_shared<SourceValue>,
+        class Value = rxu::value_type_t<BufferCount>>
+    static auto member(Observable&& o, int count, int skip, rxo::shared_buffers)
+        -> decltype(o.template lift<Value>(BufferCount(count, skip))) {
+        return      o.template lift<Value>(BufferCount(count, skip));
+    }
+
+    template<class Observable,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class BufferCount = rxo::detail::buffer_count_shared<SourceValue>,
+        class Value = rxu::value_type_t<BufferCount>>
+    static auto member(Observable&& o, int count, rxo::shared_buffers)
+        -> decltype(o.template lift<Value>(BufferCount(count, count))) {
+        return      o.template lift<Value>(BufferCount(count, count));
+    }
+
     template<class... AN>
     static operators::detail::buffer_count_invalid_t<AN...> member(AN...) {
         std::terminate();
         return {};
-        static_assert(sizeof...(AN) == 10000, "buffer takes (Count, optional Skip)");
+        static_assert(sizeof...(AN) == 10000, "buffer takes (Count, optional Skip, optional shared_buffers)");
     }
 };
 
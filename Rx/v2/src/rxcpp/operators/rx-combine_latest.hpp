@@ -16,6 +16,14 @@
 
     If aggregation function is omitted, the resulting observable returns tuples of emitted items.
 
+    The aggregation function is called with a const reference to the latest value from each observable.
+
+    If throttle_latest() follows the scheduler, each item updates the latest values and at most one item is emitted
+    for each action on the scheduler. A burst of items that arrive before the scheduler runs is combined into a
+    single item with the latest values. This is not a time based rate limit. There is no period, and a scheduler
+    that runs each action as it is scheduled (identity_current_thread, identity_immediate) emits once for each item.
+    The latest values are guarded by a lock, so the sources may call on_next from different threads.
+
     \sample
 
     Neither scheduler nor aggregation function are present:
@@ -44,6 +52,10 @@ namespace rxcpp {
 
 namespace operators {
 
+/// selects the combine_latest overload that emits at most once per action on the coordination.
+/// there is no period, a burst is only combined while the emission waits for the scheduler to run it.
+struct throttle_latest {};
+
 namespace detail {
 
 template<class... AN>
@@ -62,7 +74,10 @@ struct is_combine_latest_selector_check {
 
     struct tag_not_valid;
     template<class CS, class... CON>
-    static auto check(int) -> decltype((*(CS*)nullptr)((*(typename CON::value_type*)nullptr)...));
+    static auto check(int) -> decltype((*(CS*)nullptr)((*(const typename CON::value_type*)nullptr)...));
+    // selectors that take non-const references are called with copies
+    template<class CS, class... CON>
+    static auto check(long) -> decltype((*(CS*)nullptr)((*(typename CON::value_type*)nullptr)...));
     template<class CS, class... CON>
     static tag_not_valid check(...);
 
@@ -115,23 +130,57 @@ struct combine_latest : public operator_base<rxu::value_type_t<combine_latest_tr
 
     struct values
     {
-        values(tuple_source_type o, selector_type s, coordination_type sf)
+        values(tuple_source_type o, selector_type s, coordination_type sf, bool t)
             : source(std::move(o))
             , selector(std::move(s))
             , coordination(std::move(sf))
+            , throttle(t)
         {
         }
         tuple_source_type source;
         selector_type selector;
         coordination_type coordination;
+        bool throttle;
     };
     values initial;
 
-    combine_latest(coordination_type sf, selector_type s, tuple_source_type ts)
-        : initial(std::move(ts), std::move(s), std::move(sf))
+    combine_latest(coordination_type sf, selector_type s, tuple_source_type ts, bool throttle = false)
+        : initial(std::move(ts), std::move(s), std::move(sf), throttle)
     {
     }
 
+    template<class State>
+    static void emit_latest(const std::shared_ptr<State>& state) {
+        // the selector reads the latest values in place
+        state->out.on_next(rxu::apply_surely(state->latest, state->selector));
+    }
+
+    // schedules one emission for all the items that arrive before it runs.
+    // the caller has set pending while holding the lock
+    template<class State>
+    static void schedule_latest(const std::shared_ptr<State>& state) {
+        std::weak_ptr<State> weakState = state;
+        auto emit = [weakState](const rxsc::schedulable&) {
+            auto state = weakState.lock();
+            if (!state) {
+                return;
+            }
+            std::unique_lock<std::mutex> guard(state->lock);
+            // items that arrive after this point schedule another emission
+            state->pending = false;
+            auto selected = rxu::apply_surely(state->latest, state->selector);
+            guard.unlock();
+            state->out.on_next(std::move(selected));
+        };
+        auto selectedEmit = on_exception(
+            [&](){return state->coordinator.act(emit);},
+            state->out);
+        if (selectedEmit.empty()) {
+            return;
+        }
+        state->worker.schedule(selectedEmit.get());
+    }
+
     template<int Index, class State>
     void subscribe_one(std::shared_ptr<State> state) const {
 
@@ -158,18 +207,33 @@ struct combine_latest : public operator_base<rxu::value_type_t<combine_latest_tr
             innercs,
         // on_next
             [state](source_value_type st) {
+                if (state->throttle) {
+                    // the sources may run on different threads than the emission
+                    std::unique_lock<std::mutex> guard(state->lock);
+                    auto& value = std::get<Index>(state->latest);
+                    if (value.empty()) {
+                        ++state->valuesSet;
+                    }
+                    value.reset(std::move(st));
+                    if (state->valuesSet != sizeof... (ObservableN) || state->pending) {
+                        return;
+                    }
+                    state->pending = true;
+                    guard.unlock();
+                    schedule_latest(state);
+                    return;
+                }
+
                 auto& value = std::get<Index>(state->latest);
 
                 if (value.empty()) {
                     ++state->valuesSet;
                 }
 
-                value.reset(st);
+                value.reset(std::move(st));
 
                 if (state->valuesSet == sizeof... (ObservableN)) {
-                    auto values = rxu::surely(state->latest);
-                    auto selectedResult = rxu::apply(values, state->selector);
-                    state->out.on_next(selectedResult);
+                    emit_latest(state);
                 }
             },
         // on_error
@@ -178,8 +242,26 @@ struct combine_latest : public operator_base<rxu::value_type_t<combine_latest_tr
             },
         // on_completed
             [state]() {
+                if (!state->throttle) {
+                    if (--state->pendingCompletions == 0) {
+                        state->out.on_completed();
+                    }
+                    return;
+                }
+                std::unique_lock<std::mutex> guard(state->lock);
                 if (--state->pendingCompletions == 0) {
-                    state->out.on_completed();
+                    guard.unlock();
+                    // completes after the emission that is scheduled
+                    auto complete = [state](const rxsc::schedulable&) {
+                        state->out.on_completed();
+                    };
+                    auto selectedComplete = on_exception(
+                        [&](){return state->coordinator.act(complete);},
+                        state->out);
+                    if (selectedComplete.empty()) {
+                        return;
+                    }
+                    state->worker.schedule(selectedComplete.get());
                 }
             }
         );
@@ -211,7 +293,9 @@ struct combine_latest : public operator_base<rxu::value_type_t<combine_latest_tr
                 : values(std::move(i))
                 , pendingCompletions(sizeof... (ObservableN))
                 , valuesSet(0)
+                , pending(false)
                 , coordinator(std::move(coor))
+                , worker(coordinator.get_worker())
                 , out(std::move(oarg))
             {
             }
@@ -221,7 +305,12 @@ struct combine_latest : public operator_base<rxu::value_type_t<combine_latest_tr
             mutable int pendingCompletions;
             mutable int valuesSet;
             mutable tuple_source_value_type latest;
+            // an emission is scheduled (throttle only)
+            mutable bool pending;
+            // guards latest, valuesSet, pendingCompletions and pending (throttle only)
+            mutable std::mutex lock;
             coordinator_type coordinator;
+            rxsc::worker worker;
             output_type out;
         };
 
@@ -299,11 +388,37 @@ struct member_overload<combine_latest_tag>
         return Result(combine_latest(std::forward<Coordination>(cn), std::forward<Selector>(s), std::make_tuple(std::forward<Observable>(o), std::forward<ObservableN>(on)...)));
     }
 
+    template<class Coordination, class Observable, class... ObservableN,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_coordination<Coordination>,
+            all_observables<Observable, ObservableN...>>,
+        class combine_latest = rxo::detail::combine_latest<Coordination, rxu::detail::pack, rxu::decay_t<Observable>, rxu::decay_t<ObservableN>...>,
+        class Value = rxu::value_type_t<combine_latest>,
+        class Result = observable<Value, combine_latest>>
+    static Result member(Observable&& o, Coordination&& cn, rxo::throttle_latest, ObservableN&&... on)
+    {
+        return Result(combine_latest(std::forward<Coordination>(cn), rxu::pack(), std::make_tuple(std::forward<Observable>(o), std::forward<ObservableN>(on)...), true));
+    }
+
+    template<class Coordination, class Selector, class Observable, class... ObservableN,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_coordination<Coordination>,
+            operators::detail::is_combine_latest_selector<Selector, Observable, ObservableN...>,
+            all_observables<Observable, ObservableN...>>,
+        class ResolvedSelector = rxu::decay_t<Selector>,
+        class combine_latest = rxo::detail::combine_latest<Coordination, ResolvedSelector, rxu::decay_t<Observable>, rxu::decay_t<ObservableN>...>,
+        class Value = rxu::value_type_t<combine_latest>,
+        class Result = observable<Value, combine_latest>>
+    static Result member(Observable&& o, Coordination&& cn, rxo::throttle_latest, Selector&& s, ObservableN&&... on)
+    {
+        return Result(combine_latest(std::forward<Coordination>(cn), std::forward<Selector>(s), std::make_tuple(std::forward<Observable>(o), std::forward<ObservableN>(on)...), true));
+    }
+
     template<class... AN>
     static operators::detail::combine_latest_invalid_t<AN...> member(const AN&...) {
         std::terminate();
         return {};
-        static_assert(sizeof...(AN) == 10000, "combine_latest takes (optional Coordination, optional Selector, required Observable, optional Observable...), Selector takes (Observable::value_type...)");
+        static_assert(sizeof...(AN) == 10000, "combine_latest takes (optional Coordination, optional throttle_latest, optional Selector, required Observable, optional Observable...), Selector takes (Observable::value_type...)");
     } 
 };
 
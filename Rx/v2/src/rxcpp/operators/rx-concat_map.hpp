@@ -139,6 +139,7 @@ struct concat_map
                 : values(std::move(i))
                 , sourceLifetime(composite_subscription::empty())
                 , collectionLifetime(composite_subscription::empty())
+                , generation(0)
                 , coordinator(std::move(coor))
                 , out(std::move(oarg))
             {
@@ -155,15 +156,13 @@ struct concat_map
                     return;
                 }
 
-                collectionLifetime = composite_subscription();
+                // release the previous collection from the slot
+                collectionSlot.clear();
 
-                // when the out observer is unsubscribed all the
-                // inner subscriptions are unsubscribed as well
-                auto innercstoken = state->out.add(collectionLifetime);
+                collectionLifetime = composite_subscription();
+                collectionSlot.add(collectionLifetime);
 
-                collectionLifetime.add(make_subscription([state, innercstoken](){
-                    state->out.remove(innercstoken);
-                }));
+                auto generation = ++state->generation;
 
                 auto selectedSource = on_exception(
                     [&](){return state->coordinator.in(selectedCollection.get());},
@@ -178,16 +177,27 @@ struct concat_map
                     state->out,
                     collectionLifetime,
                 // on_next
-                    [state, st](collection_value_type ct) {
+                    [state, st, generation](collection_value_type ct) {
+                        if (generation != state->generation) {
+                            return;
+                        }
                         auto selectedResult = state->selectResult(st, std::move(ct));
                         state->out.on_next(std::move(selectedResult));
                     },
                 // on_error
-                    [state](rxu::error_ptr e) {
+                    [state, generation](rxu::error_ptr e) {
+                        if (generation != state->generation) {
+                            return;
+                        }
                         state->out.on_error(e);
                     },
                 //on_completed
-                    [state](){
+                    [state, generation](){
+                        if (generation != state->generation) {
+                            return;
+                        }
+                        // drop anything the completed collection sends later
+                        ++state->generation;
                         if (!state->selectedCollections.empty()) {
                             auto value = state->selectedCollections.front();
                             state->selectedCollections.pop_front();
@@ -208,6 +218,12 @@ struct concat_map
             }
             composite_subscription sourceLifetime;
             composite_subscription collectionLifetime;
+            // holds the current collection subscription. it is added to out
+            // once and cleared, rather than replaced, for each collection.
+            composite_subscription collectionSlot;
+            // identifies the current collection. callbacks from a collection
+            // that has been released are dropped.
+            std::uint64_t generation;
             std::deque<source_value_type> selectedCollections;
             coordinator_type coordinator;
             output_type out;
@@ -223,6 +239,7 @@ struct concat_map
         // when the out observer is unsubscribed all the
         // inner subscriptions are unsubscribed as well
         state->out.add(state->sourceLifetime);
+        state->out.add(state->collectionSlot);
 
         auto source = on_exception(
             [&](){return state->coordinator.in(state->source);},
@@ -73,6 +73,15 @@ struct delay
         typedef rxu::decay_t<Subscriber> dest_type;
         typedef observer<T, this_type> observer_type;
 
+        typedef rxsc::scheduler::clock_type::time_point time_point_type;
+
+        struct delay_item
+        {
+            time_point_type due;
+            // empty for on_completed
+            rxu::maybe<value_type> value;
+        };
+
         struct delay_subscriber_values : public delay_values
         {
             delay_subscriber_values(composite_subscription cs, dest_type d, delay_values v, coordinator_type c)
@@ -82,6 +91,8 @@ struct delay
                 , coordinator(std::move(c))
                 , worker(coordinator.get_worker())
                 , expected(worker.now())
+                , armed(false)
+                , dispose_when_drained(false)
             {
             }
             composite_subscription cs;
@@ -89,11 +100,22 @@ struct delay
             coordinator_type coordinator;
             rxsc::worker worker;
             rxsc::scheduler::clock_type::time_point expected;
+
+            // the period is constant, so items are due in arrival order.
+            // a single timer is armed for the head of the queue and drains
+            // every item that is due when it fires.
+            mutable std::mutex lock;
+            std::deque<delay_item> queue;
+            bool armed;
+            // the source finished while items were waiting. the drain
+            // disposes once it has delivered them.
+            bool dispose_when_drained;
+            rxu::maybe<rxsc::schedulable> drain;
         };
         std::shared_ptr<delay_subscriber_values> state;
 
         delay_observer(composite_subscription cs, dest_type d, delay_values v, coordinator_type c)
-            : state(std::make_shared<delay_subscriber_values>(delay_subscriber_values(std::move(cs), std::move(d), v, std::move(c))))
+            : state(std::make_shared<delay_subscriber_values>(std::move(cs), std::move(d), v, std::move(c)))
         {
             auto localState = state;
 
@@ -113,22 +135,83 @@ struct delay
                 localState->worker.schedule(selectedDisposer.get());
             });
             localState->cs.add([=](){
+                {
+                    std::unique_lock<std::mutex> guard(localState->lock);
+                    if (!localState->queue.empty()) {
+                        localState->dispose_when_drained = true;
+                        return;
+                    }
+                }
                 localState->worker.schedule(localState->worker.now() + localState->period, selectedDisposer.get());
             });
-        }
 
-        void on_next(T v) const {
-            auto localState = state;
-            auto work = [v, localState](const rxsc::schedulable&){
-                localState->dest.on_next(v);
+            std::weak_ptr<delay_subscriber_values> weakState = localState;
+            auto drain = [weakState](const rxsc::schedulable& self){
+                auto localState = weakState.lock();
+                if (!localState) {
+                    return;
+                }
+                for (;;) {
+                    delay_item item;
+                    {
+                        std::unique_lock<std::mutex> guard(localState->lock);
+                        if (localState->queue.empty()) {
+                            localState->armed = false;
+                            if (localState->dispose_when_drained) {
+                                guard.unlock();
+                                // the drain runs on the worker, like the disposer
+                                localState->cs.unsubscribe();
+                                localState->dest.unsubscribe();
+                                localState->worker.unsubscribe();
+                            }
+                            return;
+                        }
+                        auto due = localState->queue.front().due;
+                        if (due > localState->worker.now()) {
+                            // re-arm for the new head
+                            self.schedule(due);
+                            return;
+                        }
+                        item = std::move(localState->queue.front());
+                        localState->queue.pop_front();
+                    }
+                    if (item.value.empty()) {
+                        localState->dest.on_completed();
+                    } else {
+                        localState->dest.on_next(std::move(item.value.get()));
+                    }
+                }
             };
-            auto selectedWork = on_exception(
-                [&](){return localState->coordinator.act(work);},
+            auto selectedDrain = on_exception(
+                [&](){return localState->coordinator.act(drain);},
                 localState->dest);
-            if (selectedWork.empty()) {
+            if (selectedDrain.empty()) {
+                return;
+            }
+            localState->drain.reset(rxsc::make_schedulable(localState->worker, selectedDrain.get()));
+        }
+
+        void enqueue(rxu::maybe<value_type> v) const {
+            auto localState = state;
+            if (localState->drain.empty()) {
                 return;
             }
-            localState->worker.schedule(localState->worker.now() + localState->period, selectedWork.get());
+            auto due = localState->worker.now() + localState->period;
+            bool arm = false;
+            {
+                std::unique_lock<std::mutex> guard(localState->lock);
+                delay_item item = {due, std::move(v)};
+                localState->queue.push_back(std::move(item));
+                arm = !localState->armed;
+                localState->armed = true;
+            }
+            if (arm) {
+                localState->drain.get().schedule(due);
+            }
+        }
+
+        void on_next(T v) const {
+            enqueue(rxu::maybe<value_type>(std::move(v)));
         }
 
         void on_error(rxu::error_ptr e) const {
@@ -146,17 +229,7 @@ struct delay
         }
 
         void on_completed() const {
-            auto localState = state;
-            auto work = [localState](const rxsc::schedulable&){
-                localState->dest.on_completed();
-            };
-            auto selectedWork = on_exception(
-                [&](){return localState->coordinator.act(work);},
-                localState->dest);
-            if (selectedWork.empty()) {
-                return;
-            }
-            localState->worker.schedule(localState->worker.now() + localState->period, selectedWork.get());
+            enqueue(rxu::maybe<value_type>());
         }
 
         static subscriber<T, observer_type> make(dest_type d, delay_values v) {
@@ -6,10 +6,20 @@
 
     \brief For each item from this observable, filter out repeated values and emit only items that have not already been emitted.
 
+    \param capacity      the maximum number of values to remember, the least recently seen value is forgotten first (optional).
+                         it must be greater than zero, otherwise std::invalid_argument is thrown.
+    \param ttl           forget a value that has not been seen for this long (optional).
+    \param coordination  the clock used to measure ttl (optional).
+    \param approximate   an approximate_distinct that selects a fixed-size probabilistic filter (optional).
+
     \return Observable that emits those items from the source observable that are distinct.
 
     \note istinct keeps an unordered_set<T> of past values. Due to an issue in multiple implementations of std::hash<T>, rxcpp maintains a whitelist of hashable types. new types can be added by specializing rxcpp::filtered_hash<T>
 
+    \note with no arguments the set of past values grows for the life of the subscription. capacity and ttl bound
+           the set, a value that has been forgotten is emitted again when it is next seen. approximate_distinct
+           uses constant memory and may drop a value that was not seen before, at about the given false positive rate.
+
     \sample
     \snippet distinct.cpp distinct sample
     \snippet output.txt distinct sample
@@ -24,6 +34,21 @@ namespace rxcpp {
 
 namespace operators {
 
+/// selects the approximate distinct, which remembers at least the last capacity
+/// values in a pair of rotating Bloom filters. each value is tested against both
+/// filters, so each one is sized for half of false_positive_rate. memory is fixed
+/// at about 2 * capacity * 1.44 * log2(2 / false_positive_rate) bits.
+struct approximate_distinct
+{
+    approximate_distinct(std::size_t capacity, double false_positive_rate)
+        : capacity(capacity)
+        , false_positive_rate(false_positive_rate)
+    {
+    }
+    std::size_t capacity;
+    double false_positive_rate;
+};
+
 namespace detail {
 
 template<class... AN>
@@ -80,6 +105,269 @@ struct distinct
     }
 };
 
+template<class Count>
+std::size_t distinct_capacity(Count capacity) {
+    if (!(capacity > 0)) {
+        rxu::throw_exception(std::invalid_argument("distinct capacity must be greater than zero"));
+    }
+    return static_cast<std::size_t>(capacity);
+}
+
+/// a ttl without a capacity remembers any number of values
+const std::size_t distinct_unbounded = std::numeric_limits<std::size_t>::max();
+
+template<class T, class Coordination>
+struct distinct_bounded
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef rxsc::scheduler::clock_type clock_type;
+
+    struct distinct_bounded_values
+    {
+        distinct_bounded_values(std::size_t c, clock_type::duration t, coordination_type cn)
+            : capacity(c)
+            , ttl(t)
+            , coordination(std::move(cn))
+        {
+        }
+        std::size_t capacity;
+        clock_type::duration ttl;
+        coordination_type coordination;
+    };
+    distinct_bounded_values initial;
+
+    distinct_bounded(std::size_t capacity, clock_type::duration ttl, coordination_type coordination)
+        : initial(capacity, ttl, std::move(coordination))
+    {
+    }
+
+    template<class Subscriber>
+    struct distinct_bounded_observer : public distinct_bounded_values
+    {
+        typedef distinct_bounded_observer<Subscriber> this_type;
+        typedef source_value_type value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<value_type, this_type> observer_type;
+
+        struct seen_type
+        {
+            const source_value_type* value;
+            clock_type::time_point when;
+        };
+        // least recently seen first
+        typedef std::list<seen_type> order_type;
+        typedef std::unordered_map<source_value_type, typename order_type::iterator, rxcpp::filtered_hash<source_value_type>> remembered_type;
+
+        // the list iterators and value pointers must stay with the one list
+        // and map that they point into, so copies of the observer share them
+        struct state_type
+        {
+            order_type order;
+            remembered_type remembered;
+        };
+
+        dest_type dest;
+        std::shared_ptr<state_type> state;
+
+        distinct_bounded_observer(dest_type d, distinct_bounded_values v)
+            : distinct_bounded_values(std::move(v))
+            , dest(std::move(d))
+            , state(std::make_shared<state_type>())
+        {
+        }
+
+        bool expires() const {
+            return this->ttl != clock_type::duration::max();
+        }
+
+        void forget_oldest() const {
+            state->remembered.erase(*state->order.front().value);
+            state->order.pop_front();
+        }
+
+        void on_next(source_value_type v) const {
+            auto& order = state->order;
+            auto& remembered = state->remembered;
+            auto now = expires() ? this->coordination.now() : clock_type::time_point();
+            if (expires()) {
+                while (!order.empty() && now - order.front().when >= this->ttl) {
+                    forget_oldest();
+                }
+            }
+            auto found = remembered.find(v);
+            if (found != remembered.end()) {
+                found->second->when = now;
+                order.splice(order.end(), order, found->second);
+                return;
+            }
+            if (remembered.size() >= this->capacity) {
+                forget_oldest();
+            }
+            auto inserted = remembered.emplace(v, order.end()).first;
+            seen_type seen = {std::addressof(inserted->first), now};
+            inserted->second = order.insert(order.end(), seen);
+            dest.on_next(std::move(v));
+        }
+        void on_error(rxu::error_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            dest.on_completed();
+        }
+
+        static subscriber<value_type, observer<value_type, this_type>> make(dest_type d, distinct_bounded_values v) {
+            auto cs = d.get_subscription();
+            return make_subscriber<value_type>(std::move(cs), this_type(std::move(d), std::move(v)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+    -> decltype(distinct_bounded_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      distinct_bounded_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+/// two generations of Bloom filter. values are added to the current
+/// generation, when it holds capacity values it becomes the previous
+/// generation and the old previous generation is cleared for reuse.
+class distinct_bloom_filter
+{
+    typedef std::vector<std::uint64_t> bits_type;
+
+    std::size_t capacity;
+    std::size_t count;
+    std::uint64_t bit_count;
+    int hash_count;
+    bits_type current;
+    bits_type previous;
+
+    static std::uint64_t mix(std::uint64_t x) {
+        // splitmix64 finalizer, filtered_hash is the identity for integers
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    static bool test(const bits_type& bits, std::uint64_t bit) {
+        return (bits[bit / 64] & (std::uint64_t(1) << (bit % 64))) != 0;
+    }
+
+    template<class F>
+    void for_each_bit(std::size_t hash, F f) const {
+        auto h1 = mix(hash);
+        auto h2 = mix(h1) | 1;
+        for (int i = 0; i < hash_count; ++i) {
+            if (!f((h1 + i * h2) % bit_count)) {
+                return;
+            }
+        }
+    }
+
+    bool contains(const bits_type& bits, std::size_t hash) const {
+        bool found = true;
+        for_each_bit(hash, [&](std::uint64_t bit){
+            found = test(bits, bit);
+            return found;
+        });
+        return found;
+    }
+
+    void add(std::size_t hash) {
+        if (count == capacity) {
+            previous.swap(current);
+            std::fill(current.begin(), current.end(), 0);
+            count = 0;
+        }
+        bits_type& bits = current;
+        for_each_bit(hash, [&](std::uint64_t bit){
+            bits[bit / 64] |= std::uint64_t(1) << (bit % 64);
+            return true;
+        });
+        ++count;
+    }
+
+public:
+    explicit distinct_bloom_filter(approximate_distinct a)
+        : capacity(std::max<std::size_t>(a.capacity, 1))
+        , count(0)
+    {
+        // a value is tested against both generations, so each gets half the rate
+        auto p = std::min(std::max(a.false_positive_rate, 1e-9), 0.5) / 2;
+        const double ln2 = std::log(2.0);
+        auto bits = std::ceil(-double(capacity) * std::log(p) / (ln2 * ln2));
+        bit_count = (static_cast<std::uint64_t>(bits) + 63) / 64 * 64;
+        hash_count = std::max(1, static_cast<int>(std::round(double(bit_count) / capacity * ln2)));
+        current.assign(static_cast<std::size_t>(bit_count / 64), 0);
+        previous.assign(static_cast<std::size_t>(bit_count / 64), 0);
+    }
+
+    /// returns true when the hash was not seen before
+    bool insert(std::size_t hash) {
+        if (contains(current, hash)) {
+            return false;
+        }
+        // a value seen in the previous generation is carried forward
+        bool seen = contains(previous, hash);
+        add(hash);
+        return !seen;
+    }
+};
+
+template<class T>
+struct distinct_approximate
+{
+    typedef rxu::decay_t<T> source_value_type;
+
+    approximate_distinct initial;
+
+    explicit distinct_approximate(approximate_distinct a)
+        : initial(a)
+    {
+    }
+
+    template<class Subscriber>
+    struct distinct_approximate_observer
+    {
+        typedef distinct_approximate_observer<Subscriber> this_type;
+        typedef source_value_type value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<value_type, this_type> observer_type;
+        dest_type dest;
+        mutable distinct_bloom_filter remembered;
+
+        distinct_approximate_observer(dest_type d, approximate_distinct a)
+            : dest(std::move(d))
+            , remembered(a)
+        {
+        }
+        void on_next(source_value_type v) const {
+            if (remembered.insert(rxcpp::filtered_hash<source_value_type>()(v))) {
+                dest.on_next(std::move(v));
+            }
+        }
+        void on_error(rxu::error_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            dest.on_completed();
+        }
+
+        static subscriber<value_type, observer<value_type, this_type>> make(dest_type d, approximate_distinct a) {
+            auto cs = d.get_subscription();
+            return make_subscriber<value_type>(std::move(cs), this_type(std::move(d), a));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+    -> decltype(distinct_approximate_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      distinct_approximate_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
 }
 
 /*! @copydoc rx-distinct.hpp
@@ -106,11 +394,73 @@ struct member_overload<distinct_tag>
         return  o.template lift<SourceValue>(Distinct());
     }
 
+    template<class Observable, class Count,
+            class SourceValue = rxu::value_type_t<Observable>,
+            class Enabled = rxu::enable_if_all_true_type_t<
+                is_observable<Observable>,
+                is_hashable<SourceValue>,
+                std::is_integral<rxu::decay_t<Count>>>,
+            class Distinct = rxo::detail::distinct_bounded<SourceValue, identity_one_worker>>
+    static auto member(Observable&& o, Count&& capacity)
+    -> decltype(o.template lift<SourceValue>(Distinct(rxo::detail::distinct_capacity(capacity), rxsc::scheduler::clock_type::duration::max(), identity_current_thread()))) {
+        return  o.template lift<SourceValue>(Distinct(rxo::detail::distinct_capacity(capacity), rxsc::scheduler::clock_type::duration::max(), identity_current_thread()));
+    }
+
+    template<class Observable, class Duration,
+            class SourceValue = rxu::value_type_t<Observable>,
+            class Enabled = rxu::enable_if_all_true_type_t<
+                is_observable<Observable>,
+                is_hashable<SourceValue>,
+                rxu::is_duration<Duration>>,
+            class Distinct = rxo::detail::distinct_bounded<SourceValue, identity_one_worker>>
+    static auto member(Observable&& o, Duration&& ttl)
+    -> decltype(o.template lift<SourceValue>(Distinct(rxo::detail::distinct_unbounded, ttl, identity_current_thread()))) {
+        return  o.template lift<SourceValue>(Distinct(rxo::detail::distinct_unbounded, ttl, identity_current_thread()));
+    }
+
+    template<class Observable, class Duration, class Coordination,
+            class SourceValue = rxu::value_type_t<Observable>,
+            class Enabled = rxu::enable_if_all_true_type_t<
+                is_observable<Observable>,
+                is_hashable<SourceValue>,
+                rxu::is_duration<Duration>,
+                is_coordination<Coordination>>,
+            class Distinct = rxo::detail::distinct_bounded<SourceValue, rxu::decay_t<Coordination>>>
+    static auto member(Observable&& o, Duration&& ttl, Coordination&& cn)
+    -> decltype(o.template lift<SourceValue>(Distinct(rxo::detail::distinct_unbounded, ttl, std::forward<Coordination>(cn)))) {
+        return  o.template lift<SourceValue>(Distinct(rxo::detail::distinct_unbounded, ttl, std::forward<Coordination>(cn)));
+    }
+
+    template<class Observable, class Count, class Duration, class Coordination,
+            class SourceValue = rxu::value_type_t<Observable>,
+            class Enabled = rxu::enable_if_all_true_type_t<
+                is_observable<Observable>,
+                is_hashable<SourceValue>,
+                std::is_integral<rxu::decay_t<Count>>,
+                rxu::is_duration<Duration>,
+                is_coordination<Coordination>>,
+            class Distinct = rxo::detail::distinct_bounded<SourceValue, rxu::decay_t<Coordination>>>
+    static auto member(Observable&& o, Count&& capacity, Duration&& ttl, Coordination&& cn)
+    -> decltype(o.template lift<SourceValue>(Distinct(rxo::detail::distinct_capacity(capacity), ttl, std::forward<Coordination>(cn)))) {
+        return  o.template lift<SourceValue>(Distinct(rxo::detail::distinct_capacity(capacity), ttl, std::forward<Coordination>(cn)));
+    }
+
+    template<class Observable,
+            class SourceValue = rxu::value_type_t<Observable>,
+            class Enabled = rxu::enable_if_all_true_type_t<
+                is_observable<Observable>,
+                is_hashable<SourceValue>>,
+            class Distinct = rxo::detail::distinct_approximate<SourceValue>>
+    static auto member(Observable&& o, rxo::approximate_distinct a)
+    -> decltype(o.template lift<SourceValue>(Distinct(a))) {
+        return  o.template lift<SourceValue>(Distinct(a));
+    }
+
     template<class... AN>
     static operators::detail::distinct_invalid_t<AN...> member(AN...) {
         std::terminate();
         return {};
-        static_assert(sizeof...(AN) == 10000, "distinct takes no arguments");
+        static_assert(sizeof...(AN) == 10000, "distinct takes (optional Count, optional Duration, optional Coordination) or (approximate_distinct)");
     }
 };
 
@@ -81,6 +81,101 @@ struct is_result_function_for {
     static const bool value = !std::is_same<type, tag_not_valid>::value;
 };
 
+template<class Collection>
+struct is_contiguous_collection : public std::false_type {};
+
+template<class T, class Allocator>
+struct is_contiguous_collection<std::vector<T, Allocator>>
+    : public std::integral_constant<bool, !std::is_same<T, bool>::value> {};
+
+template<class T, std::size_t Size>
+struct is_contiguous_collection<std::array<T, Size>> : public std::true_type {};
+
+template<class T>
+struct is_contiguous_collection<std::initializer_list<T>> : public std::true_type {};
+
+template<class Accumulator, class Seed, class T>
+struct is_batch_accumulator
+{
+    typedef rxu::decay_t<Accumulator> accumulator_type;
+    typedef rxu::decay_t<Seed> seed_type;
+
+    struct tag_not_valid {};
+
+    template<class CA, class CS, class CT>
+    static auto check(int) -> decltype((*(CA*)nullptr)(*(CS*)nullptr, (const CT*)nullptr, (const CT*)nullptr));
+    template<class CA, class CS, class CT>
+    static tag_not_valid check(...);
+
+    static const bool value = std::is_same<rxu::decay_t<decltype(check<accumulator_type, seed_type, T>(0))>, seed_type>::value;
+};
+
+/// the values that a range source emits, described without visiting them.
+/// requires a step that moves first towards last.
+template<class T>
+struct range_values
+{
+    range_values(T first, T last, std::ptrdiff_t step)
+        : lowest(first < last ? first : last)
+        , highest(first < last ? last : first)
+    {
+        // unsigned arithmetic wraps, so the sum is exact whenever it fits in T
+        typedef unsigned long long wide_type;
+        wide_type distance = first < last ? wide_type(last) - wide_type(first) : wide_type(first) - wide_type(last);
+        wide_type stride = static_cast<wide_type>(step < 0 ? -step : step);
+        // first, first + step, ... and then last when the steps miss it
+        wide_type steps = distance / stride + 1;
+        wide_type triangle = steps % 2 == 0 ? (steps / 2) * (steps - 1) : steps * ((steps - 1) / 2);
+        wide_type total = steps * wide_type(first) + static_cast<wide_type>(static_cast<long long>(step)) * triangle;
+        if (distance % stride != 0) {
+            total += wide_type(last);
+        }
+        sum = static_cast<T>(total);
+    }
+    T lowest;
+    T highest;
+    T sum;
+};
+
+template<class T>
+struct sum;
+template<class T>
+struct max;
+template<class T>
+struct min;
+
+/// the accumulators that fold a range_values. a generic accumulator would
+/// also accept a range_values as if it were one value, so they are listed.
+template<class Accumulator, class T>
+struct is_range_accumulator : public std::false_type {};
+template<class T>
+struct is_range_accumulator<sum<T>, T> : public std::true_type {};
+template<class T>
+struct is_range_accumulator<max<T>, T> : public std::true_type {};
+template<class T>
+struct is_range_accumulator<min<T>, T> : public std::true_type {};
+
+/// reduce folds the whole collection in one call to the accumulator when the
+/// source is an iterate over a contiguous arithmetic collection and the
+/// accumulator provides a (Seed, const T* first, const T* last) overload.
+/// it folds an integral range without visiting the values when the
+/// accumulator is sum, max or min.
+template<class Observable, class Accumulator, class Seed>
+struct is_batch_reducible : public std::false_type {};
+
+template<class T, class Collection, class Coordination, class Accumulator, class Seed>
+struct is_batch_reducible<observable<T, rxs::detail::iterate<Collection, Coordination>>, Accumulator, Seed>
+    : public std::integral_constant<bool,
+        std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+        is_contiguous_collection<rxu::decay_t<Collection>>::value &&
+        is_batch_accumulator<Accumulator, Seed, T>::value> {};
+
+template<class T, class Coordination, class Accumulator, class Seed>
+struct is_batch_reducible<observable<T, rxs::detail::range<T, Coordination>>, Accumulator, Seed>
+    : public std::integral_constant<bool,
+        std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+        is_range_accumulator<rxu::decay_t<Accumulator>, T>::value> {};
+
 template<class T, class Observable, class Accumulator, class ResultSelector, class Seed>
 struct reduce_traits
 {
@@ -139,6 +234,90 @@ struct reduce : public operator_base<rxu::value_type_t<reduce_traits<T, Observab
     }
     template<class Subscriber>
     void on_subscribe(Subscriber o) const {
+        on_subscribe(std::move(o), is_batch_reducible<source_type, accumulator_type, seed_type>());
+    }
+    template<class Collection, class Coordination>
+    static bool batch_ready(const rxs::detail::iterate<Collection, Coordination>&) {
+        return true;
+    }
+    template<class Coordination>
+    static bool batch_ready(const rxs::detail::range<T, Coordination>& r) {
+        // a range that does not move towards last never completes
+        const auto& range = r.initial;
+        return range.step != 0 &&
+            (range.next == range.last || (range.next < range.last) == (range.step > 0));
+    }
+
+    template<class Collection, class Coordination>
+    static seed_type batch(accumulator_type& accumulator, const seed_type& seed, const rxs::detail::iterate<Collection, Coordination>& i) {
+        const auto& collection = i.initial.collection;
+        const source_value_type* first = collection.size() == 0 ? nullptr : std::addressof(*std::begin(collection));
+        const source_value_type* last = first + collection.size();
+        return accumulator(seed, first, last);
+    }
+    template<class Coordination>
+    static seed_type batch(accumulator_type& accumulator, const seed_type& seed, const rxs::detail::range<T, Coordination>& r) {
+        const auto& range = r.initial;
+        // a const lvalue, so that the range_values overload is chosen over the one for each value
+        const range_values<T> values(range.next, range.last, range.step);
+        return accumulator(seed, values);
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber o, std::true_type) const {
+        if (!batch_ready(initial.source.source_operator)) {
+            on_subscribe(std::move(o), std::false_type());
+            return;
+        }
+
+        struct reduce_batch_state_type
+            : public reduce_initial_type
+        {
+            reduce_batch_state_type(reduce_initial_type i, Subscriber scrbr)
+                : reduce_initial_type(i)
+                , out(std::move(scrbr))
+            {
+            }
+            Subscriber out;
+
+        private:
+            reduce_batch_state_type& operator=(reduce_batch_state_type o) RXCPP_DELETE;
+        };
+
+        // the values are already known, so skip the subscription to the
+        // source and fold them in one action on its worker.
+        auto coordinator = initial.source.source_operator.initial.coordination.create_coordinator(o.get_subscription());
+
+        auto controller = coordinator.get_worker();
+
+        auto state = std::make_shared<reduce_batch_state_type>(initial, std::move(o));
+
+        auto producer = [state](const rxsc::schedulable&){
+            if (!state->out.is_subscribed()) {
+                return;
+            }
+
+            auto result = on_exception(
+                [&](){return state->result_selector(batch(state->accumulator, state->seed, state->source.source_operator));},
+                state->out);
+            if (result.empty()) {
+                return;
+            }
+            state->out.on_next(std::move(result.get()));
+            state->out.on_completed();
+        };
+
+        auto selectedProducer = on_exception(
+            [&](){return coordinator.act(producer);},
+            state->out);
+        if (selectedProducer.empty()) {
+            return;
+        }
+
+        controller.schedule(selectedProducer.get());
+    }
+    template<class Subscriber>
+    void on_subscribe(Subscriber o, std::false_type) const {
         struct reduce_state_type
             : public reduce_initial_type
             , public std::enable_shared_from_this<reduce_state_type>
@@ -186,6 +365,79 @@ private:
     reduce& operator=(reduce o) RXCPP_DELETE;
 };
 
+/// the batch kernels keep several independent partial results so that no
+/// iteration depends on the previous one. this lets the compiler vectorize
+/// the loops for the target (SSE/AVX/NEON) without intrinsics.
+static const std::size_t batch_lanes = 8;
+
+template<class T>
+T batch_sum(const T* first, const T* last, T init, std::true_type /*integral*/) {
+    // unsigned lanes wrap the same way the scalar sum does, without the
+    // undefined behaviour of signed overflow
+    typedef typename std::make_unsigned<T>::type lane_type;
+    lane_type lanes[batch_lanes] = {};
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    const T* body = first + (count - (count % batch_lanes));
+    for (; first != body; first += batch_lanes) {
+        for (std::size_t i = 0; i < batch_lanes; ++i) {
+            lanes[i] = static_cast<lane_type>(lanes[i] + static_cast<lane_type>(first[i]));
+        }
+    }
+    lane_type result = static_cast<lane_type>(init);
+    for (std::size_t i = 0; i < batch_lanes; ++i) {
+        result = static_cast<lane_type>(result + lanes[i]);
+    }
+    for (; first != last; ++first) {
+        result = static_cast<lane_type>(result + static_cast<lane_type>(*first));
+    }
+    return static_cast<T>(result);
+}
+
+template<class T>
+T batch_sum(const T* first, const T* last, T init, std::false_type /*integral*/) {
+    // reordering a floating point sum changes the result, so keep the
+    // same order as the scalar sum.
+    for (; first != last; ++first) {
+        init = init + *first;
+    }
+    return init;
+}
+
+template<class T, class Select>
+T batch_select(const T* first, const T* last, Select select) {
+    T lanes[batch_lanes];
+    std::fill(lanes, lanes + batch_lanes, *first);
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    const T* body = first + (count - (count % batch_lanes));
+    for (; first != body; first += batch_lanes) {
+        for (std::size_t i = 0; i < batch_lanes; ++i) {
+            lanes[i] = select(lanes[i], first[i]);
+        }
+    }
+    T result = lanes[0];
+    for (std::size_t i = 1; i < batch_lanes; ++i) {
+        result = select(result, lanes[i]);
+    }
+    for (; first != last; ++first) {
+        result = select(result, *first);
+    }
+    return result;
+}
+
+template<class T>
+struct select_max {
+    T operator()(T a, T v) const {
+        return a < v ? v : a;
+    }
+};
+
+template<class T>
+struct select_min {
+    T operator()(T a, T v) const {
+        return v < a ? v : a;
+    }
+};
+
 template<class T>
 struct initialize_seeder {
     typedef T seed_type;
@@ -236,6 +488,56 @@ struct average {
         }
         return a;
     }
+    seed_type operator()(seed_type a, const T* first, const T* last) {
+        return batch(std::move(a), first, last, std::integral_constant<bool,
+            std::is_integral<T>::value && sizeof(T) < sizeof(long long)>());
+    }
+    seed_type batch(seed_type a, const T* first, const T* last, std::true_type) {
+        typedef typename std::conditional<std::is_signed<T>::value, long long, unsigned long long>::type wide_type;
+        const std::size_t count = static_cast<std::size_t>(last - first);
+        if (first != last && a.stage.empty() &&
+            count <= static_cast<std::size_t>(std::numeric_limits<int>::max() - a.count)) {
+            // the positive and negative parts bound every partial sum. when
+            // both fit in T the scalar path would never stage, so the wide
+            // sum gives exactly the same result.
+            wide_type positive = 0;
+            wide_type negative = 0;
+            if (!a.value.empty()) {
+                (*a.value > 0 ? positive : negative) = *a.value;
+            }
+            wide_type lanes_positive[batch_lanes] = {};
+            wide_type lanes_negative[batch_lanes] = {};
+            const T* cursor = first;
+            const T* body = first + (count - (count % batch_lanes));
+            for (; cursor != body; cursor += batch_lanes) {
+                for (std::size_t i = 0; i < batch_lanes; ++i) {
+                    lanes_positive[i] += cursor[i] > 0 ? cursor[i] : 0;
+                    lanes_negative[i] += cursor[i] > 0 ? 0 : cursor[i];
+                }
+            }
+            for (std::size_t i = 0; i < batch_lanes; ++i) {
+                positive += lanes_positive[i];
+                negative += lanes_negative[i];
+            }
+            for (; cursor != last; ++cursor) {
+                positive += *cursor > 0 ? *cursor : 0;
+                negative += *cursor > 0 ? 0 : *cursor;
+            }
+            if (positive <= static_cast<wide_type>(std::numeric_limits<T>::max()) &&
+                negative >= static_cast<wide_type>(std::numeric_limits<T>::min())) {
+                a.value.reset(static_cast<T>(positive + negative));
+                a.count += static_cast<int>(count);
+                return a;
+            }
+        }
+        return batch(std::move(a), first, last, std::false_type());
+    }
+    seed_type batch(seed_type a, const T* first, const T* last, std::false_type) {
+        for (; first != last; ++first) {
+            a = (*this)(std::move(a), *first);
+        }
+        return a;
+    }
     double operator()(seed_type a) {
         if (!a.value.empty()) {
             double avg = static_cast<double>(*(a.value)) / a.count;
@@ -262,6 +564,22 @@ struct sum {
             *a = *a + v;
         return a;
     }
+    seed_type operator()(seed_type a, const T* first, const T* last) const {
+        if (first == last)
+            return a;
+        if (a.empty())
+            a.reset(batch_sum(first + 1, last, *first, std::is_integral<T>()));
+        else
+            *a = batch_sum(first, last, *a, std::is_integral<T>());
+        return a;
+    }
+    seed_type operator()(seed_type a, const range_values<T>& r) const {
+        if (a.empty())
+            a.reset(r.sum);
+        else
+            *a = *a + r.sum;
+        return a;
+    }
     T operator()(seed_type a) const {
         if (a.empty())
             rxu::throw_exception(rxcpp::empty_error("sum() requires a stream with at least one value"));
@@ -281,6 +599,19 @@ struct max {
             a.reset(std::forward<U>(v));
         return a;
     }
+    seed_type operator()(seed_type a, const T* first, const T* last) {
+        if (first == last)
+            return a;
+        T v = batch_select(first, last, select_max<T>());
+        if (a.empty() || *a < v)
+            a.reset(std::move(v));
+        return a;
+    }
+    seed_type operator()(seed_type a, const range_values<T>& r) {
+        if (a.empty() || *a < r.highest)
+            a.reset(r.highest);
+        return a;
+    }
     T operator()(seed_type a) {
         if (a.empty())
             rxu::throw_exception(rxcpp::empty_error("max() requires a stream with at least one value"));
@@ -300,6 +631,19 @@ struct min {
             a.reset(std::forward<U>(v));
         return a;
     }
+    seed_type operator()(seed_type a, const T* first, const T* last) {
+        if (first == last)
+            return a;
+        T v = batch_select(first, last, select_min<T>());
+        if (a.empty() || v < *a)
+            a.reset(std::move(v));
+        return a;
+    }
+    seed_type operator()(seed_type a, const range_values<T>& r) {
+        if (a.empty() || r.lowest < *a)
+            a.reset(r.lowest);
+        return a;
+    }
     T operator()(seed_type a) {
         if (a.empty())
             rxu::throw_exception(rxcpp::empty_error("min() requires a stream with at least one value"));
@@ -582,6 +926,19 @@ struct member_overload<last_tag>
     }
 };
 
+/// blocking_observable sum, min and max use these to take the batch path.
+template<class T, class SourceOperator>
+auto blocking_batch_reducible(const observable<T, SourceOperator>&, sum_tag, int)
+    -> operators::detail::is_batch_reducible<observable<T, SourceOperator>, operators::detail::sum<T>, typename operators::detail::sum<T>::seed_type>;
+
+template<class T, class SourceOperator>
+auto blocking_batch_reducible(const observable<T, SourceOperator>&, max_tag, int)
+    -> operators::detail::is_batch_reducible<observable<T, SourceOperator>, operators::detail::max<T>, typename operators::detail::max<T>::seed_type>;
+
+template<class T, class SourceOperator>
+auto blocking_batch_reducible(const observable<T, SourceOperator>&, min_tag, int)
+    -> operators::detail::is_batch_reducible<observable<T, SourceOperator>, operators::detail::min<T>, typename operators::detail::min<T>::seed_type>;
+
 template<>
 struct member_overload<sum_tag>
 {
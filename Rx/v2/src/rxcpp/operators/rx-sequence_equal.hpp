@@ -12,10 +12,15 @@
 
     \param t     the other Observable that emits items to compare.
     \param pred  the function that implements comparison of two values (optional).
+    \param lag   max_lag(count) limits how many items one observable can be ahead of the other (optional).
     \param cn    the scheduler (optional).
 
     \return  Observable that emits true only if both sequences terminate normally after emitting the same sequence of items in the same order; otherwise it will emit false.
 
+    The items of the observable that is ahead are kept until the other observable emits the items to compare them to.
+    false is emitted as soon as the items differ, or one observable has completed and the other has emitted more items.
+    When max_lag is passed, sequence_lag_error is emitted if one observable gets more than count items ahead.
+
     \sample
     \snippet sequence_equal.cpp sequence_equal sample
     \snippet output.txt sequence_equal sample
@@ -28,8 +33,26 @@
 
 namespace rxcpp {
 
+class sequence_lag_error: public std::runtime_error
+{
+    public:
+        explicit sequence_lag_error(const std::string& msg):
+            std::runtime_error(msg)
+        {}
+};
+
 namespace operators {
 
+/// the number of items that one observable can be ahead of the other in sequence_equal
+struct max_lag
+{
+    explicit max_lag(std::size_t c)
+        : count(c)
+    {
+    }
+    std::size_t count;
+};
+
 namespace detail {
 
 template<class... AN>
@@ -54,11 +77,12 @@ struct sequence_equal : public operator_base<bool>
     typedef typename coordination_type::coordinator_type coordinator_type;
 
     struct values {
-        values(source_type s, other_source_type t, predicate_type pred, coordination_type sf)
+        values(source_type s, other_source_type t, predicate_type pred, coordination_type sf, std::size_t lag)
                 : source(std::move(s))
                 , other(std::move(t))
                 , pred(std::move(pred))
                 , coordination(std::move(sf))
+                , lag(lag)
         {
         }
 
@@ -66,12 +90,13 @@ struct sequence_equal : public operator_base<bool>
         other_source_type other;
         predicate_type pred;
         coordination_type coordination;
+        std::size_t lag;
     };
 
     values initial;
 
-    sequence_equal(source_type s, other_source_type t, predicate_type pred, coordination_type sf)
-        : initial(std::move(s), std::move(t), std::move(pred), std::move(sf))
+    sequence_equal(source_type s, other_source_type t, predicate_type pred, coordination_type sf, std::size_t lag = std::numeric_limits<std::size_t>::max())
+        : initial(std::move(s), std::move(t), std::move(pred), std::move(sf), lag)
     {
     }
 
@@ -88,6 +113,8 @@ struct sequence_equal : public operator_base<bool>
                 : values(vals)
                 , coordinator(std::move(coor))
                 , out(o)
+                , source_values(vals.lag)
+                , other_values(vals.lag)
                 , source_completed(false)
                 , other_completed(false)
             {
@@ -95,13 +122,24 @@ struct sequence_equal : public operator_base<bool>
                 out.add(source_lifetime);
             }
 
+            void finish(bool equal) {
+                out.on_next(equal);
+                out.on_completed();
+            }
+
+            void lagging() {
+                out.on_error(rxu::make_error_ptr(rxcpp::sequence_lag_error("sequence_equal max_lag exceeded")));
+            }
+
             composite_subscription other_lifetime;
             composite_subscription source_lifetime;
             coordinator_type coordinator;
             output_type out;
-            
-            mutable std::list<source_value_type> source_values;
-            mutable std::list<other_source_value_type> other_values;
+
+            // only the observable that is ahead has items waiting. the
+            // items are compared as soon as the other observable catches up.
+            mutable rxu::ring_buffer<source_value_type> source_values;
+            mutable rxu::ring_buffer<other_source_value_type> other_values;
             mutable bool source_completed;
             mutable bool other_completed;
         };
@@ -123,52 +161,36 @@ struct sequence_equal : public operator_base<bool>
             return;
         }
 
-        auto check_equal = [state]() {
-            if(!state->source_values.empty() && !state->other_values.empty()) {
-                auto x = std::move(state->source_values.front());
-                state->source_values.pop_front();
-
-                auto y = std::move(state->other_values.front());
-                state->other_values.pop_front();
-
-                if (!state->pred(x, y)) {
-                    state->out.on_next(false);
-                    state->out.on_completed();
-                }
-            } else {
-                if((!state->source_values.empty() && state->other_completed) ||
-                   (!state->other_values.empty() && state->source_completed)) {
-                    state->out.on_next(false);
-                    state->out.on_completed();
-                }
-            }
-        };
-        
-        auto check_complete = [state]() {
-            if(state->source_completed && state->other_completed) {
-                state->out.on_next(state->source_values.empty() && state->other_values.empty());
-                state->out.on_completed();
-            }
-        };
-
         auto sinkOther = make_subscriber<other_source_value_type>(
             state->out,
             state->other_lifetime,
             // on_next
-            [state, check_equal](other_source_value_type t) {
-                auto& values = state->other_values;
-                values.push_back(t);
-                check_equal();
+            [state](other_source_value_type t) {
+                if (!state->source_values.empty()) {
+                    auto x = state->source_values.pop_front();
+                    if (!state->pred(x, t)) {
+                        state->finish(false);
+                    }
+                } else if (state->source_completed) {
+                    state->finish(false);
+                } else if (state->other_values.full()) {
+                    state->lagging();
+                } else {
+                    state->other_values.push_back(std::move(t));
+                }
             },
             // on_error
             [state](rxu::error_ptr e) {
                 state->out.on_error(e);
             },
             // on_completed
-            [state, check_complete]() {
-                auto& completed = state->other_completed;
-                completed = true;
-                check_complete();
+            [state]() {
+                state->other_completed = true;
+                if (!state->source_values.empty()) {
+                    state->finish(false);
+                } else if (state->source_completed) {
+                    state->finish(state->other_values.empty());
+                }
             }
         );
 
@@ -183,20 +205,32 @@ struct sequence_equal : public operator_base<bool>
         source.get().subscribe(
             state->source_lifetime,
             // on_next
-            [state, check_equal](source_value_type t) {
-                auto& values = state->source_values;
-                values.push_back(t);
-                check_equal();
+            [state](source_value_type t) {
+                if (!state->other_values.empty()) {
+                    auto y = state->other_values.pop_front();
+                    if (!state->pred(t, y)) {
+                        state->finish(false);
+                    }
+                } else if (state->other_completed) {
+                    state->finish(false);
+                } else if (state->source_values.full()) {
+                    state->lagging();
+                } else {
+                    state->source_values.push_back(std::move(t));
+                }
             },
             // on_error
             [state](rxu::error_ptr e) {
                 state->out.on_error(e);
             },
             // on_completed
-            [state, check_complete]() {
-                auto& completed = state->source_completed;
-                completed = true;
-                check_complete();
+            [state]() {
+                state->source_completed = true;
+                if (!state->other_values.empty()) {
+                    state->finish(false);
+                } else if (state->other_completed) {
+                    state->finish(state->source_values.empty());
+                }
             }
         );        
     }
@@ -269,11 +303,63 @@ struct member_overload<sequence_equal_tag>
         return Result(SequenceEqual(std::forward<Observable>(o), std::forward<OtherObservable>(t), std::forward<BinaryPredicate>(pred), std::forward<Coordination>(cn)));
     }
 
+    template<class Observable, class OtherObservable,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_observable<OtherObservable>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class SequenceEqual = rxo::detail::sequence_equal<SourceValue, rxu::decay_t<Observable>, rxu::decay_t<OtherObservable>, rxu::equal_to<>, identity_one_worker>,
+        class Value = rxu::value_type_t<SequenceEqual>,
+        class Result = observable<Value, SequenceEqual>>
+    static Result member(Observable&& o, OtherObservable&& t, rxo::max_lag lag) {
+        return Result(SequenceEqual(std::forward<Observable>(o), std::forward<OtherObservable>(t), rxu::equal_to<>(), identity_current_thread(), lag.count));
+    }
+
+    template<class Observable, class OtherObservable, class BinaryPredicate,
+        class IsCoordination = is_coordination<BinaryPredicate>,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_observable<OtherObservable>,
+            rxu::negation<IsCoordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class SequenceEqual = rxo::detail::sequence_equal<SourceValue, rxu::decay_t<Observable>, rxu::decay_t<OtherObservable>, rxu::decay_t<BinaryPredicate>, identity_one_worker>,
+        class Value = rxu::value_type_t<SequenceEqual>,
+        class Result = observable<Value, SequenceEqual>>
+    static Result member(Observable&& o, OtherObservable&& t, BinaryPredicate&& pred, rxo::max_lag lag) {
+        return Result(SequenceEqual(std::forward<Observable>(o), std::forward<OtherObservable>(t), std::forward<BinaryPredicate>(pred), identity_current_thread(), lag.count));
+    }
+
+    template<class Observable, class OtherObservable, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_observable<OtherObservable>,
+            is_coordination<Coordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class SequenceEqual = rxo::detail::sequence_equal<SourceValue, rxu::decay_t<Observable>, rxu::decay_t<OtherObservable>, rxu::equal_to<>, rxu::decay_t<Coordination>>,
+        class Value = rxu::value_type_t<SequenceEqual>,
+        class Result = observable<Value, SequenceEqual>>
+    static Result member(Observable&& o, OtherObservable&& t, rxo::max_lag lag, Coordination&& cn) {
+        return Result(SequenceEqual(std::forward<Observable>(o), std::forward<OtherObservable>(t), rxu::equal_to<>(), std::forward<Coordination>(cn), lag.count));
+    }
+
+    template<class Observable, class OtherObservable, class BinaryPredicate, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_observable<OtherObservable>,
+            is_coordination<Coordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class SequenceEqual = rxo::detail::sequence_equal<SourceValue, rxu::decay_t<Observable>, rxu::decay_t<OtherObservable>, rxu::decay_t<BinaryPredicate>, rxu::decay_t<Coordination>>,
+        class Value = rxu::value_type_t<SequenceEqual>,
+        class Result = observable<Value, SequenceEqual>>
+    static Result member(Observable&& o, OtherObservable&& t, BinaryPredicate&& pred, rxo::max_lag lag, Coordination&& cn) {
+        return Result(SequenceEqual(std::forward<Observable>(o), std::forward<OtherObservable>(t), std::forward<BinaryPredicate>(pred), std::forward<Coordination>(cn), lag.count));
+    }
+
     template<class... AN>
     static operators::detail::sequence_equal_invalid_t<AN...> member(const AN&...) {
         std::terminate();
         return {};
-        static_assert(sizeof...(AN) == 10000, "sequence_equal takes (OtherObservable, optional BinaryPredicate, optional Coordination)");
+        static_assert(sizeof...(AN) == 10000, "sequence_equal takes (OtherObservable, optional BinaryPredicate, optional max_lag, optional Coordination)");
     }
 };
 
@@ -88,17 +88,25 @@ struct switch_on_next
             switch_state_type(values i, coordinator_type coor, output_type oarg)
                 : values(i)
                 , source(i.source_operator)
-                , pendingCompletions(0)
+                , generation(0)
+                , outerCompleted(false)
+                , innerActive(false)
                 , coordinator(std::move(coor))
                 , out(std::move(oarg))
             {
             }
             observable<source_value_type, source_operator_type> source;
-            // on_completed on the output must wait until all the
-            // subscriptions have received on_completed
-            int pendingCompletions;
+            // identifies the current inner. callbacks from an inner that
+            // has been replaced are dropped.
+            std::uint64_t generation;
+            // on_completed on the output must wait until the source and
+            // the current inner have received on_completed
+            bool outerCompleted;
+            bool innerActive;
             coordinator_type coordinator;
-            composite_subscription inner_lifetime;
+            // holds the current inner subscription. it is added to out
+            // once and cleared, rather than replaced, on each switch.
+            composite_subscription inner_slot;
             output_type out;
         };
 
@@ -112,6 +120,7 @@ struct switch_on_next
         // when the out observer is unsubscribed all the
         // inner subscriptions are unsubscribed as well
         state->out.add(outercs);
+        state->out.add(state->inner_slot);
 
         auto source = on_exception(
             [&](){return state->coordinator.in(state->source);},
@@ -120,7 +129,6 @@ struct switch_on_next
             return;
         }
 
-        ++state->pendingCompletions;
         // this subscribe does not share the observer subscription
         // so that when it is unsubscribed the observer can be called
         // until the inner subscriptions have finished
@@ -130,18 +138,14 @@ struct switch_on_next
         // on_next
             [state](collection_type st) {
 
-                state->inner_lifetime.unsubscribe();
+                // unsubscribe the previous inner
+                state->inner_slot.clear();
 
-                state->inner_lifetime = composite_subscription();
+                auto generation = ++state->generation;
+                state->innerActive = true;
 
-                // when the out observer is unsubscribed all the
-                // inner subscriptions are unsubscribed as well
-                auto innerlifetimetoken = state->out.add(state->inner_lifetime);
-
-                state->inner_lifetime.add(make_subscription([state, innerlifetimetoken](){
-                    state->out.remove(innerlifetimetoken);
-                    --state->pendingCompletions;
-                }));
+                composite_subscription inner_lifetime;
+                state->inner_slot.add(inner_lifetime);
 
                 auto selectedSource = state->coordinator.in(st);
 
@@ -149,25 +153,33 @@ struct switch_on_next
                 // so that when it is unsubscribed the source will continue
                 auto sinkInner = make_subscriber<collection_value_type>(
                     state->out,
-                    state->inner_lifetime,
+                    std::move(inner_lifetime),
                 // on_next
-                    [state, st](collection_value_type ct) {
-                        state->out.on_next(std::move(ct));
+                    [state, generation](collection_value_type ct) {
+                        if (generation == state->generation) {
+                            state->out.on_next(std::move(ct));
+                        }
                     },
                 // on_error
-                    [state](rxu::error_ptr e) {
-                        state->out.on_error(e);
+                    [state, generation](rxu::error_ptr e) {
+                        if (generation == state->generation) {
+                            state->out.on_error(e);
+                        }
                     },
                 //on_completed
-                    [state](){
-                        if (state->pendingCompletions == 1) {
-                            state->out.on_completed();
+                    [state, generation](){
+                        if (generation == state->generation) {
+                            // drop anything the completed inner sends later
+                            ++state->generation;
+                            state->innerActive = false;
+                            if (state->outerCompleted) {
+                                state->out.on_completed();
+                            }
                         }
                     }
                 );
 
                 auto selectedSinkInner = state->coordinator.out(sinkInner);
-                ++state->pendingCompletions;
                 selectedSource.subscribe(std::move(selectedSinkInner));
             },
         // on_error
@@ -176,7 +188,8 @@ struct switch_on_next
             },
         // on_completed
             [state]() {
-                if (--state->pendingCompletions == 0) {
+                state->outerCompleted = true;
+                if (!state->innerActive) {
                     state->out.on_completed();
                 }
             }
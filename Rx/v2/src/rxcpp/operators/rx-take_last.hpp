@@ -44,7 +44,7 @@ struct take_last : public operator_base<T>
     typedef rxu::decay_t<Observable> source_type;
     typedef rxu::decay_t<Count> count_type;
 
-    typedef std::queue<T> queue_type;
+    typedef rxu::ring_buffer<T> queue_type;
     typedef typename queue_type::size_type queue_size_type;
 
     struct values
@@ -74,6 +74,7 @@ struct take_last : public operator_base<T>
         {
             state_type(const values& i, const output_type& oarg)
                 : values(i)
+                , items(i.count)
                 , out(oarg)
             {
             }
@@ -93,10 +94,11 @@ struct take_last : public operator_base<T>
         // on_next
             [state, source_lifetime](T t) {
                 if(state->count > 0) {
-                    if (state->items.size() == state->count) {
-                        state->items.pop();
+                    if (state->items.full()) {
+                        state->items.overwrite(std::move(t));
+                    } else {
+                        state->items.push_back(std::move(t));
                     }
-                    state->items.push(t);
                 }
             },
         // on_error
@@ -105,11 +107,11 @@ struct take_last : public operator_base<T>
             },
         // on_completed
             [state]() {
-                while(!state->items.empty()) {
-                    state->out.on_next(std::move(state->items.front()));
-                    state->items.pop();
-                }
-                state->out.on_completed();
+                auto& out = state->out;
+                state->items.drain([&out](T&& t){
+                    out.on_next(std::move(t));
+                });
+                out.on_completed();
             }
         );
     }
@@ -0,0 +1,243 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-tap_record.hpp
+
+    \brief Writes each notification of the source observable to a log file and passes it on unchanged.
+
+    \tparam Serializer    the type of the serializer for the values (optional).
+    \tparam Coordination  the type of the scheduler whose clock is recorded (optional).
+
+    \param path          the file to write. each subscription replaces the file with a new log.
+    \param serializer    converts each value to bytes, rxn::binary_serializer<T> by default (optional).
+    \param coordination  the scheduler whose clock timestamps the notifications (optional).
+
+    \return  Observable that emits the same notifications as the source observable.
+
+    The time of each notification is recorded in nanoseconds since the subscription. The records are
+    written in chunks with one write each, so the log of a process that stops early ends with whole
+    chunks. Errors are recorded as the text of the exception. rxs::replay_log() plays the log back.
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_TAP_RECORD_HPP)
+#define RXCPP_OPERATORS_RX_TAP_RECORD_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct tap_record_invalid_arguments {};
+
+template<class... AN>
+struct tap_record_invalid : public rxo::operator_base<tap_record_invalid_arguments<AN...>> {
+    using type = observable<tap_record_invalid_arguments<AN...>, tap_record_invalid<AN...>>;
+};
+template<class... AN>
+using tap_record_invalid_t = typename tap_record_invalid<AN...>::type;
+
+template<class T, class Serializer, class Coordination>
+struct tap_record
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Serializer> serializer_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef rxsc::scheduler::clock_type::time_point time_point;
+
+    struct tap_record_values {
+        tap_record_values(std::string p, serializer_type s, coordination_type c)
+            : path(std::move(p))
+            , serializer(std::move(s))
+            , coordination(std::move(c))
+        {
+        }
+
+        std::string path;
+        serializer_type serializer;
+        coordination_type coordination;
+    };
+    tap_record_values initial;
+
+    tap_record(std::string path, serializer_type serializer, coordination_type coordination)
+        : initial(std::move(path), std::move(serializer), std::move(coordination))
+    {
+    }
+
+    struct tap_record_state
+    {
+        tap_record_state(const std::string& path, time_point start)
+            : log(path)
+            , start(start)
+        {
+        }
+        rxn::log_writer log;
+        time_point start;
+    };
+
+    template<class Subscriber>
+    struct tap_record_observer
+    {
+        typedef tap_record_observer<Subscriber> this_type;
+        typedef source_value_type value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<value_type, this_type> observer_type;
+        dest_type dest;
+        tap_record_values values;
+        std::shared_ptr<tap_record_state> state;
+
+        tap_record_observer(dest_type d, tap_record_values v, std::shared_ptr<tap_record_state> s)
+            : dest(std::move(d))
+            , values(std::move(v))
+            , state(std::move(s))
+        {
+        }
+
+        int64_t now() const {
+            return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(values.coordination.now() - state->start).count());
+        }
+
+        void on_next(source_value_type v) const {
+            // a log that cannot be written ends the stream with the error
+            auto written = on_exception(
+                [&](){
+                    std::string bytes;
+                    values.serializer.serialize(v, bytes);
+                    state->log.write(now(), rxn::notification_kind::on_next, bytes.data(), bytes.size());
+                    return true;
+                },
+                dest);
+            if (written.empty()) {
+                return;
+            }
+            dest.on_next(std::move(v));
+        }
+        void on_error(rxu::error_ptr e) const {
+            // the source error is passed on even when it cannot be logged
+            RXCPP_TRY {
+                auto what = rxu::what(e);
+                state->log.write(now(), rxn::notification_kind::on_error, what.data(), what.size());
+                state->log.close();
+            } RXCPP_CATCH(...) {
+            }
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            auto written = on_exception(
+                [&](){
+                    state->log.write(now(), rxn::notification_kind::on_completed, nullptr, 0);
+                    state->log.close();
+                    return true;
+                },
+                dest);
+            if (written.empty()) {
+                return;
+            }
+            dest.on_completed();
+        }
+
+        static subscriber<value_type, observer_type> make(dest_type d, tap_record_values v) {
+            // a log that cannot be opened is sent to on_error. that unsubscribes d, which
+            // the returned subscriber shares, so the source never calls the empty state.
+            auto state = on_exception(
+                [&](){return std::make_shared<tap_record_state>(v.path, v.coordination.now());},
+                d);
+            if (state.empty()) {
+                return make_subscriber<value_type>(d, this_type(d, std::move(v), nullptr));
+            }
+            auto log = state.get();
+            // write the last chunk when the subscription ends without a notification
+            d.add([log](){
+                RXCPP_TRY {
+                    log->log.close();
+                } RXCPP_CATCH(...) {
+                }
+            });
+            return make_subscriber<value_type>(d, this_type(d, std::move(v), std::move(log)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(tap_record_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      tap_record_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+}
+
+/*! @copydoc rx-tap_record.hpp
+*/
+template<class... AN>
+auto tap_record(AN&&... an)
+    ->      operator_factory<tap_record_tag, AN...> {
+     return operator_factory<tap_record_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<tap_record_tag>
+{
+    template<class Observable, class Path,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            std::is_convertible<Path, std::string>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class TapRecord = rxo::detail::tap_record<SourceValue, rxn::binary_serializer<SourceValue>, identity_one_worker>>
+    static auto member(Observable&& o, Path&& path)
+        -> decltype(o.template lift<SourceValue>(TapRecord(std::forward<Path>(path), rxn::binary_serializer<SourceValue>(), identity_current_thread()))) {
+        return      o.template lift<SourceValue>(TapRecord(std::forward<Path>(path), rxn::binary_serializer<SourceValue>(), identity_current_thread()));
+    }
+
+    template<class Observable, class Path, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            std::is_convertible<Path, std::string>,
+            is_coordination<Coordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class TapRecord = rxo::detail::tap_record<SourceValue, rxn::binary_serializer<SourceValue>, rxu::decay_t<Coordination>>>
+    static auto member(Observable&& o, Path&& path, Coordination&& cn)
+        -> decltype(o.template lift<SourceValue>(TapRecord(std::forward<Path>(path), rxn::binary_serializer<SourceValue>(), std::forward<Coordination>(cn)))) {
+        return      o.template lift<SourceValue>(TapRecord(std::forward<Path>(path), rxn::binary_serializer<SourceValue>(), std::forward<Coordination>(cn)));
+    }
+
+    template<class Observable, class Path, class Serializer,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            std::is_convertible<Path, std::string>,
+            rxu::negation<is_coordination<Serializer>>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class TapRecord = rxo::detail::tap_record<SourceValue, rxu::decay_t<Serializer>, identity_one_worker>>
+    static auto member(Observable&& o, Path&& path, Serializer&& s)
+        -> decltype(o.template lift<SourceValue>(TapRecord(std::forward<Path>(path), std::forward<Serializer>(s), identity_current_thread()))) {
+        return      o.template lift<SourceValue>(TapRecord(std::forward<Path>(path), std::forward<Serializer>(s), identity_current_thread()));
+    }
+
+    template<class Observable, class Path, class Serializer, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            std::is_convertible<Path, std::string>,
+            is_coordination<Coordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class TapRecord = rxo::detail::tap_record<SourceValue, rxu::decay_t<Serializer>, rxu::decay_t<Coordination>>>
+    static auto member(Observable&& o, Path&& path, Serializer&& s, Coordination&& cn)
+        -> decltype(o.template lift<SourceValue>(TapRecord(std::forward<Path>(path), std::forward<Serializer>(s), std::forward<Coordination>(cn)))) {
+        return      o.template lift<SourceValue>(TapRecord(std::forward<Path>(path), std::forward<Serializer>(s), std::forward<Coordination>(cn)));
+    }
+
+    template<class... AN>
+    static operators::detail::tap_record_invalid_t<AN...> member(AN...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "tap_record takes (path, optional Serializer, optional Coordination)");
+    }
+};
+
+}
+
+#endif
@@ -76,14 +76,14 @@ struct window
         typedef observer<T, this_type> observer_type;
         dest_type dest;
         mutable int cursor;
-        mutable std::deque<rxcpp::subjects::subject<T>> subj;
+        mutable std::deque<rxcpp::subjects::window_subject<T>> subj;
 
         window_observer(dest_type d, window_values v)
             : window_values(v)
             , dest(std::move(d))
             , cursor(0)
         {
-            subj.push_back(rxcpp::subjects::subject<T>());
+            subj.push_back(rxcpp::subjects::window_subject<T>());
             dest.on_next(subj[0].get_observable().as_dynamic());
         }
         void on_next(T v) const {
@@ -98,7 +98,7 @@ struct window
             }
 
             if (++cursor % this->skip == 0) {
-                subj.push_back(rxcpp::subjects::subject<T>());
+                subj.push_back(rxcpp::subjects::window_subject<T>());
                 dest.on_next(subj[subj.size() - 1].get_observable().as_dynamic());
             }
         }
@@ -106,7 +106,7 @@ struct window_with_time
             dest_type dest;
             coordinator_type coordinator;
             rxsc::worker worker;
-            mutable std::deque<rxcpp::subjects::subject<T>> subj;
+            mutable std::deque<rxcpp::subjects::window_subject<T>> subj;
             rxsc::scheduler::clock_type::time_point expected;
         };
         std::shared_ptr<window_with_time_subscriber_values> state;
@@ -155,7 +155,7 @@ struct window_with_time
             }
 
             auto create_window = [localState, selectedRelease](const rxsc::schedulable&) {
-                localState->subj.push_back(rxcpp::subjects::subject<T>());
+                localState->subj.push_back(rxcpp::subjects::window_subject<T>());
                 localState->dest.on_next(localState->subj[localState->subj.size() - 1].get_observable().as_dynamic());
 
                 auto produce_at = localState->expected + localState->period;
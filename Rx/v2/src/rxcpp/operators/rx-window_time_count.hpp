@@ -99,7 +99,7 @@ struct window_with_time_or_count
             rxsc::worker worker;
             mutable int cursor;
             mutable int subj_id;
-            mutable rxcpp::subjects::subject<T> subj;
+            mutable rxcpp::subjects::window_subject<T> subj;
         };
         typedef std::shared_ptr<window_with_time_or_count_subscriber_values> state_type;
         state_type state;
@@ -147,7 +147,7 @@ struct window_with_time_or_count
                     return;
 
                 state->subj.get_subscriber().on_completed();
-                state->subj = rxcpp::subjects::subject<T>();
+                state->subj = rxcpp::subjects::window_subject<T>();
                 state->dest.on_next(state->subj.get_observable().as_dynamic());
                 state->cursor = 0;
                 auto new_id = ++state->subj_id;
@@ -101,7 +101,7 @@ struct window_toggle
             dest_type dest;
             coordinator_type coordinator;
             rxsc::worker worker;
-            mutable std::list<rxcpp::subjects::subject<T>> subj;
+            mutable std::list<rxcpp::subjects::window_subject<T>> subj;
         };
         std::shared_ptr<window_toggle_subscriber_values> state;
 
@@ -139,7 +139,7 @@ struct window_toggle
                 [localState](const openings_value_type& ov) {
                     auto closer = localState->closingSelector(ov);
 
-                    auto it = localState->subj.insert(localState->subj.end(), rxcpp::subjects::subject<T>());
+                    auto it = localState->subj.insert(localState->subj.end(), rxcpp::subjects::window_subject<T>());
                     localState->dest.on_next(it->get_observable().as_dynamic());
 
                     composite_subscription innercs;
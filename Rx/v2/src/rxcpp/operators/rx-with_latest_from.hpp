@@ -62,7 +62,10 @@ struct is_with_latest_from_selector_check {
 
     struct tag_not_valid;
     template<class CS, class... CON>
-    static auto check(int) -> decltype((*(CS*)nullptr)((*(typename CON::value_type*)nullptr)...));
+    static auto check(int) -> decltype((*(CS*)nullptr)((*(const typename CON::value_type*)nullptr)...));
+    // selectors that take non-const references are called with copies
+    template<class CS, class... CON>
+    static auto check(long) -> decltype((*(CS*)nullptr)((*(typename CON::value_type*)nullptr)...));
     template<class CS, class... CON>
     static tag_not_valid check(...);
 
@@ -164,12 +167,11 @@ struct with_latest_from : public operator_base<rxu::value_type_t<with_latest_fro
                     ++state->valuesSet;
                 }
 
-                value.reset(st);
+                value.reset(std::move(st));
 
                 if (state->valuesSet == sizeof... (ObservableN) && Index == 0) {
-                    auto values = rxu::surely(state->latest);
-                    auto selectedResult = rxu::apply(values, state->selector);
-                    state->out.on_next(selectedResult);
+                    // the selector reads the latest values in place
+                    state->out.on_next(rxu::apply_surely(state->latest, state->selector));
                 }
             },
         // on_error
@@ -53,19 +53,19 @@ private:
     template<class Observable>
     struct get_observable
     {
-        typedef decltype((*(input_type*)nullptr).in((*(Observable*)nullptr))) type;
+        typedef decltype(std::declval<input_type&>().in(std::declval<Observable&>())) type;
     };
 
     template<class Subscriber>
     struct get_subscriber
     {
-        typedef decltype((*(input_type*)nullptr).out((*(Subscriber*)nullptr))) type;
+        typedef decltype(std::declval<input_type&>().out(std::declval<Subscriber&>())) type;
     };
 
     template<class F>
     struct get_action_function
     {
-        typedef decltype((*(input_type*)nullptr).act((*(F*)nullptr))) type;
+        typedef decltype(std::declval<input_type&>().act(std::declval<F&>())) type;
     };
 
 public:
@@ -181,6 +181,13 @@ inline identity_one_worker identity_same_worker(rxsc::worker w) {
     return identity_one_worker(rxsc::make_same_worker(w));
 }
 
+/// all the timers scheduled through the same coalesced coordination are
+/// rounded up to the next tick of the granularity and fired in batches
+/// from a single worker of the scheduler.
+inline identity_one_worker identity_coalesced(rxsc::scheduler sc, rxsc::scheduler::clock_type::duration granularity) {
+    return identity_one_worker(rxsc::make_coalescing(std::move(sc), granularity));
+}
+
 class serialize_one_worker : public coordination_base
 {
     rxsc::scheduler factory;
@@ -311,6 +318,10 @@ inline serialize_one_worker serialize_same_worker(rxsc::worker w) {
     return serialize_one_worker(rxsc::make_same_worker(w));
 }
 
+inline serialize_one_worker serialize_coalesced(rxsc::scheduler sc, rxsc::scheduler::clock_type::duration granularity) {
+    return serialize_one_worker(rxsc::make_coalescing(std::move(sc), granularity));
+}
+
 }
 
 #endif
@@ -4,7 +4,30 @@
 
 /*! \file rx-coroutine.hpp
 
-    \brief The proposal to add couroutines to the standard adds `co_await`, `for co_await`, `co_yield` and `co_return`. This file adds `begin(observable<>)` & `end(observable<>)` which enables `for co_await` to work with the `observable<>` type.
+    \brief Adds support for coroutines to the `observable<>` type.
+
+    With C++20 coroutines (`<coroutine>`), an observable can be awaited for its last value, a
+    coroutine that uses `co_yield` can be subscribed as an observable, and the values of an
+    observable can be iterated through a buffer.
+
+    auto value = co_await interval(seconds(1), observe_on_event_loop()).first();
+
+    auto values = co_await rxcpp::coroutine::to_vector(range(1, 3));
+
+    auto yields = rxcpp::coroutine::from_generator([]() -> rxcpp::coroutine::async_generator<int> {
+        for (int i = 0; i < 3; ++i) {
+            co_yield i;
+        }
+    });
+
+    for (auto it = co_await rxcpp::coroutine::begin(yields, 64); it != rxcpp::coroutine::end(yields); co_await ++it) {
+        printf("%d\n", *it);
+    }
+
+    With the proposal to add couroutines to the standard (`_RESUMABLE_FUNCTIONS_SUPPORTED`), which
+    adds `co_await`, `for co_await`, `co_yield` and `co_return`, this file adds
+    `begin(observable<>)` & `end(observable<>)` which enables `for co_await` to work with the
+    `observable<>` type.
 
     for co_await (auto c : interval(seconds(1), observe_on_event_loop()) | take(3)) {
         printf("%d\n", c);
@@ -17,7 +40,631 @@
 
 #include "rx-includes.hpp"
 
-#ifdef _RESUMABLE_FUNCTIONS_SUPPORTED
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define RXCPP_USE_STD_COROUTINES 1
+#endif
+#endif
+
+#if defined(RXCPP_FORCE_USE_STD_COROUTINES)
+#undef RXCPP_USE_STD_COROUTINES
+#define RXCPP_USE_STD_COROUTINES RXCPP_FORCE_USE_STD_COROUTINES
+#endif
+
+#if RXCPP_USE_STD_COROUTINES
+
+#include <coroutine>
+
+namespace rxcpp {
+namespace coroutine {
+
+namespace detail {
+
+// receives the values of an awaited observable and produces the result of co_await.
+template<class T>
+struct co_last_value
+{
+    typedef T result_type;
+
+    void on_next(T v) {
+        value.reset(std::move(v));
+    }
+    T result() {
+        if (value.empty()) {
+            rxu::throw_exception(rxcpp::empty_error("co_await requires a stream with at least one value"));
+        }
+        return std::move(value.get());
+    }
+
+    rxu::maybe<T> value;
+};
+
+template<class T>
+struct co_vector_values
+{
+    typedef std::vector<T> result_type;
+
+    void on_next(T v) {
+        values.push_back(std::move(v));
+    }
+    std::vector<T> result() {
+        return std::move(values);
+    }
+
+    std::vector<T> values;
+};
+
+template<class Collector>
+struct co_await_state
+{
+    enum phase_type {
+        subscribing,
+        suspended,
+        finished,
+        cancelled
+    };
+
+    co_await_state()
+        : phase(subscribing)
+        , destroy_on_cancel(false)
+    {
+    }
+
+    // resumes the caller, unless the source finished before await_suspend
+    // returned, in which case the caller is not suspended at all.
+    void finish() {
+        if (set_phase(finished) == suspended) {
+            caller.resume();
+        }
+    }
+
+    // the subscription was cancelled before the source finished. the
+    // caller is destroyed, since it will never be resumed.
+    void cancel() {
+        if (set_phase(cancelled) == suspended) {
+            caller.destroy();
+        }
+    }
+
+    // moves from subscribing or suspended to a final phase. returns the
+    // phase that was replaced, or the final phase that was already set.
+    int set_phase(int next) {
+        int current = phase.load();
+        while (current < finished && !phase.compare_exchange_weak(current, next))
+            ;
+        return current;
+    }
+
+    Collector collector;
+    rxu::error_ptr error;
+    std::atomic<int> phase;
+    bool destroy_on_cancel;
+    std::coroutine_handle<> caller;
+    composite_subscription lifetime;
+};
+
+template<class Source, class Collector>
+struct co_observable_awaiter
+{
+    typedef co_await_state<Collector> state_type;
+    typedef typename Collector::result_type result_type;
+    typedef typename Source::value_type value_type;
+
+    explicit co_observable_awaiter(Source o)
+        : source(std::move(o))
+        , state(std::make_shared<state_type>())
+    {
+    }
+    // the source is unsubscribed when the cancel subscription is
+    // unsubscribed, and then the caller is destroyed.
+    co_observable_awaiter(Source o, const composite_subscription& cancel)
+        : co_observable_awaiter(std::move(o))
+    {
+        state->destroy_on_cancel = true;
+        auto token = cancel.add(state->lifetime);
+        // cancel outlives many awaits, so do not leave this one in it
+        state->lifetime.add([cancel, token](){
+            cancel.remove(token);
+        });
+    }
+    co_observable_awaiter(co_observable_awaiter&&)=default;
+
+    ~co_observable_awaiter() {
+        if (!!state) {
+            state->lifetime.unsubscribe();
+        }
+    }
+
+    bool await_ready() {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> caller) {
+        auto st = state;
+        st->caller = caller;
+        if (st->destroy_on_cancel) {
+            std::weak_ptr<state_type> wst = st;
+            st->lifetime.add([wst](){
+                if (auto s = wst.lock()) {
+                    s->cancel();
+                }
+            });
+        }
+        source.subscribe(
+            st->lifetime,
+        // on_next
+            [st](value_type v){
+                st->collector.on_next(std::move(v));
+            },
+        // on_error
+            [st](rxu::error_ptr e){
+                st->error = e;
+                st->finish();
+            },
+        // on_completed
+            [st](){
+                st->finish();
+            });
+        int current = state_type::subscribing;
+        if (st->phase.compare_exchange_strong(current, state_type::suspended)) {
+            return true;
+        }
+        if (current == state_type::cancelled) {
+            caller.destroy();
+            return true;
+        }
+        // finished during subscribe
+        return false;
+    }
+
+    result_type await_resume() {
+        if (!!state->error) {
+            rxu::rethrow_exception(state->error);
+        }
+        return state->collector.result();
+    }
+
+    Source source;
+    std::shared_ptr<state_type> state;
+};
+
+}
+
+/*! \brief awaits the values of an observable as a std::vector.
+
+    \code
+    auto values = co_await rxcpp::coroutine::to_vector(range(1, 3));
+    \endcode
+*/
+template<class T, class SourceOperator>
+auto to_vector(const observable<T, SourceOperator>& o)
+    ->      detail::co_observable_awaiter<observable<T, SourceOperator>, detail::co_vector_values<T>> {
+    return  detail::co_observable_awaiter<observable<T, SourceOperator>, detail::co_vector_values<T>>(o);
+}
+
+/*! \brief a coroutine that produces the values of an observable with `co_yield`.
+
+    Each `co_yield` sends the value to the subscriber directly, so the coroutine is not suspended
+    for each value. `co_return`, or the end of the coroutine, completes the observable and an
+    exception that leaves the coroutine is sent with `on_error`.
+
+    When the subscriber is unsubscribed, the coroutine is destroyed at the next `co_yield`, or
+    when it is suspended in `co_await` on an observable.
+
+    \see from_generator
+*/
+template<class T>
+class async_generator
+{
+public:
+    struct promise_type;
+    typedef T value_type;
+    typedef std::coroutine_handle<promise_type> handle_type;
+
+    struct yield_awaiter
+    {
+        bool unsubscribed;
+
+        bool await_ready() {
+            return !unsubscribed;
+        }
+        void await_suspend(std::coroutine_handle<> self) {
+            self.destroy();
+        }
+        void await_resume() {}
+    };
+
+    struct promise_type
+    {
+        async_generator get_return_object() {
+            return async_generator(handle_type::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+        // the coroutine frame is destroyed when the coroutine finishes
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+
+        yield_awaiter yield_value(T v) {
+            auto& o = out.get();
+            if (o.is_subscribed()) {
+                o.on_next(std::move(v));
+            }
+            return yield_awaiter{!o.is_subscribed()};
+        }
+
+        void return_void() {
+            out.get().on_completed();
+        }
+        void unhandled_exception() {
+            out.get().on_error(rxu::current_exception());
+        }
+
+        template<class U, class SourceOperator>
+        auto await_transform(const observable<U, SourceOperator>& o)
+            ->      detail::co_observable_awaiter<observable<U, SourceOperator>, detail::co_last_value<U>> {
+            return  detail::co_observable_awaiter<observable<U, SourceOperator>, detail::co_last_value<U>>(o, out.get().get_subscription());
+        }
+        template<class Awaitable, class Enabled = rxu::enable_if_all_true_type_t<
+            rxu::negation<is_observable<Awaitable>>>>
+        Awaitable&& await_transform(Awaitable&& a) {
+            return std::forward<Awaitable>(a);
+        }
+
+        rxu::maybe<subscriber<T>> out;
+    };
+
+    async_generator(async_generator&& o)
+        : coroutine(o.coroutine)
+    {
+        o.coroutine = nullptr;
+    }
+    async_generator& operator=(async_generator o) {
+        std::swap(coroutine, o.coroutine);
+        return *this;
+    }
+    ~async_generator() {
+        if (!!coroutine) {
+            coroutine.destroy();
+        }
+    }
+
+    /// runs the coroutine until it is first suspended. from here the coroutine owns its frame.
+    void start(subscriber<T> o) {
+        auto self = coroutine;
+        coroutine = nullptr;
+        self.promise().out.reset(std::move(o));
+        self.resume();
+    }
+
+private:
+    explicit async_generator(handle_type h)
+        : coroutine(h)
+    {
+    }
+
+    handle_type coroutine;
+};
+
+/*! \brief Returns an observable that calls the coroutine function \a f for each subscriber and sends the values that it yields.
+
+    \code
+    auto values = rxcpp::coroutine::from_generator([]() -> rxcpp::coroutine::async_generator<int> {
+        for (int i = 0; i < 3; ++i) {
+            co_yield i;
+        }
+    });
+    \endcode
+*/
+template<class F>
+auto from_generator(F f)
+    -> observable<typename rxu::decay_t<decltype(f())>::value_type> {
+    typedef typename rxu::decay_t<decltype(f())>::value_type value_type;
+    return rxcpp::sources::create<value_type>([f](subscriber<value_type> o){
+        // the coroutine refers to the captures of its function, so the
+        // function is kept until the subscriber is unsubscribed.
+        auto function = std::make_shared<F>(f);
+        o.add([function](){});
+        (*function)().start(std::move(o));
+    }).as_dynamic();
+}
+
+namespace detail {
+
+template<class T>
+struct co_buffer_state
+{
+    explicit co_buffer_state(std::size_t capacity)
+        : capacity(capacity == 0 ? 1 : capacity)
+        , subscribing(false)
+        , done(false)
+    {
+    }
+
+    // moves the next value into current. returns false when the
+    // consumer must wait for the producer.
+    bool take() {
+        if (!buffer.empty()) {
+            current.reset(std::move(buffer.front()));
+            buffer.pop_front();
+            space.notify_one();
+            return true;
+        }
+        if (done) {
+            current.reset();
+            return true;
+        }
+        return false;
+    }
+
+    // the caller holds the lock. the waiting consumer is resumed for each
+    // value, except while the source is sending values during subscribe,
+    // when it is only resumed once the buffer is full.
+    void resume_consumer(std::unique_lock<std::mutex>& guard, bool filled) {
+        if (!waiting || (subscribing && !filled)) {
+            return;
+        }
+        auto consumer = waiting;
+        waiting = nullptr;
+        consumer_thread = std::this_thread::get_id();
+        guard.unlock();
+        consumer.resume();
+    }
+
+    void on_next(T v) {
+        std::unique_lock<std::mutex> guard(lock);
+        // the producer waits while the buffer is full, unless it is
+        // running on the thread where the consumer last ran.
+        if (buffer.size() >= capacity && !waiting && consumer_thread != std::this_thread::get_id()) {
+            space.wait(guard, [this](){
+                return buffer.size() < capacity || !!waiting || !lifetime.is_subscribed();
+            });
+        }
+        if (!lifetime.is_subscribed()) {
+            return;
+        }
+        buffer.push_back(std::move(v));
+        resume_consumer(guard, buffer.size() >= capacity);
+    }
+
+    void on_finish(rxu::error_ptr e) {
+        std::unique_lock<std::mutex> guard(lock);
+        error = e;
+        done = true;
+        resume_consumer(guard, true);
+    }
+
+    std::mutex lock;
+    std::condition_variable space;
+    std::deque<T> buffer;
+    std::size_t capacity;
+    bool subscribing;
+    bool done;
+    rxu::error_ptr error;
+    rxu::maybe<T> current;
+    std::coroutine_handle<> waiting;
+    std::thread::id consumer_thread;
+    composite_subscription lifetime;
+};
+
+// cancels the subscription when the last copy of an iterator is destroyed
+template<class T>
+struct co_buffer_owner
+{
+    explicit co_buffer_owner(std::size_t capacity)
+        : state(std::make_shared<co_buffer_state<T>>(capacity))
+    {
+    }
+    ~co_buffer_owner() {
+        {
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->waiting = nullptr;
+            state->space.notify_all();
+        }
+        state->lifetime.unsubscribe();
+    }
+    std::shared_ptr<co_buffer_state<T>> state;
+};
+
+}
+
+template<class T>
+struct co_buffered_iterator;
+
+template<class T>
+struct co_buffered_inc_awaiter
+{
+    bool await_ready() {
+        auto& st = *owner->state;
+        std::unique_lock<std::mutex> guard(st.lock);
+        taken = st.take();
+        return taken;
+    }
+
+    bool await_suspend(std::coroutine_handle<> caller) {
+        auto& st = *owner->state;
+        std::unique_lock<std::mutex> guard(st.lock);
+        if (!st.buffer.empty() || st.done) {
+            return false;
+        }
+        st.waiting = caller;
+        return true;
+    }
+
+    co_buffered_iterator<T>& await_resume() {
+        auto& st = *owner->state;
+        {
+            std::unique_lock<std::mutex> guard(st.lock);
+            st.consumer_thread = std::this_thread::get_id();
+            if (!taken) {
+                st.take();
+            }
+        }
+        if (st.current.empty() && !!st.error) {
+            rxu::rethrow_exception(st.error);
+        }
+        return *it;
+    }
+
+    std::shared_ptr<detail::co_buffer_owner<T>> owner;
+    co_buffered_iterator<T>* it;
+    bool taken;
+};
+
+/*! \brief an iterator over the values of an observable, which are buffered while the coroutine is busy.
+
+    `co_await ++it` does not suspend the coroutine while there are values in the buffer. When the
+    producer is on another thread, it only waits for the coroutine while the buffer is full.
+
+    \see begin
+*/
+template<class T>
+struct co_buffered_iterator
+{
+    typedef std::input_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T* pointer;
+    typedef T& reference;
+
+    co_buffered_iterator() {}
+    explicit co_buffered_iterator(std::shared_ptr<detail::co_buffer_owner<T>> o) : owner(std::move(o)) {}
+
+    co_buffered_inc_awaiter<T> operator++() {
+        return co_buffered_inc_awaiter<T>{owner, this, false};
+    }
+
+    co_buffered_iterator& operator++(int) = delete;
+    // not implementing postincrement
+
+    bool ended() const {
+        return !owner || owner->state->current.empty();
+    }
+
+    bool operator==(const co_buffered_iterator& rhs) const {
+        return ended() && rhs.ended();
+    }
+    bool operator!=(const co_buffered_iterator& rhs) const {
+        return !(*this == rhs);
+    }
+
+    T& operator*() const {
+        return owner->state->current.get();
+    }
+    T* operator->() const {
+        return std::addressof(operator*());
+    }
+
+    std::shared_ptr<detail::co_buffer_owner<T>> owner;
+};
+
+template<class Source>
+struct co_buffered_begin_awaiter
+{
+    typedef typename Source::value_type value_type;
+    typedef detail::co_buffer_state<value_type> state_type;
+
+    co_buffered_begin_awaiter(Source o, std::size_t capacity)
+        : source(std::move(o))
+        , owner(std::make_shared<detail::co_buffer_owner<value_type>>(capacity))
+    {
+    }
+
+    bool await_ready() {
+        return false;
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) {
+        // the caller may be resumed, and this awaiter destroyed, before
+        // subscribe returns. only use copies from here on.
+        auto st = owner->state;
+        auto src = source;
+        {
+            std::unique_lock<std::mutex> guard(st->lock);
+            st->waiting = caller;
+            st->subscribing = true;
+        }
+        src.subscribe(
+            st->lifetime,
+        // on_next
+            [st](value_type v){
+                st->on_next(std::move(v));
+            },
+        // on_error
+            [st](rxu::error_ptr e){
+                st->on_finish(e);
+            },
+        // on_completed
+            [st](){
+                st->on_finish(rxu::error_ptr());
+            });
+        std::unique_lock<std::mutex> guard(st->lock);
+        st->subscribing = false;
+        if (!!st->waiting && (!st->buffer.empty() || st->done)) {
+            auto consumer = st->waiting;
+            st->waiting = nullptr;
+            return consumer;
+        }
+        return std::noop_coroutine();
+    }
+
+    co_buffered_iterator<value_type> await_resume() {
+        auto& st = *owner->state;
+        {
+            std::unique_lock<std::mutex> guard(st.lock);
+            st.consumer_thread = std::this_thread::get_id();
+            st.take();
+        }
+        if (st.current.empty() && !!st.error) {
+            rxu::rethrow_exception(st.error);
+        }
+        return co_buffered_iterator<value_type>(std::move(owner));
+    }
+
+    Source source;
+    std::shared_ptr<detail::co_buffer_owner<value_type>> owner;
+};
+
+/*! \brief subscribes to the observable and awaits the first value, buffering up to \a capacity values that are sent before the coroutine asks for them.
+
+    \code
+    for (auto it = co_await rxcpp::coroutine::begin(o, 64); it != rxcpp::coroutine::end(o); co_await ++it) {
+        printf("%d\n", *it);
+    }
+    \endcode
+*/
+template<class T, class SourceOperator>
+auto begin(const observable<T, SourceOperator>& o, std::size_t capacity = 1024)
+    ->      co_buffered_begin_awaiter<observable<T, SourceOperator>> {
+    return  co_buffered_begin_awaiter<observable<T, SourceOperator>>(o, capacity);
+}
+
+template<class T, class SourceOperator>
+auto end(const observable<T, SourceOperator>&)
+    ->      co_buffered_iterator<T> {
+    return  co_buffered_iterator<T>();
+}
+
+}
+
+/*! \brief awaits the last value of an observable. an observable that completes without a value throws rxcpp::empty_error.
+
+    \code
+    auto first = co_await interval(seconds(1), observe_on_event_loop()).first();
+    \endcode
+*/
+template<class T, class SourceOperator>
+auto operator co_await(const observable<T, SourceOperator>& o)
+    ->      coroutine::detail::co_observable_awaiter<observable<T, SourceOperator>, coroutine::detail::co_last_value<T>> {
+    return  coroutine::detail::co_observable_awaiter<observable<T, SourceOperator>, coroutine::detail::co_last_value<T>>(o);
+}
+
+}
+
+#elif defined(_RESUMABLE_FUNCTIONS_SUPPORTED)
 
 #include <rxcpp/operators/rx-finally.hpp>
 
@@ -165,8 +165,10 @@
 #include <stdlib.h>
 
 #include <cstddef>
+#include <cstring>
 
 #include <iostream>
+#include <fstream>
 #include <iomanip>
 
 #include <exception>
@@ -185,11 +187,13 @@
 #include <list>
 #include <queue>
 #include <chrono>
+#include <cmath>
 #include <condition_variable>
 #include <initializer_list>
 #include <typeinfo>
 #include <tuple>
 #include <unordered_set>
+#include <unordered_map>
 #include <type_traits>
 #include <utility>
 
@@ -197,6 +201,15 @@
 #include <pthread.h>
 #endif
 
+#if defined(__cpp_lib_atomic_wait)
+#define RXCPP_USE_ATOMIC_WAIT 1
+#endif
+
+#if defined(RXCPP_FORCE_USE_ATOMIC_WAIT)
+#undef RXCPP_USE_ATOMIC_WAIT
+#define RXCPP_USE_ATOMIC_WAIT RXCPP_FORCE_USE_ATOMIC_WAIT
+#endif
+
 #include "rx-util.hpp"
 #include "rx-predef.hpp"
 #include "rx-subscription.hpp"
@@ -204,15 +217,18 @@
 #include "rx-scheduler.hpp"
 #include "rx-subscriber.hpp"
 #include "rx-notification.hpp"
+#include "rx-notification_log.hpp"
 #include "rx-coordination.hpp"
 #include "rx-sources.hpp"
 #include "rx-subjects.hpp"
 #include "rx-operators.hpp"
+#include "rx-linq.hpp"
 #include "rx-observable.hpp"
 #include "rx-connectable_observable.hpp"
 #include "rx-grouped_observable.hpp"
 
 #if !defined(RXCPP_LITE)
+#include "operators/rx-aggregate_window.hpp"
 #include "operators/rx-all.hpp"
 #include "operators/rx-amb.hpp"
 #include "operators/rx-any.hpp"
@@ -259,6 +275,7 @@
 #include "operators/rx-take_until.hpp"
 #include "operators/rx-take_while.hpp"
 #include "operators/rx-tap.hpp"
+#include "operators/rx-tap_record.hpp"
 #include "operators/rx-time_interval.hpp"
 #include "operators/rx-timeout.hpp"
 #include "operators/rx-timestamp.hpp"
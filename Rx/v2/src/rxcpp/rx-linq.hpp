@@ -0,0 +1,203 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_LINQ_HPP)
+#define RXCPP_RX_LINQ_HPP
+
+#include "rx-includes.hpp"
+
+// blocking_observable::to_linq() returns a cpplinq query. cpplinq is
+// only needed by code that calls it.
+namespace cpplinq {
+    struct onepass_cursor_tag;
+    template <class Collection>
+    class linq_driver;
+}
+
+namespace rxcpp {
+
+namespace detail {
+
+template<class T>
+struct linq_buffer_state
+{
+    explicit linq_buffer_state(std::size_t capacity)
+        : capacity(capacity == 0 ? 1 : capacity)
+        , cancelled(false)
+        , done(false)
+    {
+    }
+
+    std::mutex lock;
+    std::condition_variable wake;
+    std::deque<T> queue;
+    std::size_t capacity;
+    bool cancelled;
+    bool done;
+    rxu::error_ptr error;
+    // the value that the cursor is on, moved out of the queue
+    rxu::maybe<T> current;
+    composite_subscription lifetime;
+};
+
+// cancels the subscription when the last copy of a cursor is destroyed
+template<class T>
+struct linq_buffer_owner
+{
+    explicit linq_buffer_owner(std::shared_ptr<linq_buffer_state<T>> s)
+        : state(std::move(s))
+    {
+    }
+    ~linq_buffer_owner()
+    {
+        {
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->cancelled = true;
+            state->wake.notify_all();
+        }
+        state->lifetime.unsubscribe();
+    }
+    std::shared_ptr<linq_buffer_state<T>> state;
+};
+
+}
+
+/*!
+    \brief a cpplinq cursor over the values of an observable. values are buffered up to a capacity, and the source is blocked while the buffer is full.
+
+    \ingroup group-observable
+*/
+template<class T>
+class blocking_linq_cursor
+{
+    typedef detail::linq_buffer_state<T> state_type;
+
+    std::shared_ptr<detail::linq_buffer_owner<T>> owner;
+    state_type* state;
+
+    // waits for the next value, the end of the sequence or an error.
+    void fill() const {
+        if (!state->current.empty()) {
+            return;
+        }
+        std::unique_lock<std::mutex> guard(state->lock);
+        state->wake.wait(guard, [this](){
+            return !state->queue.empty() || state->done || !state->lifetime.is_subscribed();
+        });
+        if (!state->queue.empty()) {
+            state->current.reset(std::move(state->queue.front()));
+            state->queue.pop_front();
+            state->wake.notify_all();
+            return;
+        }
+        if (state->error) {
+            auto e = state->error;
+            guard.unlock();
+            rxu::rethrow_exception(e);
+        }
+    }
+
+public:
+    typedef cpplinq::onepass_cursor_tag cursor_category;
+    typedef T element_type;
+    typedef T reference_type;
+
+    blocking_linq_cursor()
+        : state(nullptr)
+    {
+    }
+    explicit blocking_linq_cursor(std::shared_ptr<detail::linq_buffer_owner<T>> o)
+        : owner(std::move(o))
+        , state(owner->state.get())
+    {
+    }
+
+    bool empty() const {
+        fill();
+        return state->current.empty();
+    }
+    void inc() {
+        fill();
+        state->current.reset();
+    }
+    reference_type get() const {
+        fill();
+        return state->current.get();
+    }
+};
+
+/*!
+    \brief a cpplinq collection over an observable. each cursor subscribes to the observable on a new thread.
+
+    \ingroup group-observable
+*/
+template<class T, class Observable>
+class blocking_linq_collection
+{
+    typedef rxu::decay_t<Observable> observable_type;
+    typedef detail::linq_buffer_state<T> state_type;
+
+    observable_type source;
+    std::size_t capacity;
+
+public:
+    typedef blocking_linq_cursor<T> cursor;
+
+    blocking_linq_collection(observable_type s, std::size_t capacity)
+        : source(std::move(s))
+        , capacity(capacity)
+    {
+    }
+
+    cursor get_cursor() const {
+        auto state = std::make_shared<state_type>(capacity);
+        auto owner = std::make_shared<detail::linq_buffer_owner<T>>(state);
+
+        std::weak_ptr<state_type> weak = state;
+        state->lifetime.add([weak](){
+            if (auto s = weak.lock()) {
+                std::unique_lock<std::mutex> guard(s->lock);
+                s->wake.notify_all();
+            }
+        });
+
+        auto source = this->source;
+        auto worker = rxsc::make_new_thread().create_worker(state->lifetime);
+        worker.schedule([source, state](const rxsc::schedulable&){
+            source.subscribe(
+                state->lifetime,
+            // on_next
+                [state](T v){
+                    std::unique_lock<std::mutex> guard(state->lock);
+                    state->wake.wait(guard, [&](){
+                        return state->queue.size() < state->capacity || state->cancelled;
+                    });
+                    if (state->cancelled) {
+                        return;
+                    }
+                    state->queue.push_back(std::move(v));
+                    state->wake.notify_all();
+                },
+            // on_error
+                [state](rxu::error_ptr e){
+                    std::unique_lock<std::mutex> guard(state->lock);
+                    state->error = e;
+                    state->done = true;
+                    state->wake.notify_all();
+                },
+            // on_completed
+                [state](){
+                    std::unique_lock<std::mutex> guard(state->lock);
+                    state->done = true;
+                    state->wake.notify_all();
+                });
+        });
+
+        return cursor(std::move(owner));
+    }
+};
+
+}
+
+#endif
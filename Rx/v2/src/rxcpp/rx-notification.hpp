@@ -264,7 +264,297 @@ std::ostream& operator<< (std::ostream& out, const recorded<T>& r) {
     out << "@" << r.time() << "-" << r.value();
     return out;
 }
- 
+
+struct notification_kind
+{
+    enum type : unsigned char {
+        on_next,
+        on_error,
+        on_completed
+    };
+};
+
+namespace detail {
+
+template<class T>
+bool equal_values(const std::vector<T>& lhs, const std::vector<T>& rhs, std::true_type) {
+    // compiles to memcmp for scalar types
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template<class T>
+bool equal_values(const std::vector<T>& lhs, const std::vector<T>& rhs, std::false_type) {
+    auto r = rhs.begin();
+    for (auto& l : lhs) {
+        if (!equals(l, *r++, 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<class Pod>
+void write_array(std::ostream& os, const std::vector<Pod>& v) {
+    if (!v.empty()) {
+        os.write(reinterpret_cast<const char*>(v.data()), static_cast<std::streamsize>(v.size() * sizeof(Pod)));
+    }
+}
+
+template<class Pod>
+void read_array(std::istream& is, std::vector<Pod>& v, std::size_t size) {
+    v.resize(size);
+    if (size != 0) {
+        is.read(reinterpret_cast<char*>(v.data()), static_cast<std::streamsize>(size * sizeof(Pod)));
+    }
+}
+
+}
+
+/*!
+    \brief a list of recorded notifications, stored as columns.
+
+    The time and kind of each notification are kept in contiguous arrays. The values of the on_next
+    notifications are kept in a third array in the same order, and errors are kept out of line. Nothing
+    is allocated per notification, and two sequences are compared a column at a time.
+
+    messages() converts the sequence to the recorded notifications used by the test schedulers.
+*/
+template<class T>
+class recorded_sequence
+{
+public:
+    typedef notification<T> notification_type;
+    typedef recorded<typename notification_type::type> recorded_type;
+    typedef notification_kind::type kind_type;
+    typedef std::size_t size_type;
+
+    /// the index of a notification and of the value or error that belongs to it.
+    struct position
+    {
+        size_type index;
+        size_type value;
+        size_type error;
+    };
+
+private:
+    std::vector<long> t;
+    std::vector<kind_type> k;
+    std::vector<T> v;
+    std::vector<rxu::error_ptr> e;
+
+public:
+    recorded_sequence() {}
+
+    explicit recorded_sequence(const std::vector<recorded_type>& messages) {
+        append(messages);
+    }
+
+    /// takes the columns of a sequence that was loaded in bulk. values has one entry for each on_next and errors one for each on_error.
+    recorded_sequence(std::vector<long> times, std::vector<kind_type> kinds, std::vector<T> values, std::vector<rxu::error_ptr> errors)
+        : t(std::move(times))
+        , k(std::move(kinds))
+        , v(std::move(values))
+        , e(std::move(errors))
+    {
+        auto nexts = static_cast<size_type>(std::count(k.begin(), k.end(), notification_kind::on_next));
+        auto errs = static_cast<size_type>(std::count(k.begin(), k.end(), notification_kind::on_error));
+        if (t.size() != k.size() || v.size() != nexts || e.size() != errs) {
+            rxu::throw_exception(std::invalid_argument("recorded_sequence columns do not match the kinds"));
+        }
+    }
+
+    size_type size() const {
+        return t.size();
+    }
+    bool empty() const {
+        return t.empty();
+    }
+
+    void reserve(size_type notifications, size_type values) {
+        t.reserve(notifications);
+        k.reserve(notifications);
+        v.reserve(values);
+    }
+
+    const std::vector<long>& times() const {
+        return t;
+    }
+    const std::vector<kind_type>& kinds() const {
+        return k;
+    }
+    const std::vector<T>& values() const {
+        return v;
+    }
+    const std::vector<rxu::error_ptr>& errors() const {
+        return e;
+    }
+
+    void on_next(long time, T value) {
+        t.push_back(time);
+        k.push_back(notification_kind::on_next);
+        v.push_back(std::move(value));
+    }
+    void on_error(long time, rxu::error_ptr ep) {
+        t.push_back(time);
+        k.push_back(notification_kind::on_error);
+        e.push_back(std::move(ep));
+    }
+    void on_completed(long time) {
+        t.push_back(time);
+        k.push_back(notification_kind::on_completed);
+    }
+
+    void append(const recorded_type& r) {
+        auto time = r.time();
+        r.value()->accept(make_subscriber<T>(make_observer_dynamic<T>(
+            [this, time](T value){
+                on_next(time, std::move(value));
+            },
+            [this, time](rxu::error_ptr ep){
+                on_error(time, ep);
+            },
+            [this, time](){
+                on_completed(time);
+            })));
+    }
+    void append(const std::vector<recorded_type>& messages) {
+        t.reserve(t.size() + messages.size());
+        k.reserve(k.size() + messages.size());
+        for (auto& r : messages) {
+            append(r);
+        }
+    }
+
+    position first() const {
+        return position{0, 0, 0};
+    }
+
+    /// moves p to the next notification.
+    void advance(position& p) const {
+        switch (k[p.index]) {
+        case notification_kind::on_next: ++p.value; break;
+        case notification_kind::on_error: ++p.error; break;
+        case notification_kind::on_completed: break;
+        }
+        ++p.index;
+    }
+
+    /// sends the notification at p to o.
+    template<class Subscriber>
+    void accept(const position& p, const Subscriber& o) const {
+        switch (k[p.index]) {
+        case notification_kind::on_next: o.on_next(v[p.value]); break;
+        case notification_kind::on_error: o.on_error(e[p.error]); break;
+        case notification_kind::on_completed: o.on_completed(); break;
+        }
+    }
+
+    std::vector<recorded_type> messages() const {
+        std::vector<recorded_type> result;
+        result.reserve(t.size());
+        for (auto p = first(); p.index != t.size(); advance(p)) {
+            switch (k[p.index]) {
+            case notification_kind::on_next:
+                result.push_back(recorded_type(t[p.index], notification_type::on_next(v[p.value])));
+                break;
+            case notification_kind::on_error:
+                result.push_back(recorded_type(t[p.index], notification_type::on_error(e[p.error])));
+                break;
+            case notification_kind::on_completed:
+                result.push_back(recorded_type(t[p.index], notification_type::on_completed()));
+                break;
+            }
+        }
+        return result;
+    }
+
+    /// the errors are compared by count, as they are by the recorded notifications.
+    bool equals(const recorded_sequence& other) const {
+        return t.size() == other.t.size() &&
+            v.size() == other.v.size() &&
+            std::equal(t.begin(), t.end(), other.t.begin()) &&
+            std::equal(k.begin(), k.end(), other.k.begin()) &&
+            detail::equal_values(v, other.v, typename std::is_scalar<T>::type());
+    }
+
+    /*!
+        writes the sequence in a binary format that read() loads with one read per column.
+        errors are written as the text of rxu::what() and read back as std::runtime_error.
+    */
+    void write(std::ostream& os) const {
+        static_assert(std::is_trivially_copyable<T>::value, "recorded_sequence::write requires a trivially copyable value type");
+        const uint64_t header[] = {
+            UINT64_C(0x7278637072656331), // "rxcprec1"
+            sizeof(T),
+            t.size(),
+            v.size(),
+            e.size()
+        };
+        os.write(reinterpret_cast<const char*>(header), sizeof(header));
+        std::vector<int64_t> times(t.begin(), t.end());
+        detail::write_array(os, times);
+        detail::write_array(os, k);
+        detail::write_array(os, v);
+        for (auto& ep : e) {
+            auto what = rxu::what(ep);
+            uint64_t length = what.size();
+            os.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            os.write(what.data(), static_cast<std::streamsize>(what.size()));
+        }
+        if (!os) {
+            rxu::throw_exception(std::runtime_error("recorded_sequence::write failed"));
+        }
+    }
+
+    static recorded_sequence read(std::istream& is) {
+        static_assert(std::is_trivially_copyable<T>::value, "recorded_sequence::read requires a trivially copyable value type");
+        uint64_t header[5] = {};
+        is.read(reinterpret_cast<char*>(header), sizeof(header));
+        if (!is || header[0] != UINT64_C(0x7278637072656331) || header[1] != sizeof(T)) {
+            rxu::throw_exception(std::runtime_error("recorded_sequence::read found no sequence of this value type"));
+        }
+        std::vector<int64_t> times;
+        detail::read_array(is, times, static_cast<size_type>(header[2]));
+        std::vector<kind_type> kinds;
+        detail::read_array(is, kinds, static_cast<size_type>(header[2]));
+        std::vector<T> values;
+        detail::read_array(is, values, static_cast<size_type>(header[3]));
+        std::vector<rxu::error_ptr> errors;
+        errors.reserve(static_cast<size_type>(header[4]));
+        for (uint64_t i = 0; i != header[4] && is; ++i) {
+            uint64_t length = 0;
+            is.read(reinterpret_cast<char*>(&length), sizeof(length));
+            std::string what(static_cast<size_type>(length), '\0');
+            is.read(&what[0], static_cast<std::streamsize>(length));
+            errors.push_back(rxu::make_error_ptr(std::runtime_error(what)));
+        }
+        if (!is) {
+            rxu::throw_exception(std::runtime_error("recorded_sequence::read reached the end of the stream"));
+        }
+        return recorded_sequence(std::vector<long>(times.begin(), times.end()), std::move(kinds), std::move(values), std::move(errors));
+    }
+};
+
+template<class T>
+bool operator == (const recorded_sequence<T>& lhs, const recorded_sequence<T>& rhs) {
+    return lhs.equals(rhs);
+}
+
+template<class T>
+bool operator == (const recorded_sequence<T>& lhs, const std::vector<typename recorded_sequence<T>::recorded_type>& rhs) {
+    return lhs.equals(recorded_sequence<T>(rhs));
+}
+
+template<class T>
+bool operator == (const std::vector<typename recorded_sequence<T>::recorded_type>& lhs, const recorded_sequence<T>& rhs) {
+    return recorded_sequence<T>(lhs).equals(rhs);
+}
+
+template<class T>
+std::ostream& operator<< (std::ostream& out, const recorded_sequence<T>& rs) {
+    return detail::ostreamvector(out, rs.messages());
+}
+
 }
 namespace rxn=notifications;
 
@@ -0,0 +1,237 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_NOTIFICATION_LOG_HPP)
+#define RXCPP_RX_NOTIFICATION_LOG_HPP
+
+#include "rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace notifications {
+
+/*!
+    \brief stores the values of a notification log as their bytes. T must be trivially copyable.
+
+    A serializer has the methods serialize(const T&, std::string&), which appends the bytes of a
+    value, and deserialize(const char*, std::size_t), which returns the value again.
+*/
+template<class T>
+struct binary_serializer
+{
+    static_assert(std::is_trivially_copyable<T>::value, "binary_serializer requires a trivially copyable value type, supply a serializer for other types");
+
+    void serialize(const T& v, std::string& out) const {
+        out.append(reinterpret_cast<const char*>(std::addressof(v)), sizeof(T));
+    }
+    T deserialize(const char* data, std::size_t size) const {
+        if (size != sizeof(T)) {
+            rxu::throw_exception(std::runtime_error("binary_serializer found a value of the wrong size"));
+        }
+        T v;
+        std::memcpy(std::addressof(v), data, sizeof(T));
+        return v;
+    }
+};
+
+/// one notification read from a log. data points into the chunk held by the log_reader and is valid until the next record is read.
+struct log_record
+{
+    int64_t time;
+    notification_kind::type kind;
+    const char* data;
+    std::size_t size;
+};
+
+namespace detail {
+
+// the file starts with the magic and the version. it is followed by chunks, each a
+// chunk header and the records of the chunk. a record is the time in nanoseconds,
+// the size of the data, the kind and the data.
+const uint64_t log_magic = UINT64_C(0x31676f6c70637872); // "rxcplog1"
+const uint64_t log_version = 1;
+const uint32_t log_chunk_magic = 0x6b6e6863; // "chnk"
+const std::size_t log_header_size = 16;
+const std::size_t log_chunk_header_size = 16;
+const std::size_t log_record_header_size = 8 + 4 + 1;
+
+template<class Pod>
+void append_bytes(std::string& out, Pod p) {
+    out.append(reinterpret_cast<const char*>(&p), sizeof(Pod));
+}
+
+template<class Pod>
+Pod read_bytes(const char* data) {
+    Pod p;
+    std::memcpy(&p, data, sizeof(Pod));
+    return p;
+}
+
+}
+
+/*!
+    \brief appends notifications to a log file in chunks.
+
+    The records are collected in memory and written with one write per chunk, so a log that is cut
+    short ends with whole chunks. A new log_writer replaces the file at path.
+*/
+class log_writer
+{
+    std::ofstream file;
+    std::string chunk;
+    std::size_t records;
+    std::size_t chunk_size;
+    mutable std::mutex lock;
+    bool closed;
+
+    log_writer(const log_writer&);
+
+    void flush_chunk() {
+        if (records == 0) {
+            return;
+        }
+        std::string header;
+        detail::append_bytes(header, detail::log_chunk_magic);
+        detail::append_bytes(header, static_cast<uint32_t>(records));
+        detail::append_bytes(header, static_cast<uint64_t>(chunk.size()));
+        file.write(header.data(), static_cast<std::streamsize>(header.size()));
+        file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        file.flush();
+        chunk.clear();
+        records = 0;
+        if (!file) {
+            rxu::throw_exception(std::runtime_error("log_writer could not write the log"));
+        }
+    }
+
+public:
+    explicit log_writer(const std::string& path, std::size_t chunk_size = 64 * 1024)
+        : file(path.c_str(), std::ios::binary | std::ios::out | std::ios::trunc)
+        , records(0)
+        , chunk_size(chunk_size)
+        , closed(false)
+    {
+        if (!file) {
+            rxu::throw_exception(std::runtime_error("log_writer could not open " + path));
+        }
+        std::string header;
+        detail::append_bytes(header, detail::log_magic);
+        detail::append_bytes(header, detail::log_version);
+        file.write(header.data(), static_cast<std::streamsize>(header.size()));
+        chunk.reserve(chunk_size + detail::log_record_header_size);
+    }
+    ~log_writer() {
+        RXCPP_TRY {
+            close();
+        } RXCPP_CATCH(...) {
+        }
+    }
+
+    /// appends a record. time is in nanoseconds. records written after close() are dropped.
+    void write(int64_t time, notification_kind::type kind, const char* data, std::size_t size) {
+        std::unique_lock<std::mutex> guard(lock);
+        if (closed) {
+            return;
+        }
+        detail::append_bytes(chunk, time);
+        detail::append_bytes(chunk, static_cast<uint32_t>(size));
+        detail::append_bytes(chunk, static_cast<uint8_t>(kind));
+        chunk.append(data, size);
+        ++records;
+        if (chunk.size() >= chunk_size) {
+            flush_chunk();
+        }
+    }
+
+    void close() {
+        std::unique_lock<std::mutex> guard(lock);
+        if (closed) {
+            return;
+        }
+        closed = true;
+        flush_chunk();
+        file.close();
+    }
+};
+
+/*!
+    \brief reads the records of a log file one chunk at a time.
+
+    Only the current chunk is held in memory. A chunk that was not written completely ends the log.
+*/
+class log_reader
+{
+    std::ifstream file;
+    std::vector<char> chunk;
+    std::size_t offset;
+    std::size_t remaining;
+
+    log_reader(const log_reader&);
+
+    bool read_chunk() {
+        char header[detail::log_chunk_header_size];
+        if (!file.read(header, sizeof(header))) {
+            return false;
+        }
+        if (detail::read_bytes<uint32_t>(header) != detail::log_chunk_magic) {
+            rxu::throw_exception(std::runtime_error("log_reader found a corrupt chunk"));
+        }
+        remaining = detail::read_bytes<uint32_t>(header + 4);
+        auto size = detail::read_bytes<uint64_t>(header + 8);
+        chunk.resize(static_cast<std::size_t>(size));
+        offset = 0;
+        if (size != 0 && !file.read(chunk.data(), static_cast<std::streamsize>(size))) {
+            remaining = 0;
+            return false;
+        }
+        return true;
+    }
+
+public:
+    explicit log_reader(const std::string& path)
+        : file(path.c_str(), std::ios::binary | std::ios::in)
+        , offset(0)
+        , remaining(0)
+    {
+        char header[detail::log_header_size];
+        if (!file || !file.read(header, sizeof(header))) {
+            rxu::throw_exception(std::runtime_error("log_reader could not open " + path));
+        }
+        if (detail::read_bytes<uint64_t>(header) != detail::log_magic ||
+            detail::read_bytes<uint64_t>(header + 8) != detail::log_version) {
+            rxu::throw_exception(std::runtime_error("log_reader found no log in " + path));
+        }
+    }
+
+    /// reads the next record into r. returns false at the end of the log.
+    bool next(log_record& r) {
+        while (remaining == 0) {
+            if (!read_chunk()) {
+                return false;
+            }
+        }
+        if (chunk.size() - offset < detail::log_record_header_size) {
+            rxu::throw_exception(std::runtime_error("log_reader found a corrupt record"));
+        }
+        const char* p = chunk.data() + offset;
+        r.time = detail::read_bytes<int64_t>(p);
+        r.size = detail::read_bytes<uint32_t>(p + 8);
+        auto kind = detail::read_bytes<uint8_t>(p + 12);
+        if (kind > notification_kind::on_completed ||
+            chunk.size() - offset - detail::log_record_header_size < r.size) {
+            rxu::throw_exception(std::runtime_error("log_reader found a corrupt record"));
+        }
+        r.kind = static_cast<notification_kind::type>(kind);
+        r.data = p + detail::log_record_header_size;
+        offset += detail::log_record_header_size + r.size;
+        --remaining;
+        return true;
+    }
+};
+
+}
+
+}
+
+#endif
@@ -159,6 +159,73 @@ struct defer_observable
 {
 };
 
+namespace detail {
+
+// signals the end of a blocking subscribe to the thread that is waiting
+// for it. set() may be called on another thread, so it does not touch
+// this object again once the waiting thread is allowed to return.
+class blocking_completion
+{
+#if RXCPP_USE_ATOMIC_WAIT
+    std::atomic<bool> done;
+    std::atomic<bool> released;
+
+public:
+    blocking_completion()
+        : done(false)
+        , released(false)
+    {
+    }
+
+    void set() {
+        done.store(true, std::memory_order_release);
+        done.notify_one();
+        released.store(true, std::memory_order_release);
+    }
+    // true once set() no longer touches this object
+    bool is_set() const {
+        return released.load(std::memory_order_acquire);
+    }
+    void wait() {
+        done.wait(false, std::memory_order_acquire);
+        // set() is finishing the notify
+        while (!released.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+#else
+    std::atomic<bool> done;
+    mutable std::mutex lock;
+    std::condition_variable wake;
+
+public:
+    blocking_completion()
+        : done(false)
+    {
+    }
+
+    void set() {
+        std::unique_lock<std::mutex> guard(lock);
+        done.store(true, std::memory_order_release);
+        wake.notify_one();
+    }
+    // takes the lock so that set() has released it before this returns true
+    bool is_set() const {
+        std::unique_lock<std::mutex> guard(lock);
+        return done.load(std::memory_order_relaxed);
+    }
+    void wait() {
+        std::unique_lock<std::mutex> guard(lock);
+        wake.wait(guard,
+            [&](){
+                return done.load(std::memory_order_relaxed);
+            });
+    }
+#endif
+};
+
+}
+
 /*!
     \brief a source of values whose methods block until all values have been emitted. subscribe or use one of the operator methods that reduce the values emitted to a single value.
 
@@ -171,9 +238,7 @@ class blocking_observable
     template<class Obsvbl, class... ArgN>
     static auto blocking_subscribe(const Obsvbl& source, bool do_rethrow, ArgN&&... an)
         -> void {
-        std::mutex lock;
-        std::condition_variable wake;
-        bool disposed = false;
+        detail::blocking_completion disposed;
         rxu::error_ptr error;
 
         auto dest = make_subscriber<T>(std::forward<ArgN>(an)...);
@@ -195,22 +260,74 @@ class blocking_observable
         auto cs = scbr.get_subscription();
         cs.add(
             [&](){
-                std::unique_lock<std::mutex> guard(lock);
-                wake.notify_one();
-                disposed = true;
+                disposed.set();
             });
 
         source.subscribe(std::move(scbr));
 
-        std::unique_lock<std::mutex> guard(lock);
-        wake.wait(guard,
-            [&](){
-                return disposed;
-            });
+        // sources that finish during subscribe do not wait
+        if (!disposed.is_set()) {
+            disposed.wait();
+        }
 
         if (error) {rxu::rethrow_exception(error);}
     }
 
+    // sources that rx-reduce.hpp folds in one batch use the operator.
+    // everything else folds each value into a local result.
+    T sum(std::true_type) const {
+        rxu::maybe<T> result;
+        blocking_subscribe(source.sum(), true, [&](T v){result.reset(std::move(v));});
+        return *result;
+    }
+    T sum(std::false_type) const {
+        rxu::maybe<T> result;
+        subscribe_with_rethrow(
+            [&](T v){
+                if (result.empty())
+                    result.reset(std::move(v));
+                else
+                    *result = *result + v;
+            });
+        if (result.empty())
+            rxu::throw_exception(rxcpp::empty_error("sum() requires a stream with at least one value"));
+        return *result;
+    }
+
+    T max(std::true_type) const {
+        rxu::maybe<T> result;
+        blocking_subscribe(source.max(), true, [&](T v){result.reset(std::move(v));});
+        return *result;
+    }
+    T max(std::false_type) const {
+        rxu::maybe<T> result;
+        subscribe_with_rethrow(
+            [&](T v){
+                if (result.empty() || *result < v)
+                    result.reset(std::move(v));
+            });
+        if (result.empty())
+            rxu::throw_exception(rxcpp::empty_error("max() requires a stream with at least one value"));
+        return *result;
+    }
+
+    T min(std::true_type) const {
+        rxu::maybe<T> result;
+        blocking_subscribe(source.min(), true, [&](T v){result.reset(std::move(v));});
+        return *result;
+    }
+    T min(std::false_type) const {
+        rxu::maybe<T> result;
+        subscribe_with_rethrow(
+            [&](T v){
+                if (result.empty() || v < *result)
+                    result.reset(std::move(v));
+            });
+        if (result.empty())
+            rxu::throw_exception(rxcpp::empty_error("min() requires a stream with at least one value"));
+        return *result;
+    }
+
 public:
     typedef rxu::decay_t<Observable> observable_type;
     observable_type source;
@@ -333,8 +450,8 @@ public:
     */
     int count() const {
         int result = 0;
-        source.count().as_blocking().subscribe_with_rethrow(
-            [&](int v){result = v;});
+        subscribe_with_rethrow(
+            [&](const T&){++result;});
         return result;
     }
 
@@ -356,7 +473,8 @@ public:
         \snippet output.txt blocking sum error sample
     */
     T sum() const {
-        return source.sum().as_blocking().last();
+        typedef decltype(blocking_batch_reducible(source, sum_tag(), 0)) batch;
+        return sum(std::integral_constant<bool, batch::value>());
     }
 
     /*! Return the average value of all items emitted by this blocking_observable, or throw an std::runtime_error exception if it emits no items.
@@ -398,7 +516,8 @@ public:
     \snippet output.txt blocking max error sample
 */
     T max() const {
-        return source.max().as_blocking().last();
+        typedef decltype(blocking_batch_reducible(source, max_tag(), 0)) batch;
+        return max(std::integral_constant<bool, batch::value>());
     }
 
     /*! Return the min of all items emitted by this blocking_observable, or throw an std::runtime_error exception if it emits no items.
@@ -419,7 +538,23 @@ public:
     \snippet output.txt blocking min error sample
 */
     T min() const {
-        return source.min().as_blocking().last();
+        typedef decltype(blocking_batch_reducible(source, min_tag(), 0)) batch;
+        return min(std::integral_constant<bool, batch::value>());
+    }
+
+    /*! Return a cpplinq query over the items emitted by this blocking_observable.
+
+        \param capacity  the number of items that are buffered before the source is blocked (optional)
+
+        \return  A onepass cpplinq query. Each enumeration subscribes to the source on a new thread and
+                  receives the items through a buffer of at most capacity items.
+
+        \note  linq.hpp from cpplinq must be included to use the query.
+
+        \note  If the source observable calls on_error, the raised exception is rethrown while the query is enumerated.
+    */
+    cpplinq::linq_driver<blocking_linq_collection<T, observable_type>> to_linq(std::size_t capacity = 1024) const {
+        return blocking_linq_collection<T, observable_type>(source, capacity);
     }
 };
 
@@ -650,6 +785,17 @@ public:
         return detail_subscribe(make_subscriber<T>(std::forward<ArgN>(an)...));
     }
 
+    /*! @copydoc rx-aggregate_window.hpp
+     */
+    template<class... AN>
+    auto aggregate_window(AN&&... an) const
+    /// \cond SHOW_SERVICE_MEMBERS
+    -> decltype(observable_member(aggregate_window_tag{}, *(this_type*)nullptr, std::forward<AN>(an)...))
+    /// \endcond
+    {
+        return  observable_member(aggregate_window_tag{},                *this, std::forward<AN>(an)...);
+    }
+
     /*! @copydoc rx-all.hpp
      */
     template<class... AN>
@@ -760,6 +906,17 @@ public:
         return      observable_member(tap_tag{},                *this, std::forward<AN>(an)...);
     }
 
+    /*! @copydoc rx-tap_record.hpp
+     */
+    template<class... AN>
+    auto tap_record(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(tap_record_tag{}, *(this_type*)nullptr, std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(tap_record_tag{},                *this, std::forward<AN>(an)...);
+    }
+
     /*! @copydoc rx-time_interval.hpp
      */
     template<class... AN>
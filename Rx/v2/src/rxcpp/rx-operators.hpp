@@ -100,6 +100,13 @@ public:
 
 namespace rxcpp {
 
+struct aggregate_window_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-aggregate_window.hpp>");
+    };
+};
+
 struct amb_tag {
     template<class Included>
     struct include_header{
@@ -306,6 +313,11 @@ struct average_tag : reduce_tag {};
 struct min_tag : reduce_tag {};
 struct max_tag : reduce_tag {};
 
+/// blocking_observable asks whether sum, min and max can take the batch
+/// path. rx-reduce.hpp adds better matches that are found by ADL.
+template<class Observable, class Tag>
+std::false_type blocking_batch_reducible(const Observable&, Tag, long);
+
 struct ref_count_tag {
     template<class Included>
     struct include_header{
@@ -462,6 +474,13 @@ struct tap_tag {
     };
 };
 
+struct tap_record_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-tap_record.hpp>");
+    };
+};
+
 struct timeout_tag {
     template<class Included>
     struct include_header{
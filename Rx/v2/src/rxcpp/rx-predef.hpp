@@ -17,6 +17,8 @@ inline auto trace_activity() -> decltype(rxcpp_trace_activity(trace_tag()))& {
     return trace;
 }
 
+typedef decltype(rxcpp_trace_activity(trace_tag())) trace_activity_type;
+
 
 struct tag_action {};
 template<class T, class C = rxu::types_checked>
@@ -450,7 +450,7 @@ class schedulable : public schedulable_base
 
     class recursed_scope_type
     {
-        mutable const recursed* requestor;
+        mutable const recurse* requestor;
 
         class exit_recursed_scope_type
         {
@@ -488,14 +488,17 @@ class schedulable : public schedulable_base
             return *this;
         }
         exit_recursed_scope_type reset(const recurse& r) const {
-            requestor = std::addressof(r.get_recursed());
+            requestor = std::addressof(r);
             return exit_recursed_scope_type(this);
         }
         bool is_recursed() const {
             return !!requestor;
         }
+        bool is_allowed() const {
+            return !!requestor && requestor->is_allowed();
+        }
         void operator()() const {
-            (*requestor)();
+            requestor->get_recursed()();
         }
     };
     recursed_scope_type recursed_scope;
@@ -586,6 +589,13 @@ public:
     inline void operator()() const {
         recursed_scope();
     }
+    /// does the scheduler allow tail-recursion now?
+    /// an action may keep looping in place of requesting
+    /// tail-recursion for as long as this returns true.
+    /// returns false when is_recursed() is false.
+    inline bool is_recursion_allowed() const {
+        return recursed_scope.is_allowed();
+    }
 
     // composite_subscription
     //
@@ -885,6 +895,12 @@ struct time_schedulable
 // Sorts time_schedulable items in priority order sorted
 // on value of time_schedulable.when. Items with equal
 // values for when are sorted in fifo order.
+//
+// Items that are unsubscribed while in the queue are not
+// removed until they reach the top. To keep the queue from
+// filling up with them when most items are cancelled, push
+// compacts the queue each time it has doubled in size since
+// the last compaction. This keeps push amortized O(log n).
 template<class TimePoint>
 class schedulable_queue {
 public:
@@ -893,6 +909,27 @@ public:
     typedef std::vector<elem_type> container_type;
     typedef const item_type& const_reference;
 
+    struct metrics_type
+    {
+        metrics_type()
+            : live(0)
+            , dead(0)
+            , compactions(0)
+            , compacted(0)
+        {
+        }
+        /// items that are still subscribed
+        std::size_t live;
+        /// items that were unsubscribed and are waiting to be removed
+        std::size_t dead;
+        /// number of times the queue was compacted
+        std::size_t compactions;
+        /// number of unsubscribed items removed by compaction
+        std::size_t compacted;
+    };
+
+    static const std::size_t minimum_compaction_size = 128;
+
 private:
     struct compare_elem
     {
@@ -906,40 +943,94 @@ private:
         }
     };
 
-    typedef std::priority_queue<
-        elem_type,
-        container_type,
-        compare_elem
-    > queue_type;
-
-    queue_type q;
+    container_type q;
 
     int64_t ordinal;
+
+    std::size_t compact_at;
+    std::size_t compactions;
+    std::size_t compacted;
+
 public:
 
-    schedulable_queue() 
-        : ordinal(0) 
+    schedulable_queue()
+        : ordinal(0)
+        , compact_at(minimum_compaction_size)
+        , compactions(0)
+        , compacted(0)
     {
     }
 
     const_reference top() const {
-        return q.top().first;
+        return q.front().first;
     }
 
     void pop() {
-        q.pop();
+        std::pop_heap(q.begin(), q.end(), compare_elem());
+        q.pop_back();
     }
 
     bool empty() const {
         return q.empty();
     }
 
+    std::size_t size() const {
+        return q.size();
+    }
+
     void push(const item_type& value) {
-        q.push(elem_type(value, ordinal++));
+        maybe_compact();
+        q.push_back(elem_type(value, ordinal++));
+        std::push_heap(q.begin(), q.end(), compare_elem());
     }
 
     void push(item_type&& value) {
-        q.push(elem_type(std::move(value), ordinal++));
+        maybe_compact();
+        q.push_back(elem_type(std::move(value), ordinal++));
+        std::push_heap(q.begin(), q.end(), compare_elem());
+    }
+
+    /// remove all the unsubscribed items. the order of the
+    /// remaining items is unchanged.
+    /// returns the number of items removed.
+    std::size_t compact() {
+        auto live_end = std::remove_if(q.begin(), q.end(), [](const elem_type& e){
+            return !e.first.what.is_subscribed();
+        });
+        auto removed = static_cast<std::size_t>(std::distance(live_end, q.end()));
+        if (removed != 0) {
+            q.erase(live_end, q.end());
+            std::make_heap(q.begin(), q.end(), compare_elem());
+        }
+        ++compactions;
+        compacted += removed;
+        compact_at = q.size() * 2;
+        if (compact_at < minimum_compaction_size) {
+            compact_at = minimum_compaction_size;
+        }
+        return removed;
+    }
+
+    /// count the live and dead items. this visits every item.
+    metrics_type metrics() const {
+        metrics_type result;
+        for (auto& e : q) {
+            if (e.first.what.is_subscribed()) {
+                ++result.live;
+            } else {
+                ++result.dead;
+            }
+        }
+        result.compactions = compactions;
+        result.compacted = compacted;
+        return result;
+    }
+
+private:
+    void maybe_compact() {
+        if (q.size() >= compact_at) {
+            compact();
+        }
     }
 };
 
@@ -957,5 +1048,6 @@ namespace rxsc=schedulers;
 #include "schedulers/rx-immediate.hpp"
 #include "schedulers/rx-virtualtime.hpp"
 #include "schedulers/rx-sameworker.hpp"
+#include "schedulers/rx-coalescing.hpp"
 
 #endif
@@ -38,6 +38,8 @@ namespace rxs=sources;
 #include "sources/rx-create.hpp"
 #include "sources/rx-range.hpp"
 #include "sources/rx-iterate.hpp"
+#include "sources/rx-from_linq.hpp"
+#include "sources/rx-replay_log.hpp"
 #include "sources/rx-interval.hpp"
 #include "sources/rx-empty.hpp"
 #include "sources/rx-defer.hpp"
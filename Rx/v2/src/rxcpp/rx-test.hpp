@@ -16,11 +16,13 @@ struct test_subject_base
     : public std::enable_shared_from_this<test_subject_base<T>>
 {
     typedef rxn::recorded<typename rxn::notification<T>::type> recorded_type;
+    typedef rxn::recorded_sequence<T> recorded_sequence_type;
     typedef std::shared_ptr<test_subject_base<T>> type;
 
     virtual ~test_subject_base() {}
     virtual void on_subscribe(subscriber<T>) const =0;
     virtual std::vector<recorded_type> messages() const =0;
+    virtual const recorded_sequence_type& records() const =0;
     virtual std::vector<rxn::subscription> subscriptions() const =0;
 };
 
@@ -59,6 +61,7 @@ class testable_observer
 
 public:
     typedef typename detail::test_subject_base<T>::recorded_type recorded_type;
+    typedef typename detail::test_subject_base<T>::recorded_sequence_type recorded_sequence_type;
 
     testable_observer(test_subject ts, observer_base ob)
         : observer_base(std::move(ob))
@@ -69,6 +72,11 @@ public:
     std::vector<recorded_type> messages() const {
         return ts->messages();
     }
+
+    /// the recorded notifications without a copy or an allocation per notification.
+    const recorded_sequence_type& records() const {
+        return ts->records();
+    }
 };
 
 //struct tag_test_observable : public tag_observable {};
@@ -91,6 +99,7 @@ class testable_observable
 
 public:
     typedef typename detail::test_subject_base<T>::recorded_type recorded_type;
+    typedef typename detail::test_subject_base<T>::recorded_sequence_type recorded_sequence_type;
 
     explicit testable_observable(test_subject ts)
         : observable_base(detail::test_source<T>(ts))
@@ -105,6 +114,11 @@ public:
     std::vector<recorded_type> messages() const {
         return ts->messages();
     }
+
+    /// the recorded notifications without a copy or an allocation per notification.
+    const recorded_sequence_type& records() const {
+        return ts->records();
+    }
 };
 
 }
@@ -133,5 +147,6 @@ auto operator | (const rxcpp::test::testable_observable<T>& source, OperatorFact
 }
 
 #include "schedulers/rx-test.hpp"
+#include "schedulers/rx-paralleltest.hpp"
 
 #endif
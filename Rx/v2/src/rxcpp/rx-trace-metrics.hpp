@@ -0,0 +1,332 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_TRACE_METRICS_HPP)
+#define RXCPP_RX_TRACE_METRICS_HPP
+
+#include "rx-trace.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace rxcpp {
+
+/// a log-linear histogram of nanosecond durations. each power of two is
+/// split into 8 buckets, so a value is reported within 12.5% of its true
+/// value, from 1ns up to the full range of std::uint64_t.
+struct trace_latency_histogram
+{
+    static const int sub_bucket_bits = 3;
+    static const std::size_t sub_bucket_count = 1 << sub_bucket_bits;
+    static const std::size_t bucket_count = (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+    static std::size_t index_of(std::uint64_t value) {
+        if (value < sub_bucket_count) {
+            return static_cast<std::size_t>(value);
+        }
+        int exponent = 0;
+        for (std::uint64_t rest = value; rest >>= 1;) {
+            ++exponent;
+        }
+        auto sub = static_cast<std::size_t>(value >> (exponent - sub_bucket_bits)) & (sub_bucket_count - 1);
+        return static_cast<std::size_t>(exponent - sub_bucket_bits + 1) * sub_bucket_count + sub;
+    }
+
+    /// the largest value that is recorded in the bucket at index
+    static std::uint64_t highest_equivalent(std::size_t index) {
+        if (index < sub_bucket_count) {
+            return index;
+        }
+        auto shift = static_cast<int>(index / sub_bucket_count) - 1;
+        auto lowest = (std::uint64_t(sub_bucket_count) + (index % sub_bucket_count)) << shift;
+        return lowest + ((std::uint64_t(1) << shift) - 1);
+    }
+
+    trace_latency_histogram()
+        : counts(bucket_count, 0)
+    {
+    }
+
+    std::uint64_t count() const {
+        std::uint64_t total = 0;
+        for (auto c : counts) {
+            total += c;
+        }
+        return total;
+    }
+
+    /// the smallest recorded duration that is greater than or equal to
+    /// the given percentage (0-100) of all the recorded durations.
+    std::chrono::nanoseconds percentile(double p) const {
+        auto total = count();
+        if (total == 0) {
+            return std::chrono::nanoseconds(0);
+        }
+        auto target = static_cast<std::uint64_t>((p / 100.0) * total + 0.5);
+        if (target < 1) {
+            target = 1;
+        }
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+            seen += counts[i];
+            if (seen >= target) {
+                return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(highest_equivalent(i)));
+            }
+        }
+        return max();
+    }
+
+    std::chrono::nanoseconds max() const {
+        for (auto i = counts.size(); i > 0; --i) {
+            if (counts[i - 1] != 0) {
+                return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(highest_equivalent(i - 1)));
+            }
+        }
+        return std::chrono::nanoseconds(0);
+    }
+
+    /// the number of durations recorded in each bucket
+    std::vector<std::uint64_t> counts;
+};
+
+/// the state of one worker queue at the time of a snapshot. counters and
+/// histograms are cumulative since the worker was created, a poller that
+/// wants rates subtracts the previous snapshot.
+struct trace_worker_snapshot
+{
+    std::uint64_t id;
+    /// items in the queue, including the cancelled items not yet removed
+    std::size_t depth;
+    std::size_t max_depth;
+    std::uint64_t enqueued;
+    std::uint64_t executed;
+    /// cancelled items that were removed from the queue without running
+    std::uint64_t dropped;
+    /// time from when an item was due until it started to run
+    trace_latency_histogram lag;
+    /// time each item took to run
+    trace_latency_histogram run;
+};
+
+struct trace_scheduler_snapshot
+{
+    std::vector<trace_worker_snapshot> workers;
+
+    /// totals for the workers that have been destroyed
+    std::uint64_t retired_workers;
+    std::uint64_t retired_enqueued;
+    std::uint64_t retired_executed;
+    std::uint64_t retired_dropped;
+};
+
+namespace detail {
+
+struct trace_worker_metrics
+{
+    typedef trace_latency_histogram histogram_type;
+
+    explicit trace_worker_metrics(std::uint64_t id)
+        : id(id)
+        , depth(0)
+        , max_depth(0)
+        , enqueued(0)
+        , executed(0)
+        , dropped(0)
+        , started(0)
+    {
+        for (auto& b : lag) {
+            b.store(0, std::memory_order_relaxed);
+        }
+        for (auto& b : run) {
+            b.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    static void record(std::atomic<std::uint64_t>* buckets, std::chrono::nanoseconds d) {
+        auto ns = d.count() < 0 ? std::uint64_t(0) : static_cast<std::uint64_t>(d.count());
+        buckets[histogram_type::index_of(ns)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void set_depth(std::size_t d) {
+        depth.store(d, std::memory_order_relaxed);
+        auto m = max_depth.load(std::memory_order_relaxed);
+        while (d > m && !max_depth.compare_exchange_weak(m, d, std::memory_order_relaxed)) {
+        }
+    }
+
+    trace_worker_snapshot snapshot() const {
+        trace_worker_snapshot s;
+        s.id = id;
+        s.depth = depth.load(std::memory_order_relaxed);
+        s.max_depth = max_depth.load(std::memory_order_relaxed);
+        s.enqueued = enqueued.load(std::memory_order_relaxed);
+        s.executed = executed.load(std::memory_order_relaxed);
+        s.dropped = dropped.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < histogram_type::bucket_count; ++i) {
+            s.lag.counts[i] = lag[i].load(std::memory_order_relaxed);
+            s.run.counts[i] = run[i].load(std::memory_order_relaxed);
+        }
+        return s;
+    }
+
+    const std::uint64_t id;
+    std::atomic<std::size_t> depth;
+    std::atomic<std::size_t> max_depth;
+    std::atomic<std::uint64_t> enqueued;
+    std::atomic<std::uint64_t> executed;
+    std::atomic<std::uint64_t> dropped;
+    /// steady_clock ticks when the current action started
+    std::atomic<std::int64_t> started;
+    std::atomic<std::uint64_t> lag[histogram_type::bucket_count];
+    std::atomic<std::uint64_t> run[histogram_type::bucket_count];
+};
+
+struct trace_worker_registry
+{
+    typedef std::shared_ptr<trace_worker_metrics> metrics_ptr;
+
+    trace_worker_registry()
+        : next_id(0)
+        , retired_workers(0)
+        , retired_enqueued(0)
+        , retired_executed(0)
+        , retired_dropped(0)
+    {
+    }
+
+    /// workers can outlive every other static (a detached new_thread),
+    /// so the registry is never destroyed.
+    static trace_worker_registry& instance() {
+        static trace_worker_registry* registry = new trace_worker_registry();
+        return *registry;
+    }
+
+    metrics_ptr add() {
+        std::unique_lock<std::mutex> guard(lock);
+        auto m = std::make_shared<trace_worker_metrics>(++next_id);
+        workers[m->id] = m;
+        return m;
+    }
+
+    void retire(const metrics_ptr& m) {
+        std::unique_lock<std::mutex> guard(lock);
+        workers.erase(m->id);
+        ++retired_workers;
+        retired_enqueued += m->enqueued.load(std::memory_order_relaxed);
+        retired_executed += m->executed.load(std::memory_order_relaxed);
+        retired_dropped += m->dropped.load(std::memory_order_relaxed);
+    }
+
+    trace_scheduler_snapshot snapshot() const {
+        std::vector<metrics_ptr> live;
+        trace_scheduler_snapshot s;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            live.reserve(workers.size());
+            for (auto& w : workers) {
+                live.push_back(w.second);
+            }
+            s.retired_workers = retired_workers;
+            s.retired_enqueued = retired_enqueued;
+            s.retired_executed = retired_executed;
+            s.retired_dropped = retired_dropped;
+        }
+        // the buckets are read outside the lock so that workers are never
+        // blocked from being created or destroyed by a poller.
+        s.workers.reserve(live.size());
+        for (auto& w : live) {
+            s.workers.push_back(w->snapshot());
+        }
+        return s;
+    }
+
+    mutable std::mutex lock;
+    std::uint64_t next_id;
+    std::map<std::uint64_t, metrics_ptr> workers;
+    std::uint64_t retired_workers;
+    std::uint64_t retired_enqueued;
+    std::uint64_t retired_executed;
+    std::uint64_t retired_dropped;
+};
+
+}
+
+/// trace_scheduler_metrics records the health of the new_thread, event_loop
+/// and run_loop worker queues: queue depth, the lag from when an item was
+/// due until it ran, how long each item ran and how many cancelled items
+/// were dropped.
+///
+/// recording only touches relaxed atomics owned by the worker, so it never
+/// takes a lock. snapshot() copies the counters of every live worker and is
+/// intended to be polled at a low rate (once per second).
+///
+/// \code
+/// #include "rxcpp/rx-trace-metrics.hpp"
+/// auto rxcpp_trace_activity(rxcpp::trace_tag) -> rxcpp::trace_scheduler_metrics;
+/// #include "rxcpp/rx.hpp"
+///
+/// auto s = rxcpp::trace_activity().snapshot();
+/// \endcode
+struct trace_scheduler_metrics : public trace_noop
+{
+    typedef std::chrono::steady_clock clock_type;
+
+    /// held by each worker queue for as long as the queue exists
+    struct worker_data
+    {
+    private:
+        typedef worker_data this_type;
+        worker_data(const this_type&);
+        this_type& operator=(const this_type&);
+
+    public:
+        worker_data()
+            : metrics(detail::trace_worker_registry::instance().add())
+        {
+        }
+        ~worker_data()
+        {
+            detail::trace_worker_registry::instance().retire(metrics);
+        }
+
+        std::shared_ptr<detail::trace_worker_metrics> metrics;
+    };
+
+    inline void worker_enqueue(worker_data& w, std::size_t depth) {
+        w.metrics->enqueued.fetch_add(1, std::memory_order_relaxed);
+        w.metrics->set_depth(depth);
+    }
+
+    inline void worker_action_enter(worker_data& w, clock_type::time_point when, std::size_t depth) {
+        auto now = clock_type::now();
+        auto& m = *w.metrics;
+        m.set_depth(depth);
+        detail::trace_worker_metrics::record(m.lag, std::chrono::duration_cast<std::chrono::nanoseconds>(now - when));
+        m.started.store(std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count(), std::memory_order_relaxed);
+    }
+
+    inline void worker_action_return(worker_data& w) {
+        auto& m = *w.metrics;
+        auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch());
+        detail::trace_worker_metrics::record(m.run, now - std::chrono::nanoseconds(m.started.load(std::memory_order_relaxed)));
+        m.executed.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline void worker_drop(worker_data& w, std::size_t count) {
+        w.metrics->dropped.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    trace_scheduler_snapshot snapshot() const {
+        return detail::trace_worker_registry::instance().snapshot();
+    }
+};
+
+}
+
+#endif
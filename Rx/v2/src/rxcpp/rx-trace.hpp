@@ -57,6 +57,17 @@ struct trace_noop
     template<class Schedulable>
     inline void action_recurse(const Schedulable&) {}
 
+    // each worker queue (new_thread, run_loop) holds one worker_data
+    struct worker_data {};
+    template<class WorkerData>
+    inline void worker_enqueue(WorkerData&, std::size_t) {}
+    template<class WorkerData, class When>
+    inline void worker_action_enter(WorkerData&, const When&, std::size_t) {}
+    template<class WorkerData>
+    inline void worker_action_return(WorkerData&) {}
+    template<class WorkerData>
+    inline void worker_drop(WorkerData&, std::size_t) {}
+
     template<class Observable, class Subscriber>
     inline void subscribe_enter(const Observable& , const Subscriber& ) {}
     template<class Observable>
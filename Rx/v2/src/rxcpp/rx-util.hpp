@@ -59,7 +59,7 @@ std::vector<T> to_vector(std::initializer_list<T> il) {
 }
 
 template<class T0, class... TN>
-typename std::enable_if<!std::is_array<T0>::value && std::is_pod<T0>::value, std::vector<T0>>::type to_vector(T0 t0, TN... tn) {
+typename std::enable_if<!std::is_array<T0>::value && std::is_trivial<T0>::value && std::is_standard_layout<T0>::value, std::vector<T0>>::type to_vector(T0 t0, TN... tn) {
     return to_vector({t0, tn...});
 }
 
@@ -684,6 +684,183 @@ public:
 }
 using detail::maybe;
 
+/// a fixed-capacity fifo. the storage grows with the items that are pushed
+/// until it reaches capacity and is then reused in place, so a full buffer
+/// never allocates. items are moved in and out and each one is constructed
+/// in its slot, so T only needs to be move constructible. a capacity of
+/// std::numeric_limits<std::size_t>::max() makes an unbounded fifo that
+/// reuses the slots freed by pop_front().
+template<class T>
+class ring_buffer
+{
+    struct alignas(T) slot_type
+    {
+        unsigned char bytes[sizeof(T)];
+    };
+
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    explicit ring_buffer(size_type capacity)
+        : limit(capacity)
+        , allocated(0)
+        , head(0)
+        , count(0)
+    {
+    }
+
+    ring_buffer(const ring_buffer& o)
+        : limit(o.limit)
+        , allocated(0)
+        , head(0)
+        , count(0)
+    {
+        reallocate(o.count);
+        for (size_type i = 0; i < o.count; ++i) {
+            ::new (at(i)) T(*o.at(o.slot(i)));
+            ++count;
+        }
+    }
+
+    ring_buffer(ring_buffer&& o)
+        : slots(std::move(o.slots))
+        , limit(o.limit)
+        , allocated(o.allocated)
+        , head(o.head)
+        , count(o.count)
+    {
+        o.allocated = 0;
+        o.head = 0;
+        o.count = 0;
+    }
+
+    ring_buffer& operator=(ring_buffer o) {
+        using std::swap;
+        swap(slots, o.slots);
+        swap(limit, o.limit);
+        swap(allocated, o.allocated);
+        swap(head, o.head);
+        swap(count, o.count);
+        return *this;
+    }
+
+    ~ring_buffer() {
+        clear();
+    }
+
+    size_type capacity() const {
+        return limit;
+    }
+    size_type size() const {
+        return count;
+    }
+    bool empty() const {
+        return count == 0;
+    }
+    bool full() const {
+        return count == limit;
+    }
+
+    /// the oldest item
+    T& front() {
+        return *at(head);
+    }
+
+    /// requires !full()
+    void push_back(T v) {
+        if (count == allocated) {
+            // grow geometrically, but never past capacity
+            size_type grown = allocated < 8 ? 16 : allocated * 2;
+            reallocate(grown < limit ? grown : limit);
+        }
+        ::new (at(slot(count))) T(std::move(v));
+        ++count;
+    }
+
+    /// requires !empty(). removes the oldest item and returns it.
+    T pop_front() {
+        T oldest = std::move(*at(head));
+        destroy_front();
+        if (count == 0) {
+            head = 0;
+        }
+        return oldest;
+    }
+
+    /// requires full(). replaces the oldest item with v and returns the
+    /// oldest item.
+    T rotate(T v) {
+        T oldest = std::move(*at(head));
+        destroy_front();
+        // the freed slot is the next one that push_back fills
+        push_back(std::move(v));
+        return oldest;
+    }
+
+    /// requires full(). replaces the oldest item with v.
+    void overwrite(T v) {
+        destroy_front();
+        push_back(std::move(v));
+    }
+
+    /// moves each item, oldest first, to f and leaves the buffer empty.
+    template<class F>
+    void drain(F&& f) {
+        while (count != 0) {
+            f(std::move(*at(head)));
+            destroy_front();
+        }
+        slots.reset();
+        allocated = 0;
+        head = 0;
+    }
+
+private:
+    T* at(size_type i) {
+        return reinterpret_cast<T*>(slots.get() + i);
+    }
+    const T* at(size_type i) const {
+        return reinterpret_cast<const T*>(slots.get() + i);
+    }
+    size_type slot(size_type offset) const {
+        auto i = head + offset;
+        return i < allocated ? i : i - allocated;
+    }
+    void destroy_front() {
+        at(head)->~T();
+        if (++head == allocated) {
+            head = 0;
+        }
+        --count;
+    }
+    void clear() {
+        while (count != 0) {
+            destroy_front();
+        }
+    }
+    // moves the items, oldest first, to the start of new storage
+    void reallocate(size_type size) {
+        std::unique_ptr<slot_type[]> grown(new slot_type[size]);
+        auto to = reinterpret_cast<T*>(grown.get());
+        size_type moved = 0;
+        for (; moved < count; ++moved) {
+            ::new (to + moved) T(std::move(*at(slot(moved))));
+        }
+        clear();
+        slots = std::move(grown);
+        allocated = size;
+        head = 0;
+        count = moved;
+    }
+
+    std::unique_ptr<slot_type[]> slots;
+    size_type limit;
+    size_type allocated;
+    size_type head;
+    size_type count;
+};
+
 namespace detail {
     struct surely
     {
@@ -706,6 +883,30 @@ inline auto surely(const std::tuple<T...>& tpl)
     return      apply(tpl, detail::surely());
 }
 
+namespace detail {
+template<class F, class... T, int... IndexN>
+auto apply_surely(const std::tuple<T...>& tpl, values<int, IndexN...>, F& f, int)
+    -> decltype(f(std::get<IndexN>(tpl).get()...)) {
+    return      f(std::get<IndexN>(tpl).get()...);
+}
+// f takes a non-const reference, so it is given copies that it may change
+template<class F, class... T, int... IndexN>
+auto apply_surely(const std::tuple<T...>& tpl, values<int, IndexN...>, F& f, long)
+    -> decltype(f(std::declval<decay_t<decltype(std::get<IndexN>(tpl).get())>&>()...)) {
+    auto copies = rxcpp::util::surely(tpl);
+    return      f(std::get<IndexN>(copies)...);
+}
+}
+
+/// call f with a const reference to the value of each maybe in tpl.
+/// unlike apply(surely(tpl), f) no value is copied, unless f only accepts
+/// non-const references.
+template<class F, class... T>
+inline auto apply_surely(const std::tuple<T...>& tpl, F& f)
+    -> decltype(detail::apply_surely(tpl, typename values_from<int, sizeof...(T)>::type(), f, 0)) {
+    return      detail::apply_surely(tpl, typename values_from<int, sizeof...(T)>::type(), f, 0);
+}
+
 namespace detail {
 
 template<typename Function>
@@ -0,0 +1,242 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_SCHEDULER_COALESCING_HPP)
+#define RXCPP_RX_SCHEDULER_COALESCING_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace schedulers {
+
+namespace detail {
+
+struct coalescing_state : public std::enable_shared_from_this<coalescing_state>
+{
+    typedef scheduler::clock_type clock_type;
+
+    struct entry_type
+    {
+        entry_type(schedulable w, composite_subscription::weak_subscription t)
+            : what(std::move(w))
+            , token(std::move(t))
+        {
+        }
+        schedulable what;
+        /// removes this entry from the batch when what is unsubscribed
+        composite_subscription::weak_subscription token;
+    };
+    /// keyed by the order of push, so that a batch runs in that order
+    typedef std::map<std::uint64_t, entry_type> batch_type;
+    typedef std::map<clock_type::time_point, batch_type> ticks_type;
+
+    virtual ~coalescing_state()
+    {
+    }
+
+    coalescing_state(worker w, clock_type::duration g)
+        : source(std::move(w))
+        , granularity(std::max(g, clock_type::duration(1)))
+        , next_id(0)
+    {
+    }
+
+    /// round up to the next tick so that an action never runs early
+    clock_type::time_point tick_for(clock_type::time_point when) const {
+        auto since = when.time_since_epoch();
+        auto ticks = since / granularity;
+        if (since % granularity != clock_type::duration::zero()) {
+            ++ticks;
+        }
+        return clock_type::time_point(ticks * granularity);
+    }
+
+    void push(clock_type::time_point when, const schedulable& scbl) {
+        auto tick = tick_for(when);
+        std::weak_ptr<coalescing_state> weak = shared_from_this();
+        std::uint64_t id = 0;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            id = ++next_id;
+        }
+        // a cancelled action is removed from its batch right away, so that
+        // timeouts that are re-armed on every item do not pile up until
+        // their tick.
+        auto token = scbl.add([weak, tick, id](){
+            auto that = weak.lock();
+            if (!!that) {
+                that->erase(tick, id);
+            }
+        });
+        bool first = false;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            // erase() takes the lock, so either it already ran or it will
+            // find this entry.
+            if (!scbl.is_subscribed()) {
+                return;
+            }
+            auto& batch = ticks[tick];
+            first = batch.empty();
+            batch.insert(std::make_pair(id, entry_type(scbl, std::move(token))));
+        }
+        if (first) {
+            // one wakeup on the shared source runs every action due in this tick
+            source.schedule(tick, [weak, tick](const schedulable&){
+                auto that = weak.lock();
+                if (!!that) {
+                    that->run(tick);
+                }
+            });
+        }
+    }
+
+    void run(clock_type::time_point tick) {
+        batch_type batch;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            auto found = ticks.find(tick);
+            if (found == ticks.end()) {
+                return;
+            }
+            batch = std::move(found->second);
+            ticks.erase(found);
+        }
+        for (auto& e : batch) {
+            auto& what = e.second.what;
+            what.remove(e.second.token);
+            if (!what.is_subscribed()) {
+                continue;
+            }
+            // any recursion requests will be pushed to the source
+            recursion r(false);
+            what(r.get_recurse());
+        }
+    }
+
+    void erase(clock_type::time_point tick, std::uint64_t id) {
+        std::unique_lock<std::mutex> guard(lock);
+        auto found = ticks.find(tick);
+        if (found == ticks.end()) {
+            return;
+        }
+        found->second.erase(id);
+        if (found->second.empty()) {
+            // the wakeup for this tick will find nothing to run
+            ticks.erase(found);
+        }
+    }
+
+    /// the number of actions waiting for their tick
+    std::size_t pending() const {
+        std::unique_lock<std::mutex> guard(lock);
+        std::size_t count = 0;
+        for (auto& t : ticks) {
+            count += t.second.size();
+        }
+        return count;
+    }
+
+    worker source;
+    clock_type::duration granularity;
+    mutable std::mutex lock;
+    std::uint64_t next_id;
+    ticks_type ticks;
+};
+
+}
+
+/// coalescing rounds the due time of every action up to the next tick of
+/// the granularity. all the actions that are due in the same tick are run
+/// in one batch from one wakeup on a single worker of the inner scheduler.
+struct coalescing : public scheduler_interface
+{
+private:
+    typedef coalescing this_type;
+    coalescing(const this_type&);
+
+    struct coalescing_worker : public worker_interface
+    {
+    private:
+        typedef coalescing_worker this_type;
+        coalescing_worker(const this_type&);
+
+        composite_subscription lifetime;
+        std::shared_ptr<detail::coalescing_state> state;
+        std::shared_ptr<const scheduler_interface> alive;
+
+    public:
+        virtual ~coalescing_worker()
+        {
+        }
+        coalescing_worker(composite_subscription cs, std::shared_ptr<detail::coalescing_state> st, std::shared_ptr<const scheduler_interface> alive)
+            : lifetime(cs)
+            , state(std::move(st))
+            , alive(alive)
+        {
+            auto token = state->source.add(cs);
+            auto w = state->source;
+            cs.add([token, w](){
+                w.remove(token);
+            });
+        }
+
+        virtual clock_type::time_point now() const {
+            return state->source.now();
+        }
+
+        virtual void schedule(const schedulable& scbl) const {
+            if (scbl.is_subscribed()) {
+                // actions that are due now are not delayed to the next tick
+                auto what = scbl;
+                state->source.schedule(lifetime, [what](const schedulable&){
+                    // any recursion requests will be pushed to the source
+                    recursion r(false);
+                    what(r.get_recurse());
+                });
+            }
+        }
+
+        virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
+            if (scbl.is_subscribed()) {
+                state->push(when, scbl);
+            }
+        }
+    };
+
+    composite_subscription source_lifetime;
+    std::shared_ptr<detail::coalescing_state> state;
+
+public:
+    coalescing(scheduler inner, clock_type::duration granularity)
+        : state(std::make_shared<detail::coalescing_state>(inner.create_worker(source_lifetime), granularity))
+    {
+    }
+    virtual ~coalescing()
+    {
+        source_lifetime.unsubscribe();
+    }
+
+    virtual clock_type::time_point now() const {
+        return state->source.now();
+    }
+
+    virtual worker create_worker(composite_subscription cs) const {
+        return worker(cs, std::make_shared<coalescing_worker>(cs, state, this->shared_from_this()));
+    }
+};
+
+/// all the workers created from the returned scheduler share a single worker
+/// of the inner scheduler and fire their timed actions in batches, once per
+/// tick of the granularity.
+inline scheduler make_coalescing(scheduler inner, scheduler::clock_type::duration granularity) {
+    return make_scheduler<coalescing>(std::move(inner), granularity);
+}
+
+}
+
+}
+
+#endif
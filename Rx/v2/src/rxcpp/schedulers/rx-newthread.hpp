@@ -50,6 +50,7 @@ private:
             mutable queue_item_time q;
             std::thread worker;
             recursion r;
+            trace_activity_type::worker_data trace;
         };
 
         std::shared_ptr<new_worker_state> state;
@@ -74,6 +75,7 @@ private:
                 auto expired = std::move(keepAlive->q);
                 keepAlive->q = new_worker_state::queue_item_time{};
                 if (!keepAlive->q.empty()) std::terminate();
+                trace_activity().worker_drop(keepAlive->trace, expired.size());
                 keepAlive->wake.notify_one();
 
                 if (keepAlive->worker.joinable() && keepAlive->worker.get_id() != std::this_thread::get_id()) {
@@ -107,17 +109,23 @@ private:
                     auto& peek = keepAlive->q.top();
                     if (!peek.what.is_subscribed()) {
                         keepAlive->q.pop();
+                        trace_activity().worker_drop(keepAlive->trace, 1);
                         continue;
                     }
                     if (clock_type::now() < peek.when) {
-                        keepAlive->wake.wait_until(guard, peek.when);
+                        // a push while waiting may move peek, so wait on a copy
+                        auto due = peek.when;
+                        keepAlive->wake.wait_until(guard, due);
                         continue;
                     }
                     auto what = peek.what;
+                    auto when = peek.when;
                     keepAlive->q.pop();
+                    trace_activity().worker_action_enter(keepAlive->trace, when, keepAlive->q.size());
                     keepAlive->r.reset(keepAlive->q.empty());
                     guard.unlock();
                     what(keepAlive->r.get_recurse());
+                    trace_activity().worker_action_return(keepAlive->trace);
                 }
             });
         }
@@ -133,7 +141,13 @@ private:
         virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
             if (scbl.is_subscribed()) {
                 std::unique_lock<std::mutex> guard(state->lock);
+                // a push may compact cancelled items out of the queue
+                auto expected = state->q.size() + 1;
                 state->q.push(new_worker_state::item_type(when, scbl));
+                if (state->q.size() < expected) {
+                    trace_activity().worker_drop(state->trace, expected - state->q.size());
+                }
+                trace_activity().worker_enqueue(state->trace, state->q.size());
                 state->r.reset(false);
             }
             state->wake.notify_one();
@@ -0,0 +1,585 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_SCHEDULER_PARALLEL_TEST_HPP)
+#define RXCPP_RX_SCHEDULER_PARALLEL_TEST_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace schedulers {
+
+namespace detail {
+
+// runs the groups of one virtual time tick. the thread that advances the
+// clock runs groups as well, so concurrency - 1 threads are started.
+class parallel_test_pool
+{
+    typedef std::function<void(std::size_t)> job_type;
+
+    std::mutex lock;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::vector<std::thread> threads;
+    const job_type* job;
+    std::size_t jobs;
+    std::atomic<std::size_t> next;
+    std::size_t finished;
+    std::size_t active;
+    std::size_t round;
+    bool stopping;
+    rxu::error_ptr error;
+
+    parallel_test_pool(const parallel_test_pool&);
+
+    // runs jobs of the current round until there are none left
+    void work(const job_type& f, std::size_t count) {
+        for (;;) {
+            auto i = next++;
+            if (i >= count) {
+                break;
+            }
+            RXCPP_TRY {
+                f(i);
+            } RXCPP_CATCH(...) {
+                std::unique_lock<std::mutex> guard(lock);
+                if (!error) {
+                    error = rxu::current_exception();
+                }
+            }
+            std::unique_lock<std::mutex> guard(lock);
+            if (++finished == jobs) {
+                idle.notify_all();
+            }
+        }
+    }
+
+    void loop() {
+        std::size_t seen = 0;
+        std::unique_lock<std::mutex> guard(lock);
+        for (;;) {
+            wake.wait(guard, [&](){
+                return stopping || round != seen;
+            });
+            if (stopping) {
+                return;
+            }
+            seen = round;
+            if (!job) {
+                continue;
+            }
+            auto f = job;
+            auto count = jobs;
+            ++active;
+            guard.unlock();
+            work(*f, count);
+            guard.lock();
+            if (--active == 0) {
+                idle.notify_all();
+            }
+        }
+    }
+
+public:
+    explicit parallel_test_pool(std::size_t concurrency)
+        : job(nullptr)
+        , jobs(0)
+        , next(0)
+        , finished(0)
+        , active(0)
+        , round(0)
+        , stopping(false)
+    {
+        for (std::size_t i = 1; i < concurrency; ++i) {
+            threads.push_back(std::thread([this](){loop();}));
+        }
+    }
+    ~parallel_test_pool() {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            stopping = true;
+            wake.notify_all();
+        }
+        for (auto& t : threads) {
+            if (t.get_id() == std::this_thread::get_id()) {
+                t.detach();
+            } else {
+                t.join();
+            }
+        }
+    }
+
+    /// calls f(0) .. f(count - 1) across the threads and returns when all have returned.
+    void run(std::size_t count, const job_type& f) {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            job = &f;
+            jobs = count;
+            next = 0;
+            finished = 0;
+            ++round;
+            wake.notify_all();
+        }
+        work(f, count);
+        rxu::error_ptr e;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            idle.wait(guard, [&](){
+                return finished == jobs && active == 0;
+            });
+            job = nullptr;
+            std::swap(e, error);
+        }
+        if (e) {
+            rxu::rethrow_exception(e);
+        }
+    }
+};
+
+class parallel_test_type : public scheduler_interface
+{
+public:
+    typedef scheduler_interface::clock_type clock_type;
+    typedef long absolute;
+    typedef long relative;
+
+    struct item_type
+    {
+        item_type(absolute when, std::size_t worker, schedulable what)
+            : when(when)
+            , ordinal(0)
+            , worker(worker)
+            , what(std::move(what))
+        {
+        }
+        absolute when;
+        int64_t ordinal;
+        std::size_t worker;
+        schedulable what;
+    };
+
+    struct item_later
+    {
+        bool operator()(const item_type& lhs, const item_type& rhs) const {
+            if (lhs.when == rhs.when) {
+                return lhs.ordinal > rhs.ordinal;
+            }
+            return lhs.when > rhs.when;
+        }
+    };
+
+    struct parallel_test_state;
+
+    // the items scheduled and the workers created by the actions of one
+    // worker during a tick. they are queued and numbered after the tick, in
+    // worker order, so that neither depends on the threads.
+    struct tick_context
+    {
+        const parallel_test_state* owner;
+        std::vector<item_type> scheduled;
+        std::vector<std::shared_ptr<std::size_t>> created;
+    };
+
+    // marks the ids of the workers created during a tick until the tick ends
+    static const std::size_t pending_worker = std::size_t(1) << (sizeof(std::size_t) * 8 - 1);
+
+private:
+#if defined(RXCPP_THREAD_LOCAL)
+    static tick_context*& current_tick_context() {
+        static RXCPP_THREAD_LOCAL tick_context* c;
+        return c;
+    }
+#else
+    static rxu::thread_local_storage<tick_context>& current_tick_context() {
+        static rxu::thread_local_storage<tick_context> c;
+        return c;
+    }
+#endif
+
+public:
+    struct parallel_test_state : public std::enable_shared_from_this<parallel_test_state>
+    {
+        explicit parallel_test_state(std::size_t concurrency)
+            : concurrency(concurrency == 0 ? 1 : concurrency)
+            , isenabled(false)
+            , clock_now(0)
+            , ordinal(0)
+            , workers(0)
+            , pending_workers(0)
+        {
+        }
+
+        std::size_t concurrency;
+        mutable bool isenabled;
+        mutable absolute clock_now;
+        mutable std::mutex lock;
+        mutable std::priority_queue<item_type, std::vector<item_type>, item_later> q;
+        mutable int64_t ordinal;
+        mutable std::size_t workers;
+        mutable std::atomic<std::size_t> pending_workers;
+        mutable std::unique_ptr<parallel_test_pool> pool;
+
+        clock_type::time_point now() const {
+            return to_time_point(clock_now);
+        }
+
+        clock_type::time_point to_time_point(absolute a) const {
+            return clock_type::time_point(std::chrono::milliseconds(a));
+        }
+
+        relative to_relative(clock_type::duration d) const {
+            return static_cast<relative>(std::chrono::duration_cast<std::chrono::milliseconds>(d).count());
+        }
+
+        absolute clock() const {
+            return clock_now;
+        }
+
+        bool is_enabled() const {
+            return isenabled;
+        }
+
+        // the id is shared with the worker so that an id given out during a
+        // tick can be replaced once the tick ends.
+        std::shared_ptr<std::size_t> create_worker_id() const {
+            auto& context = current_tick_context();
+            if (!!context && context->owner == this) {
+                auto id = std::make_shared<std::size_t>(pending_worker | pending_workers++);
+                context->created.push_back(id);
+                return id;
+            }
+            std::unique_lock<std::mutex> guard(lock);
+            return std::make_shared<std::size_t>(++workers);
+        }
+
+        void schedule_absolute(absolute when, std::size_t worker, const schedulable& a) const
+        {
+            if (when <= clock_now)
+                when = clock_now + 1;
+
+            // use a separate subscription here so that a's subscription is not affected
+            auto run = make_schedulable(
+                a.get_worker(),
+                composite_subscription(),
+                [a](const schedulable& scbl) {
+                    rxsc::recursion r;
+                    r.reset(false);
+                    if (scbl.is_subscribed()) {
+                        scbl.unsubscribe(); // unsubscribe() run, not a;
+                        a(r.get_recurse());
+                    }
+                });
+
+            auto& context = current_tick_context();
+            if (!!context && context->owner == this) {
+                context->scheduled.push_back(item_type(when, worker, std::move(run)));
+                return;
+            }
+            std::unique_lock<std::mutex> guard(lock);
+            item_type item(when, worker, std::move(run));
+            item.ordinal = ordinal++;
+            q.push(std::move(item));
+        }
+
+        void schedule_relative(relative when, std::size_t worker, const schedulable& a) const {
+            schedule_absolute(clock_now + when, worker, a);
+        }
+
+        // runs the ticks up to and including time. empty ranges of time
+        // are skipped, since the next tick is always at the top of the queue.
+        void run_until(absolute time, bool bounded) const
+        {
+            if (isenabled) {
+                std::terminate();
+            }
+            isenabled = true;
+            std::vector<item_type> tick;
+            while (isenabled) {
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    if (q.empty() || (bounded && q.top().when > time)) {
+                        break;
+                    }
+                    auto when = q.top().when;
+                    if (when > clock_now) {
+                        clock_now = when;
+                    }
+                    tick.clear();
+                    while (!q.empty() && q.top().when == when) {
+                        tick.push_back(q.top());
+                        q.pop();
+                    }
+                }
+                RXCPP_TRY {
+                    run_tick(tick);
+                } RXCPP_CATCH(...) {
+                    isenabled = false;
+                    rxu::rethrow_exception(rxu::current_exception());
+                }
+            }
+            isenabled = false;
+            if (bounded && time > clock_now) {
+                clock_now = time;
+            }
+        }
+
+        // the actions of each worker run in queue order on one thread. the
+        // workers run in parallel.
+        void run_tick(std::vector<item_type>& tick) const
+        {
+            std::stable_sort(tick.begin(), tick.end(), [](const item_type& lhs, const item_type& rhs){
+                return lhs.worker < rhs.worker;
+            });
+
+            std::vector<std::pair<std::size_t, std::size_t>> groups;
+            for (std::size_t i = 0; i != tick.size(); ++i) {
+                if (groups.empty() || tick[groups.back().first].worker != tick[i].worker) {
+                    groups.push_back(std::make_pair(i, i));
+                }
+                groups.back().second = i + 1;
+            }
+
+            std::vector<tick_context> contexts(groups.size(), tick_context{this, std::vector<item_type>(), std::vector<std::shared_ptr<std::size_t>>()});
+
+            std::function<void(std::size_t)> run_group = [&](std::size_t g){
+                auto& context = current_tick_context();
+                context = &contexts[g];
+                for (auto i = groups[g].first; i != groups[g].second; ++i) {
+                    auto& what = tick[i].what;
+                    if (what.is_subscribed()) {
+                        what(recursion(false).get_recurse());
+                    }
+                }
+                context = nullptr;
+            };
+
+            rxu::error_ptr error;
+            RXCPP_TRY {
+                if (groups.size() == 1 || concurrency == 1) {
+                    for (std::size_t g = 0; g != groups.size(); ++g) {
+                        run_group(g);
+                    }
+                } else {
+                    if (!pool) {
+                        pool.reset(new parallel_test_pool(concurrency));
+                    }
+                    pool->run(groups.size(), run_group);
+                }
+            } RXCPP_CATCH(...) {
+                current_tick_context() = nullptr;
+                error = rxu::current_exception();
+            }
+
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                // number the workers created during the tick in worker order
+                std::map<std::size_t, std::size_t> created;
+                for (auto& context : contexts) {
+                    for (auto& id : context.created) {
+                        auto final_id = ++workers;
+                        created[*id] = final_id;
+                        *id = final_id;
+                    }
+                }
+                for (auto& context : contexts) {
+                    for (auto& item : context.scheduled) {
+                        if (item.worker & pending_worker) {
+                            item.worker = created[item.worker];
+                        }
+                        item.ordinal = ordinal++;
+                        q.push(std::move(item));
+                    }
+                }
+                pending_workers = 0;
+            }
+
+            if (error) {
+                rxu::rethrow_exception(error);
+            }
+        }
+    };
+
+private:
+    mutable std::shared_ptr<parallel_test_state> state;
+
+public:
+    struct parallel_test_worker : public worker_interface
+    {
+        mutable std::shared_ptr<parallel_test_state> state;
+        std::shared_ptr<std::size_t> id;
+
+        explicit parallel_test_worker(std::shared_ptr<parallel_test_state> st)
+            : state(std::move(st))
+            , id(state->create_worker_id())
+        {
+        }
+
+        virtual clock_type::time_point now() const {
+            return state->now();
+        }
+
+        virtual void schedule(const schedulable& scbl) const {
+            state->schedule_absolute(state->clock(), *id, scbl);
+        }
+
+        virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
+            state->schedule_relative(state->to_relative(when - now()), *id, scbl);
+        }
+
+        void schedule_absolute(absolute when, const schedulable& scbl) const {
+            state->schedule_absolute(when, *id, scbl);
+        }
+
+        void schedule_relative(relative when, const schedulable& scbl) const {
+            state->schedule_relative(when, *id, scbl);
+        }
+    };
+
+    explicit parallel_test_type(std::size_t concurrency)
+        : state(std::make_shared<parallel_test_state>(concurrency))
+    {
+    }
+
+    virtual clock_type::time_point now() const {
+        return state->now();
+    }
+
+    virtual worker create_worker(composite_subscription cs) const {
+        return worker(cs, std::make_shared<parallel_test_worker>(state));
+    }
+
+    std::shared_ptr<parallel_test_worker> create_parallel_test_worker_interface() const {
+        return std::make_shared<parallel_test_worker>(state);
+    }
+
+    const std::shared_ptr<parallel_test_state>& get_state() const {
+        return state;
+    }
+};
+
+}
+
+/*!
+    \brief a virtual time scheduler for large simulations. the actions that are due at the same tick run in parallel, one thread per worker at a time.
+
+    As with the test scheduler, an action scheduled at or before the current tick is moved to the next
+    tick, so the actions of a tick are known before it starts. The actions of each worker run in the order
+    they were scheduled and never run concurrently with each other. The actions scheduled and the workers
+    created during a tick are queued and numbered in worker order once the tick has finished, so the order
+    of every later tick does not depend on the threads.
+
+    Time that has nothing scheduled is skipped: start() and advance_to() move the clock straight to the
+    next tick in the queue.
+
+    \ingroup group-scheduler
+*/
+class parallel_test : public scheduler
+{
+    std::shared_ptr<detail::parallel_test_type> tester;
+
+    typedef detail::parallel_test_type::parallel_test_state state_type;
+
+    const std::shared_ptr<state_type>& state() const {
+        return tester->get_state();
+    }
+
+public:
+    explicit parallel_test(std::shared_ptr<detail::parallel_test_type> t)
+        : scheduler(std::static_pointer_cast<scheduler_interface>(t))
+        , tester(t)
+    {
+    }
+
+    typedef detail::parallel_test_type::clock_type clock_type;
+
+    class test_worker : public worker
+    {
+        std::shared_ptr<detail::parallel_test_type::parallel_test_worker> tester;
+    public:
+
+        explicit test_worker(composite_subscription cs, std::shared_ptr<detail::parallel_test_type::parallel_test_worker> t)
+            : worker(cs, std::static_pointer_cast<worker_interface>(t))
+            , tester(t)
+        {
+        }
+
+        bool is_enabled() const {return tester->state->is_enabled();}
+        long clock() const {return tester->state->clock();}
+
+        void schedule_absolute(long when, const schedulable& a) const {
+            tester->schedule_absolute(when, a);
+        }
+
+        void schedule_relative(long when, const schedulable& a) const {
+            tester->schedule_relative(when, a);
+        }
+
+        template<class Arg0, class... ArgN>
+        auto schedule_absolute(long when, Arg0&& a0, ArgN&&... an) const
+            -> typename std::enable_if<
+                (detail::is_action_function<Arg0>::value ||
+                is_subscription<Arg0>::value) &&
+                !is_schedulable<Arg0>::value>::type {
+            tester->schedule_absolute(when, make_schedulable(*this, std::forward<Arg0>(a0), std::forward<ArgN>(an)...));
+        }
+
+        template<class Arg0, class... ArgN>
+        auto schedule_relative(long when, Arg0&& a0, ArgN&&... an) const
+            -> typename std::enable_if<
+                (detail::is_action_function<Arg0>::value ||
+                is_subscription<Arg0>::value) &&
+                !is_schedulable<Arg0>::value>::type {
+            tester->schedule_relative(when, make_schedulable(*this, std::forward<Arg0>(a0), std::forward<ArgN>(an)...));
+        }
+    };
+
+    clock_type::time_point now() const {
+        return tester->now();
+    }
+
+    test_worker create_worker(composite_subscription cs = composite_subscription()) const {
+        return test_worker(cs, tester->create_parallel_test_worker_interface());
+    }
+
+    bool is_enabled() const {return state()->is_enabled();}
+    long clock() const {return state()->clock();}
+
+    clock_type::time_point to_time_point(long absolute) const {
+        return state()->to_time_point(absolute);
+    }
+
+    /// runs the actions until the queue is empty or stop() is called.
+    void start() const {
+        state()->run_until(0, false);
+    }
+
+    /// stops start() or advance_to() after the current tick.
+    void stop() const {
+        state()->isenabled = false;
+    }
+
+    /// runs the actions up to and including time and then sets the clock to time.
+    void advance_to(long time) const {
+        if (time < state()->clock()) {
+            std::terminate();
+        }
+        state()->run_until(time, true);
+    }
+
+    void advance_by(long time) const {
+        advance_to(state()->clock() + time);
+    }
+};
+
+/// \a concurrency is the number of threads that run the actions of a tick, including the thread that calls start() or advance_to().
+inline parallel_test make_parallel_test(std::size_t concurrency = std::thread::hardware_concurrency()) {
+    return parallel_test(std::make_shared<detail::parallel_test_type>(concurrency));
+}
+
+}
+
+}
+
+#endif
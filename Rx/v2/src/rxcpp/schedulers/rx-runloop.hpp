@@ -36,6 +36,7 @@ struct run_loop_state : public std::enable_shared_from_this<run_loop_state>
     mutable queue_item_time q;
     recursion r;
     std::function<void(clock_type::time_point)> notify_earlier_wakeup;
+    trace_activity_type::worker_data trace;
 };
 
 }
@@ -80,7 +81,13 @@ private:
                 std::unique_lock<std::mutex> guard(st->lock);
                 const bool need_earlier_wakeup_notification = st->notify_earlier_wakeup &&
                                                               (st->q.empty() || when < st->q.top().when);
+                // a push may compact cancelled items out of the queue
+                auto expected = st->q.size() + 1;
                 st->q.push(detail::run_loop_state::item_type(when, scbl));
+                if (st->q.size() < expected) {
+                    trace_activity().worker_drop(st->trace, expected - st->q.size());
+                }
+                trace_activity().worker_enqueue(st->trace, st->q.size());
                 st->r.reset(false);
                 if (need_earlier_wakeup_notification) st->notify_earlier_wakeup(when);
                 guard.unlock(); // So we can't get attempt to recursively lock the state
@@ -153,6 +160,7 @@ public:
 
         auto expired = std::move(state->q);
         if (!state->q.empty()) std::terminate();
+        trace_activity().worker_drop(state->trace, expired.size());
     }
 
     clock_type::time_point now() const {
@@ -179,16 +187,20 @@ public:
         auto& peek = state->q.top();
         if (!peek.what.is_subscribed()) {
             state->q.pop();
+            trace_activity().worker_drop(state->trace, 1);
             return;
         }
         if (clock_type::now() < peek.when) {
             return;
         }
         auto what = peek.what;
+        auto when = peek.when;
         state->q.pop();
+        trace_activity().worker_action_enter(state->trace, when, state->q.size());
         state->r.reset(state->q.empty());
         guard.unlock();
         what(state->r.get_recurse());
+        trace_activity().worker_action_return(state->trace);
     }
 
     scheduler get_scheduler() const {
@@ -152,8 +152,14 @@ public:
     template<class T>
     rxt::testable_observable<T> make_hot_observable(std::vector<rxn::recorded<std::shared_ptr<rxn::detail::notification_base<T>>>> messages) const;
 
+    template<class T>
+    rxt::testable_observable<T> make_hot_observable(rxn::recorded_sequence<T> messages) const;
+
     template<class T>
     rxt::testable_observable<T> make_cold_observable(std::vector<rxn::recorded<std::shared_ptr<rxn::detail::notification_base<T>>>> messages) const;
+
+    template<class T>
+    rxt::testable_observable<T> make_cold_observable(rxn::recorded_sequence<T> messages) const;
 };
 
 template<class T>
@@ -162,6 +168,7 @@ class mock_observer
 {
     typedef typename rxn::notification<T> notification_type;
     typedef rxn::recorded<typename notification_type::type> recorded_type;
+    typedef rxn::recorded_sequence<T> recorded_sequence_type;
 
 public:
     explicit mock_observer(std::shared_ptr<test_type::test_type_state> sc)
@@ -170,7 +177,7 @@ public:
     }
 
     std::shared_ptr<test_type::test_type_state> sc;
-    std::vector<recorded_type> m;
+    recorded_sequence_type m;
 
     virtual void on_subscribe(subscriber<T>) const {
         std::terminate();
@@ -180,6 +187,10 @@ public:
     }
 
     virtual std::vector<recorded_type> messages() const {
+        return m.messages();
+    }
+
+    virtual const recorded_sequence_type& records() const {
         return m;
     }
 };
@@ -187,32 +198,43 @@ public:
 template<class T>
 subscriber<T, rxt::testable_observer<T>> test_type::test_type_worker::make_subscriber() const
 {
-    typedef typename rxn::notification<T> notification_type;
-    typedef rxn::recorded<typename notification_type::type> recorded_type;
-
     auto ts = std::make_shared<mock_observer<T>>(state);
 
     return rxcpp::make_subscriber<T>(rxt::testable_observer<T>(ts, make_observer_dynamic<T>(
           // on_next
           [ts](T value)
           {
-              ts->m.push_back(
-                              recorded_type(ts->sc->clock(), notification_type::on_next(value)));
+              ts->m.on_next(ts->sc->clock(), std::move(value));
           },
           // on_error
           [ts](rxu::error_ptr e)
           {
-              ts->m.push_back(
-                              recorded_type(ts->sc->clock(), notification_type::on_error(e)));
+              ts->m.on_error(ts->sc->clock(), e);
           },
           // on_completed
           [ts]()
           {
-              ts->m.push_back(
-                              recorded_type(ts->sc->clock(), notification_type::on_completed()));
+              ts->m.on_completed(ts->sc->clock());
           })));
 }
 
+// calls f(when, first, last) for each run of notifications with the same time,
+// so that one action is scheduled for each run instead of one for each notification.
+template<class T, class F>
+void for_each_time(const rxn::recorded_sequence<T>& rs, F f)
+{
+    auto& times = rs.times();
+    auto p = rs.first();
+    while (p.index != rs.size()) {
+        auto first = p;
+        auto when = times[p.index];
+        do {
+            rs.advance(p);
+        } while (p.index != rs.size() && times[p.index] == when);
+        f(when, first, p.index);
+    }
+}
+
 template<class T>
 class cold_observable
     : public rxt::detail::test_subject_base<T>
@@ -220,23 +242,32 @@ class cold_observable
     typedef cold_observable<T> this_type;
     std::shared_ptr<test_type::test_type_state> sc;
     typedef rxn::recorded<typename rxn::notification<T>::type> recorded_type;
-    mutable std::vector<recorded_type> mv;
+    typedef rxn::recorded_sequence<T> recorded_sequence_type;
+    typedef typename recorded_sequence_type::position position_type;
+    recorded_sequence_type mv;
     mutable std::vector<rxn::subscription> sv;
     mutable worker controller;
 
 public:
 
-    cold_observable(std::shared_ptr<test_type::test_type_state> sc, worker w, std::vector<recorded_type> mv)
+    cold_observable(std::shared_ptr<test_type::test_type_state> sc, worker w, recorded_sequence_type mv)
         : sc(sc)
         , mv(std::move(mv))
         , controller(w)
     {
     }
 
+    cold_observable(std::shared_ptr<test_type::test_type_state> sc, worker w, const std::vector<recorded_type>& mv)
+        : sc(sc)
+        , mv(mv)
+        , controller(w)
+    {
+    }
+
     template<class Iterator>
     cold_observable(std::shared_ptr<test_type::test_type_state> sc, worker w, Iterator begin, Iterator end)
         : sc(sc)
-        , mv(begin, end)
+        , mv(std::vector<recorded_type>(begin, end))
         , controller(w)
     {
     }
@@ -245,18 +276,21 @@ public:
         sv.push_back(rxn::subscription(sc->clock()));
         auto index = sv.size() - 1;
 
-        for (auto& message : mv) {
-            auto n = message.value();
-            sc->schedule_relative(message.time(), make_schedulable(
+        auto sharedThis = std::static_pointer_cast<const this_type>(this->shared_from_this());
+
+        for_each_time(mv, [&](long when, position_type first, std::size_t last) {
+            sc->schedule_relative(when, make_schedulable(
                 controller,
-                [n, o](const schedulable&) {
-                    if (o.is_subscribed()) {
-                        n->accept(o);
+                [sharedThis, first, last, o](const schedulable&) {
+                    auto& mv = sharedThis->mv;
+                    for (auto n = first; n.index != last; mv.advance(n)) {
+                        if (o.is_subscribed()) {
+                            mv.accept(n, o);
+                        }
                     }
                 }));
-        }
+        });
 
-        auto sharedThis = std::static_pointer_cast<const this_type>(this->shared_from_this());
         o.add([sharedThis, index]() {
             sharedThis->sv[index] = rxn::subscription(sharedThis->sv[index].subscribe(), sharedThis->sc->clock());
         });
@@ -267,12 +301,22 @@ public:
     }
 
     virtual std::vector<recorded_type> messages() const {
+        return mv.messages();
+    }
+
+    virtual const recorded_sequence_type& records() const {
         return mv;
     }
 };
 
 template<class T>
 rxt::testable_observable<T> test_type::make_cold_observable(std::vector<rxn::recorded<std::shared_ptr<rxn::detail::notification_base<T>>>> messages) const
+{
+    return make_cold_observable(rxn::recorded_sequence<T>(messages));
+}
+
+template<class T>
+rxt::testable_observable<T> test_type::make_cold_observable(rxn::recorded_sequence<T> messages) const
 {
     auto co = std::make_shared<cold_observable<T>>(state, create_worker(composite_subscription()), std::move(messages));
     return rxt::testable_observable<T>(co);
@@ -285,32 +329,40 @@ class hot_observable
     typedef hot_observable<T> this_type;
     std::shared_ptr<test_type::test_type_state> sc;
     typedef rxn::recorded<typename rxn::notification<T>::type> recorded_type;
+    typedef rxn::recorded_sequence<T> recorded_sequence_type;
+    typedef typename recorded_sequence_type::position position_type;
     typedef subscriber<T> observer_type;
-    mutable std::vector<recorded_type> mv;
+    recorded_sequence_type mv;
     mutable std::vector<rxn::subscription> sv;
     mutable std::list<observer_type> observers;
     mutable worker controller;
 
 public:
 
-    hot_observable(std::shared_ptr<test_type::test_type_state> sc, worker w, std::vector<recorded_type> mv)
+    hot_observable(std::shared_ptr<test_type::test_type_state> sc, worker w, recorded_sequence_type rs)
         : sc(sc)
-        , mv(mv)
+        , mv(std::move(rs))
         , controller(w)
     {
-        for (auto& message : mv) {
-            auto n = message.value();
-            sc->schedule_absolute(message.time(), make_schedulable(
+        for_each_time(mv, [&](long when, position_type first, std::size_t last) {
+            sc->schedule_absolute(when, make_schedulable(
                 controller,
-                [this, n](const schedulable&) {
-                    auto local = this->observers;
-                    for (auto& o : local) {
-                        if (o.is_subscribed()) {
-                            n->accept(o);
+                [this, first, last](const schedulable&) {
+                    for (auto n = first; n.index != last; mv.advance(n)) {
+                        auto local = this->observers;
+                        for (auto& o : local) {
+                            if (o.is_subscribed()) {
+                                mv.accept(n, o);
+                            }
                         }
                     }
                 }));
-        }
+        });
+    }
+
+    hot_observable(std::shared_ptr<test_type::test_type_state> sc, worker w, const std::vector<recorded_type>& mv)
+        : hot_observable(std::move(sc), std::move(w), recorded_sequence_type(mv))
+    {
     }
 
     virtual ~hot_observable() {}
@@ -333,12 +385,22 @@ public:
     }
 
     virtual std::vector<recorded_type> messages() const {
+        return mv.messages();
+    }
+
+    virtual const recorded_sequence_type& records() const {
         return mv;
     }
 };
 
 template<class T>
 rxt::testable_observable<T> test_type::make_hot_observable(std::vector<rxn::recorded<std::shared_ptr<rxn::detail::notification_base<T>>>> messages) const
+{
+    return make_hot_observable(rxn::recorded_sequence<T>(messages));
+}
+
+template<class T>
+rxt::testable_observable<T> test_type::make_hot_observable(rxn::recorded_sequence<T> messages) const
 {
     auto worker = create_worker(composite_subscription());
     auto shared = std::make_shared<hot_observable<T>>(state, worker, std::move(messages));
@@ -570,6 +632,11 @@ public:
         return tester->make_hot_observable(std::move(messages));
     }
 
+    template<class T>
+    rxt::testable_observable<T> make_hot_observable(rxn::recorded_sequence<T> messages) const{
+        return tester->make_hot_observable(std::move(messages));
+    }
+
     template<class T, std::size_t size>
     auto make_hot_observable(const T (&arr) [size]) const
         -> decltype(tester->make_hot_observable(std::vector<T>())) {
@@ -587,6 +654,11 @@ public:
         return tester->make_cold_observable(std::move(messages));
     }
 
+    template<class T>
+    rxt::testable_observable<T> make_cold_observable(rxn::recorded_sequence<T> messages) const {
+        return tester->make_cold_observable(std::move(messages));
+    }
+
     template<class T, std::size_t size>
     auto make_cold_observable(const T (&arr) [size]) const
         -> decltype(tester->make_cold_observable(std::vector<T>())) {
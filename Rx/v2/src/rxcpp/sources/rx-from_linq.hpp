@@ -0,0 +1,168 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_SOURCES_RX_FROM_LINQ_HPP)
+#define RXCPP_SOURCES_RX_FROM_LINQ_HPP
+
+#include "../rx-includes.hpp"
+
+/*! \file rx-from_linq.hpp
+
+    \brief Returns an observable that sends each value of a cpplinq query, on the specified scheduler.
+
+    \tparam Query         the type of the query (a cpplinq::linq_driver, or any collection with a cpplinq cursor)
+    \tparam Coordination  the type of the scheduler (optional)
+
+    \param  q      the query whose values are sent
+    \param  cn     the scheduler to use for scheduling the items (optional)
+    \param  chunk  the number of values sent by each scheduled action (optional)
+
+    \return  Observable that sends each value of the query.
+
+    The cursor of the query is requested on the scheduler when the observable is subscribed, and
+    values are sent straight from the cursor as it is advanced, so the query is not copied into
+    a container first. After each chunk of values the action is rescheduled, so that other work
+    on the same scheduler is not held up by a large query.
+*/
+
+namespace rxcpp {
+
+namespace sources {
+
+namespace detail {
+
+template<class Query>
+struct from_linq_traits
+{
+    typedef rxu::decay_t<Query> query_type;
+    typedef rxu::decay_t<decltype(std::declval<const query_type&>().get_cursor())> cursor_type;
+    typedef rxu::decay_t<decltype(std::declval<const cursor_type&>().get())> value_type;
+};
+
+template<class Query, class Coordination>
+struct from_linq : public source_base<rxu::value_type_t<from_linq_traits<Query>>>
+{
+    typedef from_linq<Query, Coordination> this_type;
+    typedef from_linq_traits<Query> traits;
+
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+
+    typedef typename traits::query_type query_type;
+    typedef typename traits::cursor_type cursor_type;
+
+    struct from_linq_initial_type
+    {
+        from_linq_initial_type(query_type q, coordination_type cn, std::size_t chunk)
+            : query(std::move(q))
+            , coordination(std::move(cn))
+            , chunk(chunk == 0 ? 1 : chunk)
+        {
+        }
+        query_type query;
+        coordination_type coordination;
+        std::size_t chunk;
+    };
+    from_linq_initial_type initial;
+
+    from_linq(query_type q, coordination_type cn, std::size_t chunk)
+        : initial(std::move(q), std::move(cn), chunk)
+    {
+    }
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        typedef typename coordinator_type::template get<Subscriber>::type output_type;
+
+        struct from_linq_state_type
+            : public from_linq_initial_type
+        {
+            from_linq_state_type(const from_linq_initial_type& i, output_type o)
+                : from_linq_initial_type(i)
+                , out(std::move(o))
+            {
+            }
+            // the cursor is requested by the first action, so the query
+            // runs on the scheduler.
+            mutable rxu::maybe<cursor_type> cursor;
+            mutable output_type out;
+        };
+
+        // creates a worker whose lifetime is the same as this subscription
+        auto coordinator = initial.coordination.create_coordinator(o.get_subscription());
+
+        from_linq_state_type state(initial, o);
+
+        auto controller = coordinator.get_worker();
+
+        auto producer = [state](const rxsc::schedulable& self){
+            if (!state.out.is_subscribed()) {
+                // terminate loop
+                return;
+            }
+
+            auto sent = on_exception(
+                [&](){
+                    if (state.cursor.empty()) {
+                        state.cursor.reset(state.query.get_cursor());
+                    }
+                    auto& cur = state.cursor.get();
+                    for (std::size_t remaining = state.chunk; remaining != 0 && !cur.empty() && state.out.is_subscribed(); --remaining) {
+                        state.out.on_next(cur.get());
+                        cur.inc();
+                    }
+                    return cur.empty();
+                },
+                state.out);
+            if (sent.empty()) {
+                // the query threw and o received the error
+                return;
+            }
+
+            if (sent.get()) {
+                state.out.on_completed();
+                // o is unsubscribed
+                return;
+            }
+
+            // tail recurse this same action to send the next chunk
+            self();
+        };
+        auto selectedProducer = on_exception(
+            [&](){return coordinator.act(producer);},
+            o);
+        if (selectedProducer.empty()) {
+            return;
+        }
+        controller.schedule(selectedProducer.get());
+
+    }
+};
+
+}
+
+/*! @copydoc rx-from_linq.hpp
+ */
+template<class Query>
+auto from_linq(Query q, std::size_t chunk = 1024)
+    ->      observable<rxu::value_type_t<detail::from_linq_traits<Query>>, detail::from_linq<Query, identity_one_worker>> {
+    return  observable<rxu::value_type_t<detail::from_linq_traits<Query>>, detail::from_linq<Query, identity_one_worker>>(
+                                                                           detail::from_linq<Query, identity_one_worker>(std::move(q), identity_immediate(), chunk));
+}
+/*! @copydoc rx-from_linq.hpp
+ */
+template<class Query, class Coordination>
+auto from_linq(Query q, Coordination cn, std::size_t chunk = 1024)
+    -> typename std::enable_if<is_coordination<Coordination>::value,
+            observable<rxu::value_type_t<detail::from_linq_traits<Query>>, detail::from_linq<Query, Coordination>>>::type {
+    return  observable<rxu::value_type_t<detail::from_linq_traits<Query>>, detail::from_linq<Query, Coordination>>(
+                                                                           detail::from_linq<Query, Coordination>(std::move(q), std::move(cn), chunk));
+}
+
+}
+
+}
+
+#endif
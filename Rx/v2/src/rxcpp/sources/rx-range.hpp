@@ -36,6 +36,8 @@ namespace sources {
 
 namespace detail {
 
+static const std::size_t range_unsubscribe_check_interval = 64;
+
 template<class T, class Coordination>
 struct range : public source_base<T>
 {
@@ -74,30 +76,34 @@ struct range : public source_base<T>
 
         auto producer = [=](const rxsc::schedulable& self){
                 auto& dest = o;
-                if (!dest.is_subscribed()) {
-                    // terminate loop
-                    return;
-                }
+                // stay in this loop for as long as the scheduler would allow
+                // the tail recursion anyway. on_next ignores values once dest
+                // is unsubscribed, so only check for that every few values.
+                for (std::size_t n = 0;; ++n) {
+                    if ((n % range_unsubscribe_check_interval) == 0 && !dest.is_subscribed()) {
+                        // terminate loop
+                        return;
+                    }
 
-                // send next value
-                dest.on_next(state.next);
-                if (!dest.is_subscribed()) {
-                    // terminate loop
-                    return;
-                }
+                    // send next value
+                    dest.on_next(state.next);
 
-                if (std::max(state.last, state.next) - std::min(state.last, state.next) < std::abs(state.step)) {
-                    if (state.last != state.next) {
-                        dest.on_next(state.last);
+                    if (std::max(state.last, state.next) - std::min(state.last, state.next) < std::abs(state.step)) {
+                        if (state.last != state.next) {
+                            dest.on_next(state.last);
+                        }
+                        dest.on_completed();
+                        // o is unsubscribed
+                        return;
                     }
-                    dest.on_completed();
-                    // o is unsubscribed
-                    return;
-                }
-                state.next = static_cast<T>(state.step + state.next);
+                    state.next = static_cast<T>(state.step + state.next);
 
-                // tail recurse this same action to continue loop
-                self();
+                    if (!self.is_recursion_allowed()) {
+                        // tail recurse this same action to continue loop
+                        self();
+                        return;
+                    }
+                }
             };
 
         auto selectedProducer = on_exception(
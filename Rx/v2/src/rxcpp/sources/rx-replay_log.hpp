@@ -0,0 +1,229 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_SOURCES_RX_REPLAY_LOG_HPP)
+#define RXCPP_SOURCES_RX_REPLAY_LOG_HPP
+
+#include "../rx-includes.hpp"
+
+/*! \file rx-replay_log.hpp
+
+    \brief Returns an observable that plays back a log written by tap_record(), on the specified scheduler.
+
+    \tparam T             the type of the values in the log
+    \tparam Coordination  the type of the scheduler (optional)
+    \tparam Serializer    the type of the serializer for the values (optional)
+
+    \param  path        the log to play back
+    \param  cn          the scheduler to use for scheduling the items (optional)
+    \param  speed       replay_log_speed::recorded or replay_log_speed::as_fast_as_possible (optional)
+    \param  serializer  converts the bytes of each value back, rxn::binary_serializer<T> by default (optional)
+
+    \return  Observable that sends the notifications of the log.
+
+    At replay_log_speed::recorded each notification is scheduled at the time it was recorded, measured
+    from the subscription, on the clock of the scheduler. Under rxsc::test this replays the log in
+    virtual time. At replay_log_speed::as_fast_as_possible the notifications are sent without waiting
+    and the action is rescheduled after each batch, so that other work on the same scheduler is not
+    held up by a large log.
+
+    The log is read one chunk at a time when the observable is subscribed. A recorded error is sent
+    as a std::runtime_error with the recorded text. A log that ends without on_error or on_completed
+    completes at its end.
+*/
+
+namespace rxcpp {
+
+namespace sources {
+
+struct replay_log_speed
+{
+    enum type {
+        recorded,
+        as_fast_as_possible
+    };
+};
+
+namespace detail {
+
+template<class T, class Coordination, class Serializer>
+struct replay_log : public source_base<rxu::decay_t<T>>
+{
+    typedef replay_log<T, Coordination, Serializer> this_type;
+
+    typedef rxu::decay_t<T> value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxu::decay_t<Serializer> serializer_type;
+
+    // the number of notifications sent by each action at as_fast_as_possible
+    static const std::size_t batch = 1024;
+
+    struct replay_log_initial_type
+    {
+        replay_log_initial_type(std::string p, coordination_type cn, replay_log_speed::type s, serializer_type sr)
+            : path(std::move(p))
+            , coordination(std::move(cn))
+            , speed(s)
+            , serializer(std::move(sr))
+        {
+        }
+        std::string path;
+        coordination_type coordination;
+        replay_log_speed::type speed;
+        serializer_type serializer;
+    };
+    replay_log_initial_type initial;
+
+    replay_log(std::string path, coordination_type cn, replay_log_speed::type speed, serializer_type serializer)
+        : initial(std::move(path), std::move(cn), speed, std::move(serializer))
+    {
+    }
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        typedef typename coordinator_type::template get<Subscriber>::type output_type;
+        typedef rxsc::scheduler::clock_type::time_point time_point;
+
+        struct replay_log_state_type
+            : public replay_log_initial_type
+        {
+            replay_log_state_type(const replay_log_initial_type& i, output_type o, rxsc::worker w)
+                : replay_log_initial_type(i)
+                , controller(std::move(w))
+                , start(controller.now())
+                , record()
+                , pending(false)
+                , out(std::move(o))
+            {
+            }
+            // the action is rescheduled at the due time of the next
+            // record, which needs the worker to stay alive.
+            rxsc::worker controller;
+            time_point start;
+            // the log is opened by the first action, so that it is read on the scheduler.
+            mutable std::shared_ptr<rxn::log_reader> log;
+            // a record that was read before it was due
+            mutable rxn::log_record record;
+            mutable bool pending;
+            mutable output_type out;
+        };
+
+        // what the action does after it returns
+        struct next_type
+        {
+            enum type {
+                stop,
+                recurse,
+                wait
+            };
+        };
+
+        // creates a worker whose lifetime is the same as this subscription
+        auto coordinator = initial.coordination.create_coordinator(o.get_subscription());
+
+        auto controller = coordinator.get_worker();
+
+        replay_log_state_type state(initial, o, controller);
+
+        auto producer = [state](const rxsc::schedulable& self){
+            if (!state.out.is_subscribed()) {
+                // terminate loop
+                return;
+            }
+
+            time_point due;
+            auto next = on_exception(
+                [&](){
+                    if (!state.log) {
+                        state.log = std::make_shared<rxn::log_reader>(state.path);
+                    }
+                    for (std::size_t sent = 0; sent != batch && state.out.is_subscribed(); ++sent) {
+                        if (!state.pending && !state.log->next(state.record)) {
+                            state.out.on_completed();
+                            return next_type::stop;
+                        }
+                        state.pending = true;
+                        if (state.speed == replay_log_speed::recorded) {
+                            due = state.start + std::chrono::duration_cast<rxsc::scheduler::clock_type::duration>(std::chrono::nanoseconds(state.record.time));
+                            if (due > state.controller.now()) {
+                                return next_type::wait;
+                            }
+                        }
+                        state.pending = false;
+                        auto& r = state.record;
+                        switch (r.kind) {
+                        case rxn::notification_kind::on_next:
+                            state.out.on_next(state.serializer.deserialize(r.data, r.size));
+                            break;
+                        case rxn::notification_kind::on_error:
+                            state.out.on_error(rxu::make_error_ptr(std::runtime_error(std::string(r.data, r.size))));
+                            return next_type::stop;
+                        case rxn::notification_kind::on_completed:
+                            state.out.on_completed();
+                            return next_type::stop;
+                        }
+                    }
+                    return next_type::recurse;
+                },
+                state.out);
+            if (next.empty() || next.get() == next_type::stop) {
+                // the log ended or o received the error
+                return;
+            }
+
+            if (next.get() == next_type::wait) {
+                self.schedule(due);
+                return;
+            }
+
+            // tail recurse this same action to send the next batch
+            self();
+        };
+        auto selectedProducer = on_exception(
+            [&](){return coordinator.act(producer);},
+            o);
+        if (selectedProducer.empty()) {
+            return;
+        }
+        controller.schedule(selectedProducer.get());
+
+    }
+};
+
+}
+
+/*! @copydoc rx-replay_log.hpp
+ */
+template<class T>
+auto replay_log(std::string path)
+    ->      observable<T, detail::replay_log<T, identity_one_worker, rxn::binary_serializer<T>>> {
+    return  observable<T, detail::replay_log<T, identity_one_worker, rxn::binary_serializer<T>>>(
+                          detail::replay_log<T, identity_one_worker, rxn::binary_serializer<T>>(std::move(path), identity_current_thread(), replay_log_speed::recorded, rxn::binary_serializer<T>()));
+}
+/*! @copydoc rx-replay_log.hpp
+ */
+template<class T, class Coordination>
+auto replay_log(std::string path, Coordination cn, replay_log_speed::type speed = replay_log_speed::recorded)
+    -> typename std::enable_if<is_coordination<Coordination>::value,
+            observable<T, detail::replay_log<T, Coordination, rxn::binary_serializer<T>>>>::type {
+    return  observable<T, detail::replay_log<T, Coordination, rxn::binary_serializer<T>>>(
+                          detail::replay_log<T, Coordination, rxn::binary_serializer<T>>(std::move(path), std::move(cn), speed, rxn::binary_serializer<T>()));
+}
+/*! @copydoc rx-replay_log.hpp
+ */
+template<class T, class Coordination, class Serializer>
+auto replay_log(std::string path, Coordination cn, replay_log_speed::type speed, Serializer serializer)
+    -> typename std::enable_if<is_coordination<Coordination>::value,
+            observable<T, detail::replay_log<T, Coordination, Serializer>>>::type {
+    return  observable<T, detail::replay_log<T, Coordination, Serializer>>(
+                          detail::replay_log<T, Coordination, Serializer>(std::move(path), std::move(cn), speed, std::move(serializer)));
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,403 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_UNICAST_SUBJECT_HPP)
+#define RXCPP_RX_UNICAST_SUBJECT_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+class unicast_subject_error: public std::runtime_error
+{
+    public:
+        explicit unicast_subject_error(const std::string& msg):
+            std::runtime_error(msg)
+        {}
+};
+
+namespace subjects {
+
+namespace detail {
+
+/// delivers to a single subscriber without taking a lock. when a second
+/// subscriber arrives, both are moved to a multicast_observer, so any
+/// number of subscribers is still supported.
+template<class T>
+class unicast_observer
+{
+    typedef subscriber<T> observer_type;
+
+    struct mode
+    {
+        enum type {
+            Empty = 0,
+            Unicasting,
+            Multicasting
+        };
+    };
+
+    struct state_type
+    {
+        explicit state_type(composite_subscription cs)
+            : current(mode::Empty)
+            , done(false)
+            , lifetime(cs)
+        {
+        }
+        // written under lock, read by on_next without the lock. single and
+        // multi are each set once, before current is released.
+        std::atomic<int> current;
+        rxu::maybe<observer_type> single;
+        rxu::maybe<multicast_observer<T>> multi;
+
+        std::mutex lock;
+        bool done;
+        rxu::error_ptr error;
+        composite_subscription lifetime;
+    };
+
+    std::shared_ptr<state_type> state;
+
+    // an empty e completes the sequence
+    void terminate(rxu::error_ptr e) const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        if (state->done) {
+            return;
+        }
+        state->done = true;
+        state->error = e;
+        // add() does not change the mode once done is set
+        auto current = state->current.load(std::memory_order_relaxed);
+        guard.unlock();
+        if (current == mode::Unicasting) {
+            if (e) {
+                state->single.get().on_error(e);
+            } else {
+                state->single.get().on_completed();
+            }
+        } else if (current == mode::Multicasting) {
+            if (e) {
+                state->multi.get().on_error(e);
+            } else {
+                state->multi.get().on_completed();
+            }
+        }
+        state->lifetime.unsubscribe();
+    }
+
+public:
+    typedef subscriber<T, observer<T, detail::unicast_observer<T>>> input_subscriber_type;
+
+    explicit unicast_observer(composite_subscription cs)
+        : state(std::make_shared<state_type>(cs))
+    {
+    }
+    composite_subscription get_subscription() const {
+        return state->lifetime;
+    }
+    input_subscriber_type get_subscriber() const {
+        return make_subscriber<T>(get_subscription(), observer<T, detail::unicast_observer<T>>(*this));
+    }
+    bool has_observers() const {
+        switch (state->current.load(std::memory_order_acquire)) {
+        case mode::Unicasting:
+            return state->single.get().is_subscribed();
+        case mode::Multicasting:
+            return state->multi.get().has_observers();
+        default:
+            return false;
+        }
+    }
+    template<class SubscriberFrom>
+    void add(const SubscriberFrom& sf, observer_type o) const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        auto current = state->current.load(std::memory_order_relaxed);
+        if (current == mode::Multicasting) {
+            // the multicast_observer replays the end of the sequence
+            guard.unlock();
+            state->multi.get().add(sf, std::move(o));
+            return;
+        }
+        if (state->done) {
+            auto e = state->error;
+            guard.unlock();
+            if (e) {
+                o.on_error(e);
+            } else {
+                o.on_completed();
+            }
+            return;
+        }
+        if (current == mode::Empty) {
+            trace_activity().connect(sf, o);
+            state->single.reset(std::move(o));
+            state->current.store(mode::Unicasting, std::memory_order_release);
+            return;
+        }
+        multicast_observer<T> multi(composite_subscription{});
+        multi.add(sf, state->single.get());
+        multi.add(sf, std::move(o));
+        state->multi.reset(std::move(multi));
+        state->current.store(mode::Multicasting, std::memory_order_release);
+    }
+    template<class V>
+    void on_next(V v) const {
+        switch (state->current.load(std::memory_order_acquire)) {
+        case mode::Unicasting:
+            state->single.get().on_next(std::move(v));
+            break;
+        case mode::Multicasting:
+            state->multi.get().on_next(std::move(v));
+            break;
+        default:
+            break;
+        }
+    }
+    void on_error(rxu::error_ptr e) const {
+        terminate(e);
+    }
+    void on_completed() const {
+        terminate(rxu::error_ptr());
+    }
+};
+
+/// holds items until the first subscriber arrives and then delivers to
+/// that subscriber without a lock. a second subscriber is refused.
+template<class T>
+class unicast_queue_observer
+{
+    typedef subscriber<T> observer_type;
+    typedef rxu::ring_buffer<T> queue_type;
+
+    struct mode
+    {
+        enum type {
+            Queueing = 0,
+            Draining,
+            Unicasting
+        };
+    };
+
+    struct state_type
+    {
+        state_type(std::size_t capacity, composite_subscription cs)
+            : current(mode::Queueing)
+            , queue(capacity)
+            , claimed(false)
+            , done(false)
+            , lifetime(cs)
+        {
+        }
+        // written under lock, read by on_next without the lock. single is
+        // set once, before current is released.
+        std::atomic<int> current;
+        rxu::maybe<observer_type> single;
+
+        std::mutex lock;
+        queue_type queue;
+        bool claimed;
+        bool done;
+        rxu::error_ptr error;
+        composite_subscription lifetime;
+    };
+
+    std::shared_ptr<state_type> state;
+
+    // an empty e completes the sequence
+    void terminate(rxu::error_ptr e) const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        if (state->done) {
+            return;
+        }
+        state->done = true;
+        state->error = e;
+        // the queue and the terminal notification are kept for the
+        // subscriber or the drain loop when not yet unicasting
+        auto current = state->current.load(std::memory_order_relaxed);
+        guard.unlock();
+        if (current == mode::Unicasting) {
+            if (e) {
+                state->single.get().on_error(e);
+            } else {
+                state->single.get().on_completed();
+            }
+        }
+        state->lifetime.unsubscribe();
+    }
+
+    // delivers the items that arrived before the subscriber, including
+    // items queued by on_next calls made while draining.
+    void drain(std::unique_lock<std::mutex>& guard) const {
+        auto& o = state->single.get();
+        while (!state->queue.empty()) {
+            auto v = state->queue.pop_front();
+            guard.unlock();
+            o.on_next(std::move(v));
+            guard.lock();
+        }
+        if (state->done) {
+            auto e = state->error;
+            guard.unlock();
+            if (e) {
+                o.on_error(e);
+            } else {
+                o.on_completed();
+            }
+            return;
+        }
+        state->current.store(mode::Unicasting, std::memory_order_release);
+        guard.unlock();
+    }
+
+public:
+    typedef subscriber<T, observer<T, detail::unicast_queue_observer<T>>> input_subscriber_type;
+
+    unicast_queue_observer(std::size_t capacity, composite_subscription cs)
+        : state(std::make_shared<state_type>(capacity, cs))
+    {
+    }
+    composite_subscription get_subscription() const {
+        return state->lifetime;
+    }
+    input_subscriber_type get_subscriber() const {
+        return make_subscriber<T>(get_subscription(), observer<T, detail::unicast_queue_observer<T>>(*this));
+    }
+    bool has_observers() const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        return state->claimed && state->single.get().is_subscribed();
+    }
+    template<class SubscriberFrom>
+    void add(const SubscriberFrom& sf, observer_type o) const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        if (state->claimed) {
+            guard.unlock();
+            o.on_error(rxu::make_error_ptr(rxcpp::unicast_subject_error("unicast_subject already has a subscriber")));
+            return;
+        }
+        state->claimed = true;
+        trace_activity().connect(sf, o);
+        state->single.reset(std::move(o));
+        state->current.store(mode::Draining, std::memory_order_relaxed);
+        drain(guard);
+    }
+    template<class V>
+    void on_next(V v) const {
+        if (state->current.load(std::memory_order_acquire) == mode::Unicasting) {
+            state->single.get().on_next(std::move(v));
+            return;
+        }
+        std::unique_lock<std::mutex> guard(state->lock);
+        if (state->current.load(std::memory_order_relaxed) == mode::Unicasting) {
+            guard.unlock();
+            state->single.get().on_next(std::move(v));
+            return;
+        }
+        if (state->done) {
+            return;
+        }
+        if (state->queue.full()) {
+            guard.unlock();
+            terminate(rxu::make_error_ptr(rxcpp::unicast_subject_error("unicast_subject queue overflow")));
+            return;
+        }
+        state->queue.push_back(std::move(v));
+    }
+    void on_error(rxu::error_ptr e) const {
+        terminate(e);
+    }
+    void on_completed() const {
+        terminate(rxu::error_ptr());
+    }
+};
+
+}
+
+/// a subject for the windows emitted by the window operators. nearly every
+/// window has exactly one subscriber, which is called directly and without
+/// a lock. a second subscriber turns the window into a multicast subject.
+template<class T>
+class window_subject
+{
+    detail::unicast_observer<T> s;
+
+public:
+    typedef typename detail::unicast_observer<T>::input_subscriber_type subscriber_type;
+    typedef observable<T> observable_type;
+    window_subject()
+        : s(composite_subscription())
+    {
+    }
+
+    bool has_observers() const {
+        return s.has_observers();
+    }
+
+    composite_subscription get_subscription() const {
+        return s.get_subscription();
+    }
+
+    subscriber_type get_subscriber() const {
+        return s.get_subscriber();
+    }
+
+    observable<T> get_observable() const {
+        auto keepAlive = s;
+        return make_observable_dynamic<T>([=](subscriber<T> o){
+            keepAlive.add(keepAlive.get_subscriber(), std::move(o));
+        });
+    }
+};
+
+/// a subject with exactly one subscriber. items that arrive before the
+/// subscriber are queued and delivered to it when it subscribes. when a
+/// capacity is given, an item that does not fit in the queue ends the
+/// sequence with unicast_subject_error. a second subscriber is refused with
+/// unicast_subject_error.
+template<class T>
+class unicast_subject
+{
+    detail::unicast_queue_observer<T> s;
+
+public:
+    typedef typename detail::unicast_queue_observer<T>::input_subscriber_type subscriber_type;
+    typedef observable<T> observable_type;
+    unicast_subject()
+        : s(std::numeric_limits<std::size_t>::max(), composite_subscription())
+    {
+    }
+    explicit unicast_subject(composite_subscription cs)
+        : s(std::numeric_limits<std::size_t>::max(), cs)
+    {
+    }
+    explicit unicast_subject(std::size_t capacity, composite_subscription cs = composite_subscription())
+        : s(capacity, cs)
+    {
+    }
+
+    bool has_observers() const {
+        return s.has_observers();
+    }
+
+    composite_subscription get_subscription() const {
+        return s.get_subscription();
+    }
+
+    subscriber_type get_subscriber() const {
+        return s.get_subscriber();
+    }
+
+    observable<T> get_observable() const {
+        auto keepAlive = s;
+        return make_observable_dynamic<T>([=](subscriber<T> o){
+            keepAlive.add(keepAlive.get_subscriber(), std::move(o));
+        });
+    }
+};
+
+}
+
+}
+
+#endif
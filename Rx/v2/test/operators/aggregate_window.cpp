@@ -0,0 +1,391 @@
+#include "../test.h"
+#include <rxcpp/operators/rx-aggregate_window.hpp>
+
+SCENARIO("aggregate_window hopping sum", "[aggregate_window][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto so = rx::synchronize_in_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(100, 1),
+            on.next(210, 2),
+            on.next(240, 3),
+            on.next(280, 4),
+            on.next(320, 5),
+            on.next(350, 6),
+            on.next(380, 7),
+            on.next(420, 8),
+            on.next(470, 9),
+            on.completed(600)
+        });
+        WHEN("ints are summed on intersecting intervals"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .aggregate_window(rxo::hopping_window(milliseconds(100), milliseconds(70)), rxo::aggregate_sum(), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the sum of each window that is not empty"){
+                auto required = rxu::to_vector({
+                    on.next(301, 2 + 3 + 4),
+                    on.next(371, 4 + 5 + 6),
+                    on.next(441, 6 + 7 + 8),
+                    on.next(511, 8 + 9),
+                    on.completed(601)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to the xs"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 600)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("aggregate_window tumbling count and max", "[aggregate_window][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto so = rx::synchronize_in_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(100, 1),
+            on.next(210, 2),
+            on.next(240, 3),
+            on.next(280, 4),
+            on.next(320, 7),
+            on.next(350, 6),
+            on.next(380, 5),
+            on.next(420, 8),
+            on.next(470, 9),
+            on.next(590, 1),
+            on.completed(650)
+        });
+        WHEN("ints are counted on back-to-back intervals"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .aggregate_window(rxo::tumbling_window(milliseconds(100)), rxo::aggregate_count(), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the count of each window and the open window is emitted on completion"){
+                auto required = rxu::to_vector({
+                    on.next(301, 3),
+                    on.next(401, 3),
+                    on.next(501, 2),
+                    on.next(601, 1),
+                    on.completed(651)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+        WHEN("the max of each window is taken"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        | rxo::aggregate_window(rxo::tumbling_window(milliseconds(100)), rxo::aggregate_max(), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        | rxo::as_dynamic();
+                }
+            );
+
+            THEN("the output contains the max of each window"){
+                auto required = rxu::to_vector({
+                    on.next(301, 4),
+                    on.next(401, 7),
+                    on.next(501, 9),
+                    on.next(601, 1),
+                    on.completed(651)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("aggregate_window hopping min shares panes", "[aggregate_window][operators]"){
+    GIVEN("1 hot observable with an item every 7 ticks."){
+        auto sc = rxsc::make_test();
+        auto so = rx::synchronize_in_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        // values that rise and fall so that the min leaves the window in
+        // the middle of the panes as often as at the edges
+        std::vector<rxsc::test::messages<int>::recorded_type> items;
+        std::vector<std::pair<long, int>> timeline;
+        for (long t = 201; t < 800; t += 7) {
+            auto v = static_cast<int>((t * 37) % 101);
+            items.push_back(on.next(t, v));
+            timeline.push_back(std::make_pair(t, v));
+        }
+        items.push_back(on.completed(800));
+
+        auto xs = sc.make_hot_observable(items);
+
+        WHEN("the min is taken for windows of 60 every 15"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .aggregate_window(rxo::hopping_window(milliseconds(60), milliseconds(15)), rxo::aggregate_min(), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("each window has the min of the items inside the window"){
+                std::vector<rxsc::test::messages<int>::recorded_type> required;
+                for (long start = 200; start < 800; start += 15) {
+                    auto end = start + 60;
+                    auto found = false;
+                    int least = 0;
+                    for (auto& item : timeline) {
+                        if (item.first >= start && item.first < end && (!found || item.second < least)) {
+                            least = item.second;
+                            found = true;
+                        }
+                    }
+                    if (found) {
+                        required.push_back(on.next(end <= 800 ? end + 1 : 801, least));
+                    }
+                }
+                required.push_back(on.completed(801));
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("aggregate_window session average", "[aggregate_window][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto so = rx::synchronize_in_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        const rxsc::test::messages<double> d_on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(100, 1),
+            on.next(210, 2),
+            on.next(240, 3),
+            on.next(280, 4),
+            on.next(400, 5),
+            on.next(420, 7),
+            on.next(600, 9),
+            on.completed(620)
+        });
+        WHEN("ints are averaged in sessions that end after 50 ticks without an item"){
+            using namespace std::chrono;
+
+            auto average = rxo::aggregate_with(
+                [](int v){return std::make_pair(v, 1);},
+                [](std::pair<int, int> older, std::pair<int, int> newer){
+                    return std::make_pair(older.first + newer.first, older.second + newer.second);},
+                [](std::pair<int, int> a){return static_cast<double>(a.first) / a.second;});
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .aggregate_window(rxo::session_window(milliseconds(50)), average, so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the average of each session"){
+                auto required = rxu::to_vector({
+                    d_on.next(330, 3.0),
+                    d_on.next(470, 6.0),
+                    d_on.next(621, 9.0),
+                    d_on.completed(621)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to the xs"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 620)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("aggregate_window error", "[aggregate_window][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto so = rx::synchronize_in_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::runtime_error ex("aggregate_window on_error from source");
+
+        auto xs = sc.make_hot_observable({
+            on.next(210, 2),
+            on.next(240, 3),
+            on.next(320, 5),
+            on.error(350, ex)
+        });
+        WHEN("ints are summed on back-to-back intervals"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .aggregate_window(rxo::tumbling_window(milliseconds(100)), rxo::aggregate_sum(), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the open window is dropped and the error is forwarded"){
+                auto required = rxu::to_vector({
+                    on.next(301, 5),
+                    on.error(351, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("aggregate_window hopping sum with windows that end inside a hop", "[aggregate_window][operators]"){
+    GIVEN("1 hot observable with an item every 7 ticks."){
+        auto sc = rxsc::make_test();
+        auto so = rx::synchronize_in_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::vector<rxsc::test::messages<int>::recorded_type> items;
+        std::vector<std::pair<long, int>> timeline;
+        for (long t = 201; t < 800; t += 7) {
+            auto v = static_cast<int>(t % 13);
+            items.push_back(on.next(t, v));
+            timeline.push_back(std::make_pair(t, v));
+        }
+        items.push_back(on.completed(800));
+
+        auto xs = sc.make_hot_observable(items);
+
+        WHEN("the items are summed for windows of 97 every 40"){
+            using namespace std::chrono;
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .aggregate_window(rxo::hopping_window(milliseconds(97), milliseconds(40)), rxo::aggregate_sum(), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("each window has the sum of the items inside the window"){
+                std::vector<rxsc::test::messages<int>::recorded_type> required;
+                for (long start = 200; start < 800; start += 40) {
+                    auto end = start + 97;
+                    auto found = false;
+                    int sum = 0;
+                    for (auto& item : timeline) {
+                        if (item.first >= start && item.first < end) {
+                            sum += item.second;
+                            found = true;
+                        }
+                    }
+                    if (found) {
+                        required.push_back(on.next(end <= 800 ? end + 1 : 801, sum));
+                    }
+                }
+                required.push_back(on.completed(801));
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("aggregate_window checks the window", "[aggregate_window][operators]"){
+    GIVEN("window durations"){
+        using namespace std::chrono;
+
+        WHEN("the size or the hop is not greater than zero"){
+
+            int thrown = 0;
+            RXCPP_TRY {
+                rxo::hopping_window(milliseconds(100), milliseconds(0));
+            } RXCPP_CATCH(const std::invalid_argument&) {
+                ++thrown;
+            }
+            RXCPP_TRY {
+                rxo::tumbling_window(milliseconds(-1));
+            } RXCPP_CATCH(const std::invalid_argument&) {
+                ++thrown;
+            }
+
+            THEN("the window was rejected"){
+                REQUIRE(2 == thrown);
+            }
+        }
+
+        WHEN("the session gap is not greater than zero"){
+
+            int thrown = 0;
+            RXCPP_TRY {
+                rxo::session_window(milliseconds(0));
+            } RXCPP_CATCH(const std::invalid_argument&) {
+                ++thrown;
+            }
+            RXCPP_TRY {
+                rxo::session_window(milliseconds(-5));
+            } RXCPP_CATCH(const std::invalid_argument&) {
+                ++thrown;
+            }
+
+            THEN("the window was rejected"){
+                REQUIRE(2 == thrown);
+            }
+        }
+
+        WHEN("the hop is one tick longer than the size"){
+
+            std::vector<int> counts;
+            rxs::range(1, 10)
+                .aggregate_window(rxo::hopping_window(seconds(1), seconds(1) + nanoseconds(1)), rxo::aggregate_count())
+                .subscribe([&](int c){ counts.push_back(c); });
+
+            THEN("the open window is emitted without stepping through single ticks"){
+                auto required = rxu::to_vector({10});
+                REQUIRE(required == counts);
+            }
+        }
+    }
+}
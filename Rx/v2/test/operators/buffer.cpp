@@ -1,5 +1,6 @@
 #include "../test.h"
 #include <rxcpp/operators/rx-concat.hpp>
+#include <rxcpp/operators/rx-map.hpp>
 #include <rxcpp/operators/rx-buffer_count.hpp>
 #include <rxcpp/operators/rx-buffer_time.hpp>
 #include <rxcpp/operators/rx-buffer_time_count.hpp>
@@ -455,6 +456,135 @@ SCENARIO("buffer count error 2", "[buffer][operators]"){
     }
 }
 
+SCENARIO("buffer count shared skip less", "[buffer][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        const rxsc::test::messages<std::vector<int>> v_on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2),
+            on.next(220, 3),
+            on.next(230, 4),
+            on.next(240, 5),
+            on.completed(250)
+        });
+
+        WHEN("group each int with the next 2 ints in shared buffers"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .buffer(3, 1, rxo::shared_buffers())
+                        .map([](rxo::shared_buffer<int> b){return b.to_vector();})
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains groups of ints"){
+                auto required = rxu::to_vector({
+                    v_on.next(230, rxu::to_vector({ 2, 3, 4 })),
+                    v_on.next(240, rxu::to_vector({ 3, 4, 5 })),
+                    v_on.next(250, rxu::to_vector({ 4, 5 })),
+                    v_on.next(250, rxu::to_vector({ 5 })),
+                    v_on.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to the xs"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 250)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("buffer count shared skip more", "[buffer][operators]"){
+    GIVEN("1 hot observable of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        const rxsc::test::messages<std::vector<int>> v_on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2),
+            on.next(220, 3),
+            on.next(230, 4),
+            on.next(240, 5),
+            on.completed(250)
+        });
+
+        WHEN("group each int with the next int skipping the third one in shared buffers"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .buffer(2, 3, rxo::shared_buffers())
+                        .map([](rxo::shared_buffer<int> b){return b.to_vector();})
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains groups of ints"){
+                auto required = rxu::to_vector({
+                    v_on.next(220, rxu::to_vector({ 2, 3 })),
+                    v_on.next(250, rxu::to_vector({ 5 })),
+                    v_on.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("buffer count shared sliding windows share storage", "[buffer][operators]"){
+    GIVEN("a range of ints"){
+        const int count = 100;
+        auto xs = rxs::range(1, 1000);
+
+        WHEN("sliding windows of 100 ints are kept"){
+            std::vector<rxo::shared_buffer<int>> shared;
+            xs.buffer(count, 1, rxo::shared_buffers()).subscribe([&](rxo::shared_buffer<int> b){
+                shared.push_back(b);
+            });
+            std::vector<std::vector<int>> copied;
+            xs.buffer(count, 1).subscribe([&](std::vector<int> b){
+                copied.push_back(b);
+            });
+
+            THEN("the windows match the copied buffers"){
+                REQUIRE(shared.size() == copied.size());
+                for (std::size_t i = 0; i < shared.size(); ++i) {
+                    REQUIRE(shared[i].to_vector() == copied[i]);
+                }
+            }
+
+            THEN("overlapping windows point into the same storage"){
+                int stores = 1;
+                for (std::size_t i = 1; i < shared.size(); ++i) {
+                    if (shared[i].data() != shared[i - 1].data() + 1) {
+                        ++stores;
+                    }
+                }
+                // each store holds 2 * count items, count - 1 of which are
+                // carried over from the previous store
+                REQUIRE(stores <= 1000 / (count + 1) + 1);
+            }
+        }
+    }
+}
+
 SCENARIO("buffer with time on intervals", "[buffer_with_time][operators][long][!hide]"){
     GIVEN("7 intervals of 2 seconds"){
         WHEN("the period is 2sec and the initial is 5sec"){
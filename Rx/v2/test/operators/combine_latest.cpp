@@ -1664,3 +1664,153 @@ SCENARIO("combine_latest typical N", "[combine_latest][join][operators]"){
         }
     }
 }
+
+SCENARIO("combine_latest throttled", "[combine_latest][join][operators]"){
+    GIVEN("2 hot observables of ints with bursts."){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto o1 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(215, 2),
+            on.next(215, 3),
+            on.completed(230)
+        });
+
+        auto o2 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(215, 10),
+            on.next(220, 20),
+            on.next(220, 30),
+            on.next(220, 40),
+            on.completed(240)
+        });
+
+        WHEN("the latest ints are combined at most once per tick"){
+
+            auto res = w.start(
+                [&]() {
+                    return o2
+                        .combine_latest(
+                            so,
+                            rxo::throttle_latest(),
+                            [](const int& v2, const int& v1){
+                                return v2 + v1;
+                            },
+                            o1
+                        )
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("each burst is combined into one int"){
+                auto required = rxu::to_vector({
+                    on.next(216, 3 + 10),
+                    on.next(221, 3 + 40),
+                    on.completed(241)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to the o1"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 230)
+                });
+                auto actual = o1.subscriptions();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was one subscription and one unsubscription to the o2"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 240)
+                });
+                auto actual = o2.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("combine_latest throttled with sources on other threads", "[combine_latest][join][operators]"){
+    GIVEN("2 ranges of ints that each emit on a new thread."){
+        auto o1 = rxs::range(1, 10000, rx::synchronize_new_thread());
+        auto o2 = rxs::range(1, 10000, rx::synchronize_new_thread());
+
+        WHEN("the latest ints are combined on another thread"){
+            std::vector<int> actual;
+            o1
+                .combine_latest(
+                    rx::identity_one_worker(rxsc::make_new_thread()),
+                    rxo::throttle_latest(),
+                    [](const int& v1, const int& v2){
+                        return v1 + v2;
+                    },
+                    o2
+                )
+                .as_blocking()
+                .subscribe([&](int v){
+                    actual.push_back(v);
+                });
+
+            THEN("the sums never decrease and the last sum has both last ints"){
+                REQUIRE(!actual.empty());
+                REQUIRE(actual.size() <= 20000);
+                REQUIRE(std::is_sorted(actual.begin(), actual.end()));
+                REQUIRE(actual.back() == 10000 + 10000);
+            }
+        }
+    }
+}
+
+SCENARIO("combine_latest selector with non-const references", "[combine_latest][join][operators]"){
+    GIVEN("2 hot observables of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto o1 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(215, 2),
+            on.completed(230)
+        });
+
+        auto o2 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(220, 10),
+            on.next(225, 20),
+            on.completed(240)
+        });
+
+        WHEN("the selector changes the values that it is given"){
+
+            auto res = w.start(
+                [&]() {
+                    return o2
+                        .combine_latest(
+                            [](int& v2, int& v1){
+                                v2 += 100;
+                                return v2 + v1;
+                            },
+                            o1
+                        )
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the selector was given copies of the latest values"){
+                auto required = rxu::to_vector({
+                    on.next(220, 110 + 2),
+                    on.next(225, 120 + 2),
+                    on.completed(240)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
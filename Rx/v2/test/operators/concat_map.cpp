@@ -533,3 +533,60 @@ SCENARIO("concat_transform, no result selector, with coordination", "[concat_tra
         }
     }
 }
+
+SCENARIO("concat_map - late items from a completed collection", "[concat_map][transform][map][operators]"){
+    GIVEN("a source of ints and collections that complete"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(300, 1),
+            on.next(400, 2),
+            on.completed(500)
+        });
+
+        // keeps the observers so that they can be called after their
+        // collection has completed
+        std::vector<rx::observer<int>> stale;
+
+        WHEN("each int is mapped to a collection that completes immediately"){
+
+            w.schedule_absolute(350, [&](const rxsc::schedulable&){
+                stale.front().on_next(101);});
+            w.schedule_absolute(450, [&](const rxsc::schedulable&){
+                stale.front().on_next(102);
+                stale.back().on_next(202);});
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .concat_map(
+                            [&](int i){
+                                return rx::observable<>::create<int>(
+                                    [&, i](rx::subscriber<int> s){
+                                        stale.push_back(s.get_observer());
+                                        s.on_next(i * 10);
+                                        s.on_completed();
+                                    });
+                            },
+                            [](int, int v){
+                                return v;
+                            })
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output only contains the items sent before each collection completed"){
+                auto required = rxu::to_vector({
+                    on.next(300, 10),
+                    on.next(400, 20),
+                    on.completed(500)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
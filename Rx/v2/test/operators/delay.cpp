@@ -1,5 +1,8 @@
 #include "../test.h"
 #include <rxcpp/operators/rx-delay.hpp>
+#include <rxcpp/operators/rx-observe_on.hpp>
+
+#include <numeric>
 
 using namespace std::chrono;
 
@@ -123,6 +126,48 @@ SCENARIO("delay - return", "[delay][operators]"){
     }
 }
 
+SCENARIO("delay - completed while a value is pending", "[delay][operators]"){
+    GIVEN("a source that completes before its last value is delivered"){
+        auto sc = rxsc::make_test();
+        auto so = rx::synchronize_in_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2),
+            on.completed(215)
+        });
+
+        WHEN("values are delayed"){
+
+            auto res = w.start(
+                [so, xs]() {
+                    return xs.delay(milliseconds(10), so);
+                }
+            );
+
+            THEN("the output contains the delayed value and the delayed completion"){
+                auto required = rxu::to_vector({
+                    on.next(220, 2),
+                    on.completed(225)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 215)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+
+        }
+    }
+}
+
 SCENARIO("delay - throw", "[delay][operators]"){
     GIVEN("a source"){
         auto sc = rxsc::make_test();
@@ -164,3 +209,67 @@ SCENARIO("delay - throw", "[delay][operators]"){
         }
     }
 }
+
+SCENARIO("delay - bursts", "[delay][operators]"){
+    GIVEN("a source with values that arrive together"){
+        auto sc = rxsc::make_test();
+        auto so = rx::synchronize_in_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2),
+            on.next(210, 3),
+            on.next(210, 4),
+            on.next(215, 5),
+            on.next(230, 6),
+            on.next(230, 7),
+            on.completed(230)
+        });
+
+        WHEN("values are delayed"){
+
+            auto res = w.start(
+                [so, xs]() {
+                    return xs | rxo::delay(milliseconds(10), so);
+                }
+            );
+
+            THEN("the output is shifted in time and keeps the order of the source"){
+                auto required = rxu::to_vector({
+                    on.next(220, 2),
+                    on.next(220, 3),
+                    on.next(220, 4),
+                    on.next(225, 5),
+                    on.next(240, 6),
+                    on.next(240, 7),
+                    on.completed(240)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("delay - many values on a new thread", "[delay][operators]"){
+    GIVEN("a range of values"){
+        auto xs = rxs::range(1, 10000);
+
+        WHEN("values are delayed on a new thread"){
+            std::vector<int> actual;
+            xs.delay(milliseconds(1), rx::observe_on_new_thread())
+                .as_blocking()
+                .subscribe([&](int v){
+                    actual.push_back(v);
+                });
+
+            THEN("every value is emitted in order"){
+                std::vector<int> required(10000);
+                std::iota(required.begin(), required.end(), 1);
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
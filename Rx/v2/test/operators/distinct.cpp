@@ -696,4 +696,190 @@ SCENARIO("distinct - enum", "[distinct][operators]"){
 
         }
     }
-}
\ No newline at end of file
+}
+SCENARIO("distinct - capacity forgets the least recently seen value", "[distinct][operators]"){
+    GIVEN("a source"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 1), //*
+            on.next(215, 2), //*
+            on.next(220, 1),
+            on.next(225, 3), //* forgets 2
+            on.next(230, 2), //* forgets 1
+            on.next(235, 3),
+            on.next(240, 1), //* forgets 3
+            on.completed(250)
+        });
+
+        WHEN("distinct values are taken with a capacity of 2"){
+
+            auto res = w.start(
+                [xs]() {
+                    return xs
+                        | rxo::distinct(2)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        | rxo::as_dynamic();
+                }
+            );
+
+            THEN("the output contains the values that were not remembered"){
+                auto required = rxu::to_vector({
+                    on.next(210, 1),
+                    on.next(215, 2),
+                    on.next(225, 3),
+                    on.next(230, 2),
+                    on.next(240, 1),
+                    on.completed(250)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 250)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("distinct - ttl forgets values that were not seen in time", "[distinct][operators]"){
+    GIVEN("a source"){
+        auto sc = rxsc::make_test();
+        auto so = rx::identity_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 1), //*
+            on.next(215, 1),
+            on.next(220, 2), //*
+            on.next(240, 1), //* 25 since 1 was seen
+            on.next(245, 2), //* 25 since 2 was seen
+            on.next(250, 1),
+            on.completed(260)
+        });
+
+        WHEN("distinct values are taken with a ttl of 20"){
+
+            auto res = w.start(
+                [&]() {
+                    return xs
+                        .distinct(std::chrono::milliseconds(20), so)
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the output contains the values that were not seen within the ttl"){
+                auto required = rxu::to_vector({
+                    on.next(210, 1),
+                    on.next(220, 2),
+                    on.next(240, 1),
+                    on.next(245, 2),
+                    on.completed(260)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("distinct - approximate", "[distinct][operators]"){
+    GIVEN("a source that repeats 20000 values"){
+        std::vector<int> values;
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int i = 0; i < 20000; ++i) {
+                values.push_back(i);
+            }
+        }
+        auto xs = rxs::iterate(values);
+
+        WHEN("distinct values are taken with an approximate filter"){
+            std::vector<int> emitted;
+            xs.distinct(rxo::approximate_distinct(20000, 0.001)).subscribe([&](int v){
+                emitted.push_back(v);
+            });
+
+            THEN("no value is emitted twice and few values are dropped"){
+                std::set<int> unique(emitted.begin(), emitted.end());
+                REQUIRE(unique.size() == emitted.size());
+                REQUIRE(emitted.size() <= 20000);
+                REQUIRE(emitted.size() >= 19900);
+            }
+        }
+    }
+    GIVEN("a long source of unique values"){
+        auto xs = rxs::range(0, 199999);
+
+        WHEN("distinct values are taken with a small approximate filter"){
+            int emitted = 0;
+            xs.distinct(rxo::approximate_distinct(1000, 0.001)).subscribe([&](int){
+                ++emitted;
+            });
+
+            THEN("the filter rotates instead of filling up"){
+                REQUIRE(emitted >= 199000);
+            }
+        }
+    }
+}
+
+SCENARIO("distinct - capacity must be greater than zero", "[distinct][operators]"){
+    GIVEN("a source"){
+        auto xs = rxs::range(1, 10);
+
+        WHEN("distinct is given a capacity of 0 or less"){
+
+            int thrown = 0;
+            RXCPP_TRY {
+                xs.distinct(0);
+            } RXCPP_CATCH(const std::invalid_argument&) {
+                ++thrown;
+            }
+            RXCPP_TRY {
+                xs.distinct(-1, std::chrono::milliseconds(10), rx::identity_current_thread());
+            } RXCPP_CATCH(const std::invalid_argument&) {
+                ++thrown;
+            }
+
+            THEN("the capacity was rejected"){
+                REQUIRE(2 == thrown);
+            }
+        }
+    }
+}
+
+SCENARIO("distinct - copies of a bounded observer share what they remember", "[distinct][operators]"){
+    GIVEN("a bounded distinct observer that has seen values"){
+        typedef rxo::detail::distinct_bounded<int, rx::identity_one_worker> distinct_type;
+        std::vector<int> emitted;
+        auto out = rx::make_subscriber<int>([&](int v){ emitted.push_back(v); });
+        auto original = distinct_type::distinct_bounded_observer<decltype(out)>(
+            out,
+            distinct_type::distinct_bounded_values(2, rxsc::scheduler::clock_type::duration::max(), rx::identity_current_thread()));
+        original.on_next(1);
+        original.on_next(2);
+
+        WHEN("a copy forgets and remembers values"){
+            auto copy = original;
+            copy.on_next(3); // forgets 1
+            copy.on_next(2);
+            original.on_next(1); // forgets 3
+
+            THEN("both saw the same values"){
+                auto required = rxu::to_vector({1, 2, 3, 1});
+                REQUIRE(required == emitted);
+            }
+        }
+    }
+}
@@ -453,3 +453,124 @@ SCENARIO("min, error", "[reduce][min][operators]"){
         }
     }
 }
+
+SCENARIO("reduce a contiguous collection", "[reduce][sum][average][max][min][operators]"){
+    GIVEN("a vector of ints that is not a multiple of the batch width"){
+        std::vector<int> values;
+        for (int i = 0; i < 1003; ++i) {
+            values.push_back(((i * 7919) % 2001) - 1000);
+        }
+
+        WHEN("sum, average, max and min are calculated from iterate"){
+
+            int sum = 0;
+            double average = 0;
+            int max = 0;
+            int min = 0;
+            rxs::iterate(values).sum().subscribe([&](int v){sum = v;});
+            rxs::iterate(values).average().subscribe([&](double v){average = v;});
+            rxs::iterate(values).max().subscribe([&](int v){max = v;});
+            rxs::iterate(values).min().subscribe([&](int v){min = v;});
+
+            THEN("the results match the values folded one at a time"){
+                int expected_sum = 0;
+                double expected_average = 0;
+                int expected_max = 0;
+                int expected_min = 0;
+                rxs::iterate(values).as_dynamic().sum().subscribe([&](int v){expected_sum = v;});
+                rxs::iterate(values).as_dynamic().average().subscribe([&](double v){expected_average = v;});
+                rxs::iterate(values).as_dynamic().max().subscribe([&](int v){expected_max = v;});
+                rxs::iterate(values).as_dynamic().min().subscribe([&](int v){expected_min = v;});
+
+                REQUIRE(expected_sum == sum);
+                REQUIRE(expected_average == average);
+                REQUIRE(expected_max == max);
+                REQUIRE(expected_min == min);
+            }
+        }
+    }
+    GIVEN("a vector of ints whose sum overflows"){
+        std::vector<int> values(100, std::numeric_limits<int>::max() / 3);
+
+        WHEN("average is calculated from iterate"){
+
+            double average = 0;
+            rxs::iterate(values).average().subscribe([&](double v){average = v;});
+
+            THEN("the result matches the values folded one at a time"){
+                double expected_average = 0;
+                rxs::iterate(values).as_dynamic().average().subscribe([&](double v){expected_average = v;});
+
+                REQUIRE(expected_average == average);
+            }
+        }
+    }
+}
+
+SCENARIO("reduce a range", "[reduce][sum][max][min][operators]"){
+    GIVEN("ranges that step up, step down, miss the last value and hold one value"){
+        struct range_args { int first; int last; std::ptrdiff_t step; };
+        auto ranges = std::vector<range_args>{
+            {1, 1000, 1},
+            {-500, 1003, 7},
+            {1000, -37, -3},
+            {5, 5, 2},
+            {std::numeric_limits<int>::max() - 10, std::numeric_limits<int>::max(), 1},
+            {0, 100000, 1}
+        };
+
+        WHEN("sum, max and min are calculated from range"){
+
+            THEN("the results match the values folded one at a time"){
+                for (auto& r : ranges) {
+                    long long expected_sum = 0;
+                    int expected_max = std::numeric_limits<int>::min();
+                    int expected_min = std::numeric_limits<int>::max();
+                    rxs::range(r.first, r.last, r.step).subscribe([&](int v){
+                        expected_sum += v;
+                        expected_max = std::max(expected_max, v);
+                        expected_min = std::min(expected_min, v);
+                    });
+
+                    if (expected_sum <= std::numeric_limits<int>::max()) {
+                        int sum = 0;
+                        rxs::range(r.first, r.last, r.step).sum().subscribe([&](int v){sum = v;});
+                        REQUIRE(expected_sum == sum);
+                    }
+                    long long wide_sum = 0;
+                    rxs::range<long long>(r.first, r.last, r.step).sum().subscribe([&](long long v){wide_sum = v;});
+                    REQUIRE(expected_sum == wide_sum);
+
+                    int max = 0;
+                    int min = 0;
+                    rxs::range(r.first, r.last, r.step).max().subscribe([&](int v){max = v;});
+                    rxs::range(r.first, r.last, r.step).min().subscribe([&](int v){min = v;});
+                    REQUIRE(expected_max == max);
+                    REQUIRE(expected_min == min);
+
+                    REQUIRE(expected_sum == rxs::range<long long>(r.first, r.last, r.step).as_blocking().sum());
+                    REQUIRE(expected_max == rxs::range(r.first, r.last, r.step).as_blocking().max());
+                    REQUIRE(expected_min == rxs::range(r.first, r.last, r.step).as_blocking().min());
+                }
+            }
+        }
+    }
+}
+
+// Does not work because calling sum() on an empty stream throws an exception
+// which will crash when exceptions are disabled.
+SCENARIO("reduce an empty contiguous collection", "[reduce][sum][operators][!throws]"){
+    GIVEN("an empty vector of ints"){
+        std::vector<int> values;
+
+        WHEN("sum is calculated from iterate"){
+
+            bool failed = false;
+            rxs::iterate(values).sum().subscribe([](int){}, [&](rxu::error_ptr){failed = true;});
+
+            THEN("the output contains an error"){
+                REQUIRE(failed);
+            }
+        }
+    }
+}
@@ -279,8 +279,8 @@ SCENARIO("sequence_equal - second source emits less items than the first one", "
 
             THEN("the output contains false"){
                 auto required = rxu::to_vector({
-                    o_on.next(610, false),
-                    o_on.completed(610)
+                    o_on.next(600, false),
+                    o_on.completed(600)
                 });
                 auto actual = res.get_observer().messages();
                 REQUIRE(required == actual);
@@ -288,7 +288,7 @@ SCENARIO("sequence_equal - second source emits less items than the first one", "
 
             THEN("there was 1 subscription/unsubscription to the source"){
                 auto required = rxu::to_vector({
-                    on.subscribe(200, 610)
+                    on.subscribe(200, 600)
                 });
                 auto actual = xs.subscriptions();
                 REQUIRE(required == actual);
@@ -437,8 +437,8 @@ SCENARIO("sequence_equal - source observable is empty", "[sequence_equal][operat
 
             THEN("the output contains false"){
                 auto required = rxu::to_vector({
-                    o_on.next(330, false),
-                    o_on.completed(330)
+                    o_on.next(250, false),
+                    o_on.completed(250)
                 });
                 auto actual = res.get_observer().messages();
                 REQUIRE(required == actual);
@@ -485,8 +485,8 @@ SCENARIO("sequence_equal - other observable is empty", "[sequence_equal][operato
 
             THEN("the output contains false"){
                 auto required = rxu::to_vector({
-                    o_on.next(310, false),
-                    o_on.completed(310)
+                    o_on.next(250, false),
+                    o_on.completed(250)
                 });
                 auto actual = res.get_observer().messages();
                 REQUIRE(required == actual);
@@ -494,7 +494,7 @@ SCENARIO("sequence_equal - other observable is empty", "[sequence_equal][operato
 
             THEN("there was 1 subscription/unsubscription to the source"){
                 auto required = rxu::to_vector({
-                    on.subscribe(200, 310)
+                    on.subscribe(200, 250)
                 });
                 auto actual = xs.subscriptions();
                 REQUIRE(required == actual);
@@ -860,3 +860,148 @@ SCENARIO("sequence_equal - both sources emit the same sequence of items, custom
         }
     }
 }
+
+SCENARIO("sequence_equal - other source completes while the source is ahead", "[sequence_equal][operators]"){
+    GIVEN("two sources"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        const rxsc::test::messages<bool> o_on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2),
+            on.next(220, 3),
+            on.next(230, 4),
+            on.completed(700)
+        });
+
+        auto ys = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(300, 2),
+            on.completed(400)
+        });
+
+        WHEN("two observables are checked for equality"){
+
+            auto res = w.start(
+                [xs, ys]() {
+                    return xs
+                            .sequence_equal(ys)
+                            .as_dynamic(); // forget type to workaround lambda deduction bug on msvc 2013
+                }
+            );
+
+            THEN("the output contains false as soon as the other source completes"){
+                auto required = rxu::to_vector({
+                    o_on.next(400, false),
+                    o_on.completed(400)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 400)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("sequence_equal - max_lag", "[sequence_equal][operators]"){
+    GIVEN("an other source that stays 3 items ahead of the source"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        const rxsc::test::messages<bool> o_on;
+
+        std::vector<rxsc::test::messages<int>::recorded_type> source_items;
+        std::vector<rxsc::test::messages<int>::recorded_type> other_items;
+        for (int i = 0; i < 50; ++i) {
+            source_items.push_back(on.next(230 + 10 * i, i));
+            other_items.push_back(on.next(205 + 10 * i, i));
+        }
+        source_items.push_back(on.completed(800));
+        other_items.push_back(on.completed(750));
+
+        auto xs = sc.make_hot_observable(source_items);
+        auto ys = sc.make_hot_observable(other_items);
+
+        WHEN("the lag is limited to 3 items"){
+
+            auto res = w.start(
+                [xs, ys]() {
+                    return xs
+                            .sequence_equal(ys, rxo::max_lag(3))
+                            .as_dynamic(); // forget type to workaround lambda deduction bug on msvc 2013
+                }
+            );
+
+            THEN("the output contains true"){
+                auto required = rxu::to_vector({
+                    o_on.next(800, true),
+                    o_on.completed(800)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("the lag is limited to 2 items"){
+
+            auto res = w.start(
+                [xs, ys]() {
+                    return xs
+                            .sequence_equal(ys, rxo::max_lag(2))
+                            .as_dynamic(); // forget type to workaround lambda deduction bug on msvc 2013
+                }
+            );
+
+            THEN("the output contains an error when the other source is 3 items ahead"){
+                rxcpp::sequence_lag_error ex("sequence_equal max_lag exceeded");
+                auto required = rxu::to_vector({
+                    o_on.error(225, ex)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 225)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("sequence_equal - long synchronous sequences", "[sequence_equal][operators]"){
+    GIVEN("two ranges"){
+        WHEN("the other range completes before the source range is subscribed"){
+            auto equal = rxs::range(1, 100000)
+                .sequence_equal(rxs::range(1, 100000))
+                .as_blocking()
+                .first();
+
+            THEN("the sequences are equal"){
+                REQUIRE(equal);
+            }
+        }
+        WHEN("the ranges have different lengths"){
+            auto equal = rxs::range(1, 100000)
+                .sequence_equal(rxs::range(1, 100001))
+                .as_blocking()
+                .first();
+
+            THEN("the sequences are not equal"){
+                REQUIRE(!equal);
+            }
+        }
+    }
+}
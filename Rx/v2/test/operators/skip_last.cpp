@@ -1,5 +1,6 @@
 #include "../test.h"
 #include <rxcpp/operators/rx-skip_last.hpp>
+#include <rxcpp/operators/rx-map.hpp>
 
 SCENARIO("skip last 0", "[skip_last][operators]"){
     GIVEN("a source"){
@@ -277,3 +278,81 @@ SCENARIO("skip_last, source observable emits an error", "[skip_last][operators]"
         }
     }
 }
+
+SCENARIO("skip_last wraps around", "[skip_last][operators]"){
+    GIVEN("a range that is many times longer than the count"){
+        auto xs = rxs::range(1, 1000);
+
+        WHEN("the last 7 values are skipped"){
+            std::vector<int> actual;
+            xs.skip_last(7).subscribe([&](int v){
+                actual.push_back(v);
+            });
+
+            THEN("the output contains all but the last 7 values in order"){
+                std::vector<int> required;
+                for (int i = 1; i <= 993; ++i) {
+                    required.push_back(i);
+                }
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+namespace {
+// not assignable, so the buffer must construct each item in its slot
+struct skip_last_const_value
+{
+    explicit skip_last_const_value(int v) : value(v) {}
+    const int value;
+};
+}
+
+SCENARIO("skip_last of values that are not assignable", "[skip_last][operators]"){
+    GIVEN("a range mapped to values with a const member"){
+        auto xs = rxs::range(1, 10)
+            .map([](int v){ return skip_last_const_value(v); });
+
+        WHEN("the last 3 values are skipped"){
+            std::vector<int> actual;
+            xs.skip_last(3).subscribe([&](const skip_last_const_value& v){
+                actual.push_back(v.value);
+            });
+
+            THEN("the output contains the first 7 values in order"){
+                auto required = rxu::to_vector({1, 2, 3, 4, 5, 6, 7});
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("skip_last buffer of move-only values", "[skip_last][operators]"){
+    GIVEN("a ring buffer of unique_ptr with a capacity of 2"){
+        rxu::ring_buffer<std::unique_ptr<int>> items(2);
+
+        WHEN("5 values are pushed and each one rotates out the oldest when full"){
+            std::vector<int> actual;
+            for (int i = 1; i <= 5; ++i) {
+                std::unique_ptr<int> v(new int(i));
+                if (items.full()) {
+                    actual.push_back(*items.rotate(std::move(v)));
+                } else {
+                    items.push_back(std::move(v));
+                }
+            }
+
+            THEN("the first 3 values are rotated out in order"){
+                auto required = rxu::to_vector({1, 2, 3});
+                REQUIRE(required == actual);
+            }
+
+            THEN("the last 2 values remain in order"){
+                REQUIRE(*items.pop_front() == 4);
+                REQUIRE(*items.pop_front() == 5);
+                REQUIRE(items.empty());
+            }
+        }
+    }
+}
@@ -1,5 +1,6 @@
 #include "../test.h"
 #include <rxcpp/operators/rx-switch_on_next.hpp>
+#include <rxcpp/operators/rx-map.hpp>
 
 SCENARIO("switch_on_next - some changes", "[switch_on_next][operators]"){
     GIVEN("a source"){
@@ -382,3 +383,92 @@ SCENARIO("switch_on_next - inner completes", "[switch_on_next][operators]"){
         }
     }
 }
+
+SCENARIO("switch_on_next - late items from a replaced inner", "[switch_on_next][operators]"){
+    GIVEN("a source"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+        const rxsc::test::messages<rx::observable<int>> o_on;
+
+        // keeps the observer of the first inner so that it can be called
+        // after the inner has been replaced, like an item that was in
+        // flight when the switch happened
+        std::vector<rx::observer<int>> stale;
+        auto ys1 = rx::observable<>::create<int>(
+            [&](rx::subscriber<int> s){
+                stale.push_back(s.get_observer());
+            }).as_dynamic();
+
+        auto ys2 = sc.make_cold_observable({
+            on.next(50, 201),
+            on.completed(200)
+        });
+
+        auto xs = sc.make_hot_observable({
+            o_on.next(300, ys1),
+            o_on.next(400, ys2),
+            o_on.completed(500)
+        });
+
+        WHEN("the first inner sends after the switch"){
+
+            w.schedule_absolute(420, [&](const rxsc::schedulable&){
+                stale.front().on_next(101);});
+            w.schedule_absolute(550, [&](const rxsc::schedulable&){
+                stale.front().on_completed();});
+
+            auto res = w.start(
+                [xs]() {
+                    return xs.switch_on_next();
+                }
+            );
+
+            THEN("the output only contains items from the current inner"){
+                auto required = rxu::to_vector({
+                    on.next(450, 201),
+                    on.completed(600)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to ys2"){
+                auto required = rxu::to_vector({
+                    on.subscribe(400, 600)
+                });
+                auto actual = ys2.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("switch_on_next - many synchronous switches", "[switch_on_next][operators]"){
+    GIVEN("a source of 10000 inners"){
+        const int count = 10000;
+        auto xs = rx::observable<>::range(1, count)
+            .map([](int i){
+                return rx::observable<>::just(i);
+            });
+
+        WHEN("each inner is switched to"){
+
+            std::vector<int> actual;
+            bool completed = false;
+            xs.switch_on_next().subscribe(
+                [&](int i){
+                    actual.push_back(i);
+                },
+                [&](){
+                    completed = true;
+                });
+
+            THEN("the output contains every item and completes"){
+                REQUIRE(actual.size() == static_cast<std::size_t>(count));
+                REQUIRE(actual.back() == count);
+                REQUIRE(completed);
+            }
+        }
+    }
+}
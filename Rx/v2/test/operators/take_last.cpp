@@ -1,5 +1,6 @@
 #include "../test.h"
 #include <rxcpp/operators/rx-take_last.hpp>
+#include <rxcpp/operators/rx-map.hpp>
 
 SCENARIO("take last 0", "[take_last][operators]"){
     GIVEN("a source"){
@@ -275,3 +276,76 @@ SCENARIO("take_last, source observable emits an error", "[take_last][operators]"
         }
     }
 }
+
+SCENARIO("take_last wraps around", "[take_last][operators]"){
+    GIVEN("a range that is many times longer than the count"){
+        auto xs = rxs::range(1, 1000);
+
+        WHEN("the last 7 values are taken"){
+            std::vector<int> actual;
+            xs.take_last(7).subscribe([&](int v){
+                actual.push_back(v);
+            });
+
+            THEN("the output contains the last 7 values in order"){
+                auto required = rxu::to_vector({994, 995, 996, 997, 998, 999, 1000});
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+namespace {
+// not assignable, so the buffer must construct each item in its slot
+struct take_last_const_value
+{
+    explicit take_last_const_value(int v) : value(v) {}
+    const int value;
+};
+}
+
+SCENARIO("take_last of values that are not assignable", "[take_last][operators]"){
+    GIVEN("a range mapped to values with a const member"){
+        auto xs = rxs::range(1, 1000)
+            .map([](int v){ return take_last_const_value(v); });
+
+        WHEN("the last 3 values are taken"){
+            std::vector<int> actual;
+            xs.take_last(3).subscribe([&](const take_last_const_value& v){
+                actual.push_back(v.value);
+            });
+
+            THEN("the output contains the last 3 values in order"){
+                auto required = rxu::to_vector({998, 999, 1000});
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("take_last buffer of move-only values", "[take_last][operators]"){
+    GIVEN("a ring buffer of unique_ptr with a capacity of 2"){
+        rxu::ring_buffer<std::unique_ptr<int>> items(2);
+
+        WHEN("5 values are pushed and each one overwrites the oldest when full"){
+            for (int i = 1; i <= 5; ++i) {
+                std::unique_ptr<int> v(new int(i));
+                if (items.full()) {
+                    items.overwrite(std::move(v));
+                } else {
+                    items.push_back(std::move(v));
+                }
+            }
+            std::vector<int> actual;
+            items.drain([&](std::unique_ptr<int>&& v){
+                actual.push_back(*v);
+            });
+
+            THEN("the last 2 values are drained in order"){
+                auto required = rxu::to_vector({4, 5});
+                REQUIRE(required == actual);
+                REQUIRE(items.empty());
+            }
+        }
+    }
+}
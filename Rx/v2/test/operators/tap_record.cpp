@@ -0,0 +1,259 @@
+#include "../test.h"
+#include "rxcpp/operators/rx-tap_record.hpp"
+#include "rxcpp/operators/rx-take.hpp"
+#include "rxcpp/operators/rx-tap.hpp"
+
+namespace {
+
+struct string_serializer
+{
+    void serialize(const std::string& v, std::string& out) const {
+        out.append(v);
+    }
+    std::string deserialize(const char* data, std::size_t size) const {
+        return std::string(data, size);
+    }
+};
+
+}
+
+SCENARIO("tap_record log replays in virtual time", "[tap_record][replay_log][operators]"){
+    GIVEN("a source recorded under the test scheduler"){
+        const std::string path = "tap_record_virtual.rxlog";
+
+        auto sc = rxsc::make_test();
+        auto so = rx::synchronize_in_one_worker(sc);
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(210, 2),
+            on.next(240, 3),
+            on.next(300, 4),
+            on.completed(400)
+        });
+
+        auto recorded = w.start(
+            [&]() {
+                return xs
+                    | rxo::tap_record(path, so);
+            }
+        );
+
+        WHEN("the log is replayed at the recorded speed"){
+
+            auto sc2 = rxsc::make_test();
+            auto so2 = rx::synchronize_in_one_worker(sc2);
+            auto w2 = sc2.create_worker();
+
+            auto res = w2.start(
+                [&]() {
+                    return rxs::replay_log<int>(path, so2);
+                }
+            );
+
+            THEN("the recording passed the notifications on"){
+                auto required = rxu::to_vector({
+                    on.next(210, 2),
+                    on.next(240, 3),
+                    on.next(300, 4),
+                    on.completed(400)
+                });
+                auto actual = recorded.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the replay sent the notifications at the recorded times"){
+                auto required = recorded.get_observer().messages();
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("the log is replayed as fast as possible"){
+
+            auto sc2 = rxsc::make_test();
+            auto so2 = rx::synchronize_in_one_worker(sc2);
+            auto w2 = sc2.create_worker();
+
+            auto res = w2.start(
+                [&]() {
+                    return rxs::replay_log<int>(path, so2, rxs::replay_log_speed::as_fast_as_possible);
+                }
+            );
+
+            THEN("the replay sent all the notifications in the first action"){
+                auto required = rxu::to_vector({
+                    on.next(201, 2),
+                    on.next(201, 3),
+                    on.next(201, 4),
+                    on.completed(201)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+
+        std::remove(path.c_str());
+    }
+}
+
+SCENARIO("tap_record log replays a large stream in chunks", "[tap_record][replay_log][operators]"){
+    GIVEN("a range recorded on the current thread"){
+        const std::string path = "tap_record_range.rxlog";
+        const int count = 20000;
+
+        long long recorded = 0;
+        rxs::range(1, count)
+            .tap_record(path)
+            .subscribe([&](int v){ recorded += v; });
+
+        WHEN("the log is replayed as fast as possible"){
+
+            std::vector<int> values;
+            bool completed = false;
+            rxs::replay_log<int>(path, rx::identity_current_thread(), rxs::replay_log_speed::as_fast_as_possible)
+                .subscribe(
+                    [&](int v){ values.push_back(v); },
+                    [&](){ completed = true; });
+
+            THEN("every value was replayed in order"){
+                REQUIRE(static_cast<std::size_t>(count) == values.size());
+                REQUIRE(completed);
+                long long sum = 0;
+                int unordered = 0;
+                for (int i = 0; i != count; ++i) {
+                    unordered += values[i] != i + 1;
+                    sum += values[i];
+                }
+                REQUIRE(0 == unordered);
+                REQUIRE(recorded == sum);
+            }
+        }
+
+        std::remove(path.c_str());
+    }
+}
+
+SCENARIO("tap_record log keeps errors and early unsubscribes", "[tap_record][replay_log][operators]"){
+    GIVEN("sources that fail or are cut short"){
+        const std::string path = "tap_record_error.rxlog";
+
+        WHEN("an error is recorded and replayed"){
+
+            rxs::error<int>(std::runtime_error("tap_record on_error"))
+                .tap_record(path)
+                .subscribe([](int){}, [](rxu::error_ptr){});
+
+            std::string what;
+            rxs::replay_log<int>(path, rx::identity_current_thread(), rxs::replay_log_speed::as_fast_as_possible)
+                .subscribe([](int){}, [&](rxu::error_ptr e){ what = rxu::what(e); });
+
+            THEN("the replay sent the recorded error"){
+                REQUIRE(std::string("tap_record on_error") == what);
+            }
+        }
+
+        WHEN("the recording is unsubscribed after three values"){
+
+            rxs::range(1, 100)
+                .tap_record(path)
+                .take(3)
+                .subscribe([](int){});
+
+            std::vector<int> values;
+            bool completed = false;
+            rxs::replay_log<int>(path, rx::identity_current_thread(), rxs::replay_log_speed::as_fast_as_possible)
+                .subscribe(
+                    [&](int v){ values.push_back(v); },
+                    [&](){ completed = true; });
+
+            THEN("the replay sent the three values and completed at the end of the log"){
+                auto required = rxu::to_vector({1, 2, 3});
+                REQUIRE(required == values);
+                REQUIRE(completed);
+            }
+        }
+
+        WHEN("a log that does not exist is replayed"){
+
+            bool failed = false;
+            rxs::replay_log<int>("tap_record_missing.rxlog", rx::identity_current_thread(), rxs::replay_log_speed::as_fast_as_possible)
+                .subscribe([](int){}, [&](rxu::error_ptr){ failed = true; });
+
+            THEN("the replay sent an error"){
+                REQUIRE(failed);
+            }
+        }
+
+        std::remove(path.c_str());
+    }
+}
+
+SCENARIO("tap_record log that cannot be written", "[tap_record][operators]"){
+    GIVEN("a range of ints"){
+        auto xs = rxs::range(1, 100000);
+
+        WHEN("the log is in a directory that does not exist"){
+
+            int received = 0;
+            bool failed = false;
+            xs
+                .tap_record("tap_record_missing_directory/tap_record.rxlog")
+                .subscribe(
+                    [&](int){ ++received; },
+                    [&](rxu::error_ptr){ failed = true; });
+
+            THEN("the subscriber received an error and no values"){
+                REQUIRE(failed);
+                REQUIRE(received == 0);
+            }
+        }
+
+#if defined(__linux__)
+        WHEN("the log is on a device that is full"){
+
+            int produced = 0;
+            int received = 0;
+            bool failed = false;
+            xs
+                .tap([&](int){ ++produced; })
+                .tap_record("/dev/full")
+                .subscribe(
+                    [&](int){ ++received; },
+                    [&](rxu::error_ptr){ failed = true; });
+
+            THEN("the subscriber received an error and the source stopped"){
+                REQUIRE(failed);
+                REQUIRE(received + 1 == produced);
+                REQUIRE(produced < 100000);
+            }
+        }
+#endif
+    }
+}
+
+SCENARIO("tap_record log uses a serializer", "[tap_record][replay_log][operators]"){
+    GIVEN("strings recorded with a serializer"){
+        const std::string path = "tap_record_strings.rxlog";
+
+        rxs::from(std::string("a"), std::string(""), std::string("a longer string"))
+            .tap_record(path, string_serializer())
+            .subscribe([](const std::string&){});
+
+        WHEN("the log is replayed with the same serializer"){
+
+            std::vector<std::string> values;
+            rxs::replay_log<std::string>(path, rx::identity_current_thread(), rxs::replay_log_speed::as_fast_as_possible, string_serializer())
+                .subscribe([&](const std::string& v){ values.push_back(v); });
+
+            THEN("the strings were replayed"){
+                auto required = rxu::to_vector({std::string("a"), std::string(""), std::string("a longer string")});
+                REQUIRE(required == values);
+            }
+        }
+
+        std::remove(path.c_str());
+    }
+}
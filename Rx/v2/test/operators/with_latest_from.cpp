@@ -1643,3 +1643,52 @@ SCENARIO("with_latest_from typical N", "[with_latest_from][join][operators]"){
         }
     }
 }
+
+SCENARIO("with_latest_from selector with non-const references", "[with_latest_from][join][operators]"){
+    GIVEN("2 hot observables of ints."){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto o1 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(215, 2),
+            on.completed(230)
+        });
+
+        auto o2 = sc.make_hot_observable({
+            on.next(150, 1),
+            on.next(220, 10),
+            on.next(225, 20),
+            on.completed(240)
+        });
+
+        WHEN("the selector changes the values that it is given"){
+
+            auto res = w.start(
+                [&]() {
+                    return o2
+                        .with_latest_from(
+                            [](int& v2, int& v1){
+                                v1 += 100;
+                                return v2 + v1;
+                            },
+                            o1
+                        )
+                        // forget type to workaround lambda deduction bug on msvc 2013
+                        .as_dynamic();
+                }
+            );
+
+            THEN("the selector was given copies of the latest values"){
+                auto required = rxu::to_vector({
+                    on.next(220, 10 + 102),
+                    on.next(225, 20 + 102),
+                    on.completed(240)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
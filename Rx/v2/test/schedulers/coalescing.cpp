@@ -0,0 +1,62 @@
+#include "../test.h"
+
+#include <future>
+
+SCENARIO("coalescing removes cancelled actions from their tick", "[coalescing][scheduler]"){
+    GIVEN("a coalescing state on a new_thread worker"){
+        using namespace std::chrono;
+        typedef rxsc::detail::coalescing_state state_type;
+
+        rx::composite_subscription source_lifetime;
+        auto st = std::make_shared<state_type>(rxsc::make_new_thread().create_worker(source_lifetime), milliseconds(10));
+        auto w = rxsc::make_new_thread().create_worker(source_lifetime);
+
+        WHEN("a one hour timeout is re-armed many times"){
+
+            const int count = 10000;
+            rx::composite_subscription timeout;
+            std::size_t most = 0;
+            for (int i = 0; i < count; ++i) {
+                timeout.unsubscribe();
+                timeout = rx::composite_subscription();
+                st->push(st->source.now() + hours(1), rxsc::make_schedulable(w, timeout, [](const rxsc::schedulable&){}));
+                most = std::max(most, st->pending());
+            }
+
+            THEN("only the armed timeout is waiting"){
+                REQUIRE(1 == most);
+                REQUIRE(1 == st->pending());
+            }
+
+            timeout.unsubscribe();
+
+            THEN("nothing is waiting once it is cancelled"){
+                REQUIRE(0 == st->pending());
+            }
+        }
+
+        WHEN("a short timeout is re-armed and then left to fire"){
+
+            std::atomic<int> fired(0);
+            std::promise<void> done;
+            rx::composite_subscription timeout;
+            for (int i = 0; i < 100; ++i) {
+                timeout.unsubscribe();
+                timeout = rx::composite_subscription();
+                st->push(st->source.now() + milliseconds(20), rxsc::make_schedulable(w, timeout, [&](const rxsc::schedulable&){
+                    if (++fired == 1) {
+                        done.set_value();
+                    }
+                }));
+            }
+            done.get_future().wait();
+
+            THEN("only the last timeout ran"){
+                REQUIRE(1 == fired);
+                REQUIRE(0 == st->pending());
+            }
+        }
+
+        source_lifetime.unsubscribe();
+    }
+}
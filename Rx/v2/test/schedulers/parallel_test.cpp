@@ -0,0 +1,248 @@
+#include "../test.h"
+
+namespace {
+
+// each worker appends "<worker>:<tick>" for five ticks and each action
+// also records the order of the actions of its worker.
+std::vector<std::vector<std::string>> run_simulation(std::size_t concurrency, long& clock) {
+    auto sc = rxsc::make_parallel_test(concurrency);
+
+    const int workers = 8;
+    std::vector<std::vector<std::string>> logs(workers);
+    std::vector<rxsc::parallel_test::test_worker> ws;
+    for (int i = 0; i != workers; ++i) {
+        ws.push_back(sc.create_worker());
+    }
+
+    for (int i = 0; i != workers; ++i) {
+        auto w = ws[i];
+        auto& log = logs[i];
+        auto remaining = std::make_shared<int>(5);
+        w.schedule_absolute(10 * (i % 3) + 1, [=, &log](const rxsc::schedulable& self){
+            log.push_back(std::to_string(i) + ":" + std::to_string(w.clock()));
+            if (--*remaining > 0) {
+                self.schedule();
+            }
+        });
+        // a second action of the same worker at the same tick runs after the first
+        w.schedule_absolute(10 * (i % 3) + 1, [=, &log](const rxsc::schedulable&){
+            log.push_back(std::to_string(i) + ":second");
+        });
+    }
+
+    sc.start();
+    clock = sc.clock();
+    return logs;
+}
+
+}
+
+SCENARIO("parallel_test runs each worker in order", "[parallel_test][scheduler]"){
+    GIVEN("eight workers that each reschedule an action four times"){
+
+        WHEN("the simulation is run with one and with four threads"){
+
+            long clock1 = 0, clock4 = 0;
+            auto serial = run_simulation(1, clock1);
+            auto parallel = run_simulation(4, clock4);
+
+            THEN("the actions of each worker ran in the order they were scheduled"){
+                for (int i = 0; i != 8; ++i) {
+                    long first = 10 * (i % 3) + 1;
+                    auto required = rxu::to_vector({
+                        std::to_string(i) + ":" + std::to_string(first),
+                        std::to_string(i) + ":second",
+                        std::to_string(i) + ":" + std::to_string(first + 1),
+                        std::to_string(i) + ":" + std::to_string(first + 2),
+                        std::to_string(i) + ":" + std::to_string(first + 3),
+                        std::to_string(i) + ":" + std::to_string(first + 4)
+                    });
+                    REQUIRE(required == serial[i]);
+                }
+            }
+
+            THEN("the results do not depend on the number of threads"){
+                REQUIRE(serial == parallel);
+                REQUIRE(clock1 == 25);
+                REQUIRE(clock4 == 25);
+            }
+        }
+    }
+}
+
+SCENARIO("parallel_test queues the actions scheduled in a tick in worker order", "[parallel_test][scheduler]"){
+    GIVEN("workers that each schedule an action on the first worker in the same tick"){
+
+        auto run = [](std::size_t concurrency){
+            auto sc = rxsc::make_parallel_test(concurrency);
+            std::vector<rxsc::parallel_test::test_worker> ws;
+            for (int i = 0; i != 6; ++i) {
+                ws.push_back(sc.create_worker());
+            }
+            // only the first worker appends, so the vector is not shared between threads
+            std::vector<int> order;
+            auto target = ws[0];
+            for (int i = 5; i >= 0; --i) {
+                ws[i].schedule_absolute(5, [=, &order](const rxsc::schedulable&){
+                    target.schedule([=, &order](const rxsc::schedulable&){
+                        order.push_back(i);
+                    });
+                });
+            }
+            sc.start();
+            return order;
+        };
+
+        WHEN("the simulation is run repeatedly"){
+
+            auto required = rxu::to_vector({0, 1, 2, 3, 4, 5});
+
+            THEN("each run recorded the actions in the order of the workers that scheduled them"){
+                REQUIRE(required == run(1));
+                for (int i = 0; i != 20; ++i) {
+                    REQUIRE(required == run(4));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("parallel_test numbers the workers created in a tick in worker order", "[parallel_test][scheduler]"){
+    GIVEN("workers that each create a worker in the same tick"){
+
+        auto run = [](std::size_t concurrency){
+            auto sc = rxsc::make_parallel_test(concurrency);
+            std::vector<rxsc::parallel_test::test_worker> ws;
+            for (int i = 0; i != 6; ++i) {
+                ws.push_back(sc.create_worker());
+            }
+            // only the target appends, so the vector is not shared between threads
+            std::vector<int> order;
+            auto target = sc.create_worker();
+            for (int i = 5; i >= 0; --i) {
+                ws[i].schedule_absolute(5, [=, &order](const rxsc::schedulable&){
+                    // on threads, the later workers create theirs first
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5 - i));
+                    // the new workers run in the order of their ids in the next tick
+                    auto created = sc.create_worker();
+                    created.schedule_absolute(10, [=, &order](const rxsc::schedulable&){
+                        target.schedule([=, &order](const rxsc::schedulable&){
+                            order.push_back(i);
+                        });
+                    });
+                });
+            }
+            sc.start();
+            return order;
+        };
+
+        WHEN("the simulation is run repeatedly"){
+
+            auto required = rxu::to_vector({0, 1, 2, 3, 4, 5});
+
+            THEN("each run numbered the new workers in the order of the workers that created them"){
+                REQUIRE(required == run(1));
+                for (int i = 0; i != 20; ++i) {
+                    REQUIRE(required == run(4));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("parallel_test skips empty time", "[parallel_test][scheduler]"){
+    GIVEN("a scheduler with actions far apart"){
+        auto sc = rxsc::make_parallel_test(2);
+        auto w = sc.create_worker();
+
+        std::vector<long> ticks;
+        w.schedule_absolute(100, [&](const rxsc::schedulable&){
+            ticks.push_back(w.clock());
+        });
+        w.schedule_absolute(1000000000L, [&](const rxsc::schedulable&){
+            ticks.push_back(w.clock());
+        });
+
+        WHEN("the clock is advanced past both actions"){
+
+            sc.advance_to(50);
+            auto before = sc.clock();
+            sc.advance_to(2000000000L);
+
+            THEN("the actions ran at their ticks and the clock moved to the end"){
+                REQUIRE(50 == before);
+                auto required = rxu::to_vector({100L, 1000000000L});
+                REQUIRE(required == ticks);
+                REQUIRE(2000000000L == sc.clock());
+            }
+        }
+
+        WHEN("the clock is advanced by a relative time"){
+
+            sc.advance_by(500);
+
+            THEN("only the first action ran"){
+                auto required = rxu::to_vector({100L});
+                REQUIRE(required == ticks);
+                REQUIRE(500 == sc.clock());
+            }
+        }
+    }
+}
+
+SCENARIO("parallel_test stops after the current tick", "[parallel_test][scheduler]"){
+    GIVEN("a worker that reschedules forever"){
+        auto sc = rxsc::make_parallel_test(2);
+        auto w = sc.create_worker();
+
+        long count = 0;
+        w.schedule_absolute(1, [&](const rxsc::schedulable& self){
+            if (++count == 10) {
+                sc.stop();
+            }
+            self.schedule();
+        });
+
+        WHEN("the action calls stop"){
+
+            sc.start();
+
+            THEN("start returned at that tick"){
+                REQUIRE(10 == count);
+                REQUIRE(10 == sc.clock());
+                REQUIRE(!sc.is_enabled());
+            }
+        }
+    }
+}
+
+SCENARIO("parallel_test rethrows an error from an action", "[parallel_test][scheduler]"){
+    GIVEN("two workers and an action that throws"){
+        auto sc = rxsc::make_parallel_test(2);
+        auto w1 = sc.create_worker();
+        auto w2 = sc.create_worker();
+
+        bool ran = false;
+        w1.schedule_absolute(1, [](const rxsc::schedulable&){
+            rxu::throw_exception(std::runtime_error("parallel_test action"));
+        });
+        w2.schedule_absolute(1, [&](const rxsc::schedulable&){
+            ran = true;
+        });
+
+        WHEN("the scheduler is started"){
+
+            bool thrown = false;
+            RXCPP_TRY {
+                sc.start();
+            } RXCPP_CATCH(const std::runtime_error&) {
+                thrown = true;
+            }
+
+            THEN("the error was thrown by start and the other worker ran"){
+                REQUIRE(thrown);
+                REQUIRE(ran);
+            }
+        }
+    }
+}
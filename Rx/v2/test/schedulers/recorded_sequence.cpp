@@ -0,0 +1,199 @@
+#include "../test.h"
+#include "rxcpp/operators/rx-map.hpp"
+#include "rxcpp/operators/rx-take.hpp"
+
+SCENARIO("recorded_sequence records a large hot observable", "[recorded_sequence][scheduler]"){
+    GIVEN("a hot observable loaded from columns"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        const int count = 100000;
+        std::vector<long> times;
+        std::vector<rxn::notification_kind::type> kinds;
+        std::vector<int> values;
+        for (int i = 0; i != count; ++i) {
+            times.push_back(150 + i / 4);
+            kinds.push_back(rxn::notification_kind::on_next);
+            values.push_back(i);
+        }
+        times.push_back(150 + count / 4);
+        kinds.push_back(rxn::notification_kind::on_completed);
+
+        auto xs = sc.make_hot_observable(rxn::recorded_sequence<int>(times, kinds, values, std::vector<rxu::error_ptr>()));
+
+        WHEN("the values are mapped"){
+
+            auto res = w.start(
+                [xs]() {
+                    return xs
+                        | rxo::map([](int x) {
+                            return x * 2;
+                        });
+                },
+                count
+            );
+
+            THEN("the output contains the mapped values after the subscription"){
+                rxn::recorded_sequence<int> required;
+                for (int i = 0; i != count; ++i) {
+                    if (times[i] > rxsc::test::subscribed_time) {
+                        required.on_next(times[i], i * 2);
+                    }
+                }
+                required.on_completed(150 + count / 4);
+                auto& actual = res.get_observer().records();
+                REQUIRE(required == actual);
+                REQUIRE(actual.size() == res.get_observer().messages().size());
+            }
+
+            THEN("the source kept the recorded columns"){
+                REQUIRE(static_cast<std::size_t>(count + 1) == xs.records().size());
+                REQUIRE(values == xs.records().values());
+            }
+        }
+    }
+}
+
+SCENARIO("recorded_sequence compares with recorded notifications", "[recorded_sequence][scheduler]"){
+    GIVEN("a sequence and the same notifications as a vector"){
+        const rxsc::test::messages<int> on;
+        std::runtime_error ex("recorded_sequence on_error");
+
+        auto messages = rxu::to_vector({
+            on.next(210, 1),
+            on.next(220, 2),
+            on.error(230, ex)
+        });
+        rxn::recorded_sequence<int> rs(messages);
+
+        WHEN("they are compared"){
+
+            THEN("they are equal in both directions"){
+                REQUIRE(rs == messages);
+                REQUIRE(messages == rs);
+                REQUIRE(messages == rs.messages());
+            }
+
+            THEN("a different value or time is not equal"){
+                auto value = rxu::to_vector({
+                    on.next(210, 1),
+                    on.next(220, 3),
+                    on.error(230, ex)
+                });
+                auto time = rxu::to_vector({
+                    on.next(210, 1),
+                    on.next(221, 2),
+                    on.error(230, ex)
+                });
+                auto kind = rxu::to_vector({
+                    on.next(210, 1),
+                    on.next(220, 2),
+                    on.completed(230)
+                });
+                REQUIRE(!(rs == value));
+                REQUIRE(!(rs == time));
+                REQUIRE(!(rs == kind));
+            }
+        }
+
+        WHEN("the columns do not match the kinds"){
+
+            bool thrown = false;
+            RXCPP_TRY {
+                rxn::recorded_sequence<int>(rs.times(), rs.kinds(), std::vector<int>(), rs.errors());
+            } RXCPP_CATCH(const std::invalid_argument&) {
+                thrown = true;
+            }
+
+            THEN("the sequence was rejected"){
+                REQUIRE(thrown);
+            }
+        }
+    }
+}
+
+SCENARIO("recorded_sequence is written and read in bulk", "[recorded_sequence][scheduler]"){
+    GIVEN("a sequence with values, an error and a completion"){
+        rxn::recorded_sequence<double> rs;
+        for (int i = 0; i != 1000; ++i) {
+            rs.on_next(100 + i, i / 2.0);
+        }
+        rs.on_error(2000, rxu::make_error_ptr(std::runtime_error("recorded_sequence write")));
+        rs.on_completed(3000);
+
+        WHEN("the sequence is written to a stream and read back"){
+
+            std::stringstream buffer;
+            rs.write(buffer);
+            auto loaded = rxn::recorded_sequence<double>::read(buffer);
+
+            THEN("the loaded sequence is equal and kept the error text"){
+                REQUIRE(rs == loaded);
+                REQUIRE(1u == loaded.errors().size());
+                REQUIRE(std::string("recorded_sequence write") == rxu::what(loaded.errors()[0]));
+            }
+        }
+
+        WHEN("a stream with another value type is read"){
+
+            std::stringstream buffer;
+            rs.write(buffer);
+
+            bool thrown = false;
+            RXCPP_TRY {
+                rxn::recorded_sequence<char>::read(buffer);
+            } RXCPP_CATCH(const std::runtime_error&) {
+                thrown = true;
+            }
+
+            THEN("read threw"){
+                REQUIRE(thrown);
+            }
+        }
+    }
+}
+
+SCENARIO("recorded_sequence replays a cold observable", "[recorded_sequence][scheduler]"){
+    GIVEN("a cold observable with several values at each time"){
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        rxn::recorded_sequence<int> rs;
+        rs.on_next(10, 1);
+        rs.on_next(10, 2);
+        rs.on_next(10, 3);
+        rs.on_next(20, 4);
+        rs.on_completed(30);
+
+        auto xs = sc.make_cold_observable(rs);
+
+        WHEN("two values are taken"){
+
+            auto res = w.start(
+                [xs]() {
+                    return xs.take(2);
+                }
+            );
+
+            THEN("the output stops in the middle of the first time"){
+                auto required = rxu::to_vector({
+                    on.next(210, 1),
+                    on.next(210, 2),
+                    on.completed(210)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 210)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
@@ -0,0 +1,106 @@
+#include "../test.h"
+
+SCENARIO("schedulable_queue compacts cancelled items", "[schedulable_queue][scheduler]"){
+    GIVEN("a queue of items where 90% are cancelled"){
+        typedef rxsc::detail::schedulable_queue<long> queue_type;
+        typedef queue_type::item_type item_type;
+
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+
+        queue_type q;
+        std::vector<rx::composite_subscription> lifetimes;
+        std::vector<long> expected;
+
+        const long count = 100000;
+        for (long i = 0; i < count; ++i) {
+            rx::composite_subscription cs;
+            // push in reverse time order so that the live items are not at the top
+            long when = count - i;
+            q.push(item_type(when, rxsc::make_schedulable(w, cs, [](const rxsc::schedulable&){})));
+            if (i % 10 == 0) {
+                lifetimes.push_back(cs);
+                expected.push_back(when);
+            } else {
+                cs.unsubscribe();
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+
+        WHEN("the items have been pushed"){
+
+            auto metrics = q.metrics();
+
+            THEN("the dead items were removed as the queue grew"){
+                REQUIRE(metrics.live == static_cast<std::size_t>(count / 10));
+                REQUIRE(metrics.compactions > 0);
+                REQUIRE(metrics.compacted + metrics.dead + metrics.live == static_cast<std::size_t>(count));
+                REQUIRE(q.size() < static_cast<std::size_t>(count / 2));
+            }
+        }
+
+        WHEN("the queue is compacted and drained"){
+
+            auto removed = q.compact();
+            auto metrics = q.metrics();
+
+            std::vector<long> actual;
+            while (!q.empty()) {
+                actual.push_back(q.top().when);
+                q.pop();
+            }
+
+            THEN("only the live items remain, in time order"){
+                REQUIRE(metrics.dead == 0);
+                REQUIRE(metrics.compacted >= removed);
+                REQUIRE(expected == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("schedulable_queue keeps fifo order for equal times", "[schedulable_queue][scheduler]"){
+    GIVEN("a queue with items that are due at the same time"){
+        typedef rxsc::detail::schedulable_queue<long> queue_type;
+        typedef queue_type::item_type item_type;
+
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+
+        queue_type q;
+        std::vector<int> actual;
+        std::vector<rx::composite_subscription> lifetimes;
+
+        for (int i = 0; i < 300; ++i) {
+            rx::composite_subscription cs;
+            lifetimes.push_back(cs);
+            q.push(item_type(100, rxsc::make_schedulable(w, cs, [&actual, i](const rxsc::schedulable&){
+                actual.push_back(i);
+            })));
+        }
+        for (int i = 0; i < 300; i += 3) {
+            lifetimes[i].unsubscribe();
+        }
+
+        WHEN("the queue is compacted and run"){
+
+            q.compact();
+            while (!q.empty()) {
+                auto what = q.top().what;
+                q.pop();
+                rxsc::recursion r(false);
+                what(r.get_recurse());
+            }
+
+            THEN("the remaining items run in the order they were pushed"){
+                std::vector<int> required;
+                for (int i = 0; i < 300; ++i) {
+                    if (i % 3 != 0) {
+                        required.push_back(i);
+                    }
+                }
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
@@ -0,0 +1,226 @@
+#include "rxcpp/rx-trace-metrics.hpp"
+// the schedulers in this test report to the metrics policy
+auto rxcpp_trace_activity(rxcpp::trace_tag) -> rxcpp::trace_scheduler_metrics;
+#include "../test.h"
+
+#include <future>
+
+namespace {
+
+std::uint64_t new_worker_id(const rx::trace_scheduler_snapshot& before, const rx::trace_scheduler_snapshot& after) {
+    for (auto& a : after.workers) {
+        auto found = std::find_if(before.workers.begin(), before.workers.end(),
+            [&](const rx::trace_worker_snapshot& b){return b.id == a.id;});
+        if (found == before.workers.end()) {
+            return a.id;
+        }
+    }
+    return 0;
+}
+
+rx::trace_worker_snapshot find_worker(const rx::trace_scheduler_snapshot& s, std::uint64_t id) {
+    auto found = std::find_if(s.workers.begin(), s.workers.end(),
+        [&](const rx::trace_worker_snapshot& w){return w.id == id;});
+    REQUIRE(found != s.workers.end());
+    return *found;
+}
+
+}
+
+SCENARIO("trace latency histogram buckets", "[trace][scheduler]"){
+    GIVEN("values across the range of the histogram"){
+        typedef rx::trace_latency_histogram histogram_type;
+        const std::size_t bucket_count = histogram_type::bucket_count;
+        std::vector<std::uint64_t> values = {0, 1, 7, 8, 9, 15, 16, 17, 100, 1000, 999999, 123456789, ~std::uint64_t(0)};
+        WHEN("each value is mapped to a bucket"){
+            THEN("the bucket holds the value and the bucket before it does not"){
+                for (auto v : values) {
+                    auto i = histogram_type::index_of(v);
+                    REQUIRE(i < bucket_count);
+                    REQUIRE(histogram_type::highest_equivalent(i) >= v);
+                    if (i > 0) {
+                        REQUIRE(histogram_type::highest_equivalent(i - 1) < v);
+                    }
+                }
+            }
+            THEN("the bucket width is within 1/8th of the value"){
+                for (auto v : values) {
+                    auto i = histogram_type::index_of(v);
+                    auto low = i == 0 ? 0 : histogram_type::highest_equivalent(i - 1) + 1;
+                    REQUIRE((histogram_type::highest_equivalent(i) - low) <= v / 8);
+                }
+            }
+        }
+        WHEN("1000 values are recorded"){
+            histogram_type h;
+            for (std::uint64_t v = 1; v <= 1000; ++v) {
+                ++h.counts[histogram_type::index_of(v)];
+            }
+            THEN("the percentiles are within the precision of the buckets"){
+                REQUIRE(h.count() == 1000);
+                auto p50 = h.percentile(50).count();
+                REQUIRE(p50 >= 500);
+                REQUIRE(p50 <= 500 + 500 / 8);
+                auto p99 = h.percentile(99).count();
+                REQUIRE(p99 >= 990);
+                REQUIRE(p99 <= 990 + 990 / 8);
+                REQUIRE(h.max().count() >= 1000);
+            }
+        }
+    }
+}
+
+SCENARIO("trace scheduler metrics snapshot", "[trace][scheduler]"){
+    GIVEN("the scheduler metrics trace policy"){
+        typedef rx::trace_scheduler_metrics trace_type;
+        trace_type trace;
+        auto before = trace.snapshot();
+
+        WHEN("a worker queue records activity"){
+            auto snapshot = [&](){
+                std::unique_ptr<trace_type::worker_data> w(new trace_type::worker_data());
+                auto now = trace_type::clock_type::now();
+                trace.worker_enqueue(*w, 1);
+                trace.worker_enqueue(*w, 2);
+                trace.worker_enqueue(*w, 3);
+                trace.worker_drop(*w, 1);
+                trace.worker_action_enter(*w, now - std::chrono::milliseconds(10), 1);
+                trace.worker_action_return(*w);
+                trace.worker_action_enter(*w, now, 0);
+                trace.worker_action_return(*w);
+                auto id = w->metrics->id;
+                auto live = trace.snapshot();
+                w.reset();
+                return std::make_pair(id, live);
+            }();
+
+            auto found = std::find_if(snapshot.second.workers.begin(), snapshot.second.workers.end(),
+                [&](const rx::trace_worker_snapshot& s){return s.id == snapshot.first;});
+
+            THEN("the live worker reports its counts"){
+                REQUIRE(found != snapshot.second.workers.end());
+                REQUIRE(found->enqueued == 3);
+                REQUIRE(found->executed == 2);
+                REQUIRE(found->dropped == 1);
+                REQUIRE(found->depth == 0);
+                REQUIRE(found->max_depth == 3);
+                REQUIRE(found->run.count() == 2);
+                REQUIRE(found->lag.count() == 2);
+                REQUIRE(found->lag.max() >= std::chrono::milliseconds(10));
+            }
+            THEN("the destroyed worker is folded into the retired totals"){
+                auto after = trace.snapshot();
+                REQUIRE(std::find_if(after.workers.begin(), after.workers.end(),
+                    [&](const rx::trace_worker_snapshot& s){return s.id == snapshot.first;}) == after.workers.end());
+                REQUIRE(after.retired_workers >= before.retired_workers + 1);
+                REQUIRE(after.retired_enqueued >= before.retired_enqueued + 3);
+                REQUIRE(after.retired_executed >= before.retired_executed + 2);
+                REQUIRE(after.retired_dropped >= before.retired_dropped + 1);
+            }
+        }
+    }
+}
+
+SCENARIO("trace scheduler metrics from a run_loop", "[trace][scheduler]"){
+    GIVEN("a run_loop with a late item, an item due now and a cancelled item"){
+        auto before = rx::trace_activity().snapshot();
+
+        rxsc::run_loop rl;
+        auto id = new_worker_id(before, rx::trace_activity().snapshot());
+        auto w = rl.get_scheduler().create_worker();
+
+        int ran = 0;
+        auto now = rl.now();
+        rx::composite_subscription cancelled;
+        w.schedule(now - std::chrono::milliseconds(20), cancelled, [&](const rxsc::schedulable&){++ran;});
+        w.schedule(now - std::chrono::milliseconds(10), [&](const rxsc::schedulable&){++ran;});
+        w.schedule(now, [&](const rxsc::schedulable&){++ran;});
+        cancelled.unsubscribe();
+
+        auto queued = find_worker(rx::trace_activity().snapshot(), id);
+
+        WHEN("the run_loop is dispatched until it is empty"){
+            while (!rl.empty()) {
+                rl.dispatch();
+            }
+            auto done = find_worker(rx::trace_activity().snapshot(), id);
+
+            THEN("the queued items were counted"){
+                REQUIRE(id != 0);
+                REQUIRE(queued.enqueued == 3);
+                REQUIRE(queued.depth == 3);
+                REQUIRE(queued.max_depth == 3);
+            }
+            THEN("the cancelled item was dropped and the others ran"){
+                REQUIRE(ran == 2);
+                REQUIRE(done.executed == 2);
+                REQUIRE(done.dropped == 1);
+                REQUIRE(done.depth == 0);
+                REQUIRE(done.run.count() == 2);
+            }
+            THEN("the lag of the late item was recorded"){
+                REQUIRE(done.lag.count() == 2);
+                REQUIRE(done.lag.max() >= std::chrono::milliseconds(10));
+            }
+        }
+    }
+}
+
+SCENARIO("trace scheduler metrics from a new_thread", "[trace][scheduler]"){
+    GIVEN("a new_thread worker that is blocked while items are queued behind it"){
+        auto before = rx::trace_activity().snapshot();
+
+        rx::composite_subscription lifetime;
+        auto w = rxsc::make_new_thread().create_worker(lifetime);
+        auto id = new_worker_id(before, rx::trace_activity().snapshot());
+
+        std::promise<void> started;
+        std::promise<void> release;
+        std::promise<void> finished;
+        auto released = release.get_future().share();
+
+        w.schedule([&](const rxsc::schedulable&){
+            started.set_value();
+            released.wait();
+        });
+        started.get_future().wait();
+
+        auto now = w.now();
+        rx::composite_subscription cancelled;
+        w.schedule(now - std::chrono::milliseconds(20), cancelled, [](const rxsc::schedulable&){});
+        w.schedule(now - std::chrono::milliseconds(10), [](const rxsc::schedulable&){});
+        w.schedule(now, [&](const rxsc::schedulable&){
+            finished.set_value();
+        });
+        cancelled.unsubscribe();
+
+        auto queued = find_worker(rx::trace_activity().snapshot(), id);
+
+        WHEN("the worker is released and runs the queue"){
+            release.set_value();
+            finished.get_future().wait();
+            // joins the thread, so the last action has returned
+            lifetime.unsubscribe();
+            auto done = find_worker(rx::trace_activity().snapshot(), id);
+
+            THEN("the queue depth was counted while the worker was blocked"){
+                REQUIRE(id != 0);
+                REQUIRE(queued.enqueued == 4);
+                REQUIRE(queued.depth == 3);
+                REQUIRE(queued.max_depth == 3);
+                REQUIRE(queued.executed == 0);
+            }
+            THEN("the cancelled item was dropped and the others ran"){
+                REQUIRE(done.enqueued == 4);
+                REQUIRE(done.executed == 3);
+                REQUIRE(done.dropped == 1);
+                REQUIRE(done.depth == 0);
+                REQUIRE(done.run.count() == 3);
+            }
+            THEN("the lag of the late item was recorded"){
+                REQUIRE(done.lag.count() == 3);
+                REQUIRE(done.lag.max() >= std::chrono::milliseconds(10));
+            }
+        }
+    }
+}
@@ -0,0 +1,160 @@
+#include "../test.h"
+#include "rxcpp/operators/rx-concat.hpp"
+#include "rxcpp/operators/rx-merge.hpp"
+#include "rxcpp/operators/rx-take.hpp"
+
+#include "cpplinq/linq.hpp"
+
+SCENARIO("from_linq sends the values of a query", "[from_linq][sources]"){
+    GIVEN("a query over a vector"){
+        std::vector<int> xs;
+        for (int i = 1; i <= 10; ++i) {
+            xs.push_back(i);
+        }
+
+        WHEN("the even values are sent"){
+
+            std::vector<int> actual;
+            int completions = 0;
+            rxs::from_linq(
+                    cpplinq::from(xs)
+                        .where([](int x){ return x % 2 == 0; })
+                        .select([](int x){ return x * 10; }))
+                .subscribe(
+                    [&](int v){
+                        actual.push_back(v);
+                    },
+                    [&](){
+                        ++completions;
+                    });
+
+            THEN("the output contains the values of the query and completes"){
+                auto required = rxu::to_vector({20, 40, 60, 80, 100});
+                REQUIRE(required == actual);
+                REQUIRE(1 == completions);
+            }
+        }
+    }
+}
+
+SCENARIO("from_linq yields to the current thread queue after each chunk", "[from_linq][sources]"){
+    GIVEN("two queries on the current thread"){
+        std::vector<int> xs = {1, 2, 3, 4, 5};
+        std::vector<int> ys = {10, 20, 30, 40, 50};
+
+        WHEN("merged with chunks of two"){
+
+            std::vector<int> actual;
+            rxs::from_linq(cpplinq::from(xs), rx::identity_current_thread(), 2)
+                .merge(rxs::from_linq(cpplinq::from(ys), rx::identity_current_thread(), 2))
+                .subscribe(
+                    [&](int v){
+                        actual.push_back(v);
+                    });
+
+            THEN("the chunks are interleaved"){
+                auto required = rxu::to_vector({1, 2, 10, 20, 3, 4, 30, 40, 5, 50});
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("from_linq sends an error thrown by the query", "[from_linq][sources]"){
+    GIVEN("a query with a selector that throws"){
+        std::runtime_error ex("from_linq on_error from query");
+
+        std::vector<int> xs = {1, 2, 3, 4, 5};
+
+        WHEN("the query is sent"){
+
+            std::vector<int> actual;
+            int errors = 0;
+            rxs::from_linq(
+                    cpplinq::from(xs)
+                        .select([ex](int x){ if (x == 3) { rxu::throw_exception(ex); } return x; }))
+                .subscribe(
+                    [&](int v){
+                        actual.push_back(v);
+                    },
+                    [&](rxu::error_ptr){
+                        ++errors;
+                    });
+
+            THEN("the output contains the values before the error and the error"){
+                auto required = rxu::to_vector({1, 2});
+                REQUIRE(required == actual);
+                REQUIRE(1 == errors);
+            }
+        }
+    }
+}
+
+SCENARIO("to_linq enumerates an observable through a bounded buffer", "[to_linq][sources]"){
+    GIVEN("a range larger than the buffer"){
+        auto xs = rxs::range(1, 10000);
+
+        WHEN("the even values are counted"){
+
+            auto count = xs.as_blocking().to_linq(16)
+                .where([](int x){ return x % 2 == 0; })
+                .count();
+
+            THEN("all the values were seen"){
+                REQUIRE(5000 == count);
+            }
+        }
+
+        WHEN("the query is enumerated twice"){
+
+            auto query = xs.as_blocking().to_linq(16);
+            auto first = query.sum();
+            auto second = query.sum();
+
+            THEN("each enumeration subscribes again"){
+                REQUIRE(50005000 == first);
+                REQUIRE(first == second);
+            }
+        }
+    }
+    GIVEN("a range that does not end"){
+        auto xs = rxs::range(1);
+
+        WHEN("the first values are taken"){
+
+            auto taken = xs.as_blocking().to_linq(4).take(3).to_vector();
+
+            THEN("the output contains the first values and the source is unsubscribed"){
+                auto required = rxu::to_vector({1, 2, 3});
+                REQUIRE(required == taken);
+            }
+        }
+    }
+}
+
+SCENARIO("to_linq rethrows the error of the observable", "[to_linq][sources]"){
+    GIVEN("an observable that fails after some values"){
+        std::runtime_error ex("to_linq on_error from source");
+
+        auto xs = rxs::range(1, 3).concat(rxs::error<int>(ex));
+
+        WHEN("the values are enumerated"){
+
+            std::vector<int> seen;
+            bool thrown = false;
+            RXCPP_TRY {
+                for (auto x : xs.as_blocking().to_linq()) {
+                    seen.push_back(x);
+                }
+            } RXCPP_CATCH(const std::runtime_error&) {
+                thrown = true;
+            }
+
+            THEN("the values before the error are seen and the error is thrown"){
+                auto required = rxu::to_vector({1, 2, 3});
+                REQUIRE(required == seen);
+                REQUIRE(thrown);
+            }
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#include "../test.h"
+#include "rxcpp/operators/rx-merge.hpp"
+#include "rxcpp/operators/rx-take.hpp"
+
+SCENARIO("range partially taken", "[range][sources]"){
+    GIVEN("a range on the current thread"){
+        WHEN("taking the first few values of a range that does not end"){
+
+            std::vector<int> actual;
+            int completions = 0;
+            rxs::range<int>(1)
+                .take(3)
+                .subscribe(
+                    [&](int v){
+                        actual.push_back(v);
+                    },
+                    [&](){
+                        ++completions;
+                    });
+
+            THEN("the output contains the first values and completes"){
+                auto required = rxu::to_vector({1, 2, 3});
+                REQUIRE(required == actual);
+                REQUIRE(1 == completions);
+            }
+        }
+    }
+}
+
+SCENARIO("range yields to the current thread queue", "[range][sources]"){
+    GIVEN("two ranges on the current thread"){
+        WHEN("merged"){
+
+            std::vector<int> actual;
+            rxs::range(1, 3, rx::identity_current_thread())
+                .merge(rxs::range(4, 6, rx::identity_current_thread()))
+                .subscribe(
+                    [&](int v){
+                        actual.push_back(v);
+                    });
+
+            THEN("the values are interleaved"){
+                auto required = rxu::to_vector({1, 4, 2, 5, 3, 6});
+                REQUIRE(required == actual);
+            }
+        }
+    }
+    GIVEN("two ranges on the immediate scheduler"){
+        WHEN("merged"){
+
+            std::vector<int> actual;
+            rxs::range(1, 3, rx::identity_immediate())
+                .merge(rxs::range(4, 6, rx::identity_immediate()))
+                .subscribe(
+                    [&](int v){
+                        actual.push_back(v);
+                    });
+
+            THEN("each range is emitted without interruption"){
+                auto required = rxu::to_vector({1, 2, 3, 4, 5, 6});
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("recursion is not allowed outside of an action", "[range][sources]"){
+    GIVEN("a schedulable that is not run by a scheduler"){
+        auto w = rxsc::make_current_thread().create_worker();
+        auto s = rxsc::make_schedulable(w, [](const rxsc::schedulable&){});
+
+        WHEN("it is asked whether it may recurse"){
+
+            THEN("recursion is not allowed"){
+                REQUIRE(!s.is_recursed());
+                REQUIRE(!s.is_recursion_allowed());
+            }
+        }
+    }
+}
@@ -22,3 +22,65 @@ SCENARIO("timer", "[!hide][periodically][timer][scheduler][long][perf][sources]"
         }
     }
 }
+
+SCENARIO("coalesced timers fire together", "[coalescing][timer][scheduler][sources]"){
+    GIVEN("a coalescing scheduler with a 50ms tick"){
+        WHEN("three actions are due at different times in the same tick"){
+            using namespace std::chrono;
+            typedef rxsc::scheduler::clock_type clock;
+
+            auto granularity = milliseconds(50);
+            auto sc = rxsc::make_coalescing(rxsc::make_new_thread(), granularity);
+            auto w = sc.create_worker();
+
+            // start just after a tick boundary so that all three are in the next tick
+            auto since = duration_cast<clock::duration>(granularity);
+            auto base = clock::time_point(((sc.now().time_since_epoch() / since) + 1) * since);
+            auto tick = base + granularity;
+
+            std::mutex lock;
+            std::vector<int> order;
+            std::vector<clock::time_point> fired;
+            std::vector<std::thread::id> threads;
+            std::promise<void> done;
+
+            for (int i = 0; i < 3; ++i) {
+                w.schedule(base + milliseconds(1 + (i * 20)), [&, i](const rxsc::schedulable&){
+                    std::unique_lock<std::mutex> guard(lock);
+                    order.push_back(i);
+                    fired.push_back(clock::now());
+                    threads.push_back(std::this_thread::get_id());
+                    if (i == 2) {
+                        done.set_value();
+                    }
+                });
+            }
+            done.get_future().wait();
+
+            THEN("the actions ran in order on one thread, none before the tick"){
+                auto required = rxu::to_vector({0, 1, 2});
+                REQUIRE(required == order);
+                for (auto& f : fired) {
+                    REQUIRE(f >= tick);
+                }
+                REQUIRE(threads[0] == threads[1]);
+                REQUIRE(threads[1] == threads[2]);
+            }
+            w.unsubscribe();
+        }
+    }
+    GIVEN("a timer on a coalesced coordination"){
+        WHEN("the timer is due"){
+            using namespace std::chrono;
+
+            auto cn = rx::identity_coalesced(rxsc::make_new_thread(), milliseconds(10));
+            auto result = rx::observable<>::timer(milliseconds(1), cn)
+                .as_blocking()
+                .last();
+
+            THEN("the timer emits its value"){
+                REQUIRE(1 == result);
+            }
+        }
+    }
+}
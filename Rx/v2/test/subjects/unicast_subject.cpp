@@ -0,0 +1,306 @@
+#include "../test.h"
+
+SCENARIO("window_subject - single subscriber", "[window_subject][subjects]"){
+    GIVEN("a window_subject and a hot source"){
+
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(110, 1),
+            on.next(220, 2),
+            on.next(270, 3),
+            on.next(340, 4),
+            on.completed(400)
+        });
+
+        rxsub::window_subject<int> s;
+
+        auto results1 = w.make_subscriber<int>();
+
+        WHEN("one subscriber is added"){
+
+            w.schedule_absolute(100, [&xs, &s](const rxsc::schedulable&){
+                xs.subscribe(s.get_subscriber());});
+            w.schedule_absolute(200, [&s, &results1](const rxsc::schedulable&){
+                s.get_observable().subscribe(results1);});
+
+            w.start();
+
+            THEN("result1 contains the items after it subscribed"){
+                auto required = rxu::to_vector({
+                    on.next(220, 2),
+                    on.next(270, 3),
+                    on.next(340, 4),
+                    on.completed(400)
+                });
+                auto actual = results1.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("window_subject - second subscriber", "[window_subject][subjects]"){
+    GIVEN("a window_subject and a hot source"){
+
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(220, 2),
+            on.next(270, 3),
+            on.next(340, 4),
+            on.next(410, 5),
+            on.completed(500)
+        });
+
+        rxsub::window_subject<int> s;
+
+        auto results1 = w.make_subscriber<int>();
+
+        auto results2 = w.make_subscriber<int>();
+
+        auto results3 = w.make_subscriber<int>();
+
+        WHEN("more subscribers are added"){
+
+            w.schedule_absolute(100, [&xs, &s](const rxsc::schedulable&){
+                xs.subscribe(s.get_subscriber());});
+            w.schedule_absolute(200, [&s, &results1](const rxsc::schedulable&){
+                s.get_observable().subscribe(results1);});
+            w.schedule_absolute(300, [&s, &results2](const rxsc::schedulable&){
+                s.get_observable().subscribe(results2);});
+            w.schedule_absolute(380, [&results1](const rxsc::schedulable&){
+                results1.unsubscribe();});
+            w.schedule_absolute(600, [&s, &results3](const rxsc::schedulable&){
+                s.get_observable().subscribe(results3);});
+
+            w.start();
+
+            THEN("result1 contains the items until it unsubscribed"){
+                auto required = rxu::to_vector({
+                    on.next(220, 2),
+                    on.next(270, 3),
+                    on.next(340, 4)
+                });
+                auto actual = results1.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("result2 contains the items after it subscribed"){
+                auto required = rxu::to_vector({
+                    on.next(340, 4),
+                    on.next(410, 5),
+                    on.completed(500)
+                });
+                auto actual = results2.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("result3 is completed when it subscribes"){
+                auto required = rxu::to_vector({
+                    on.completed(600)
+                });
+                auto actual = results3.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("window_subject - late subscriber after error", "[window_subject][subjects]"){
+    GIVEN("a window_subject and a hot source"){
+
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::runtime_error ex("window_subject on_error from source");
+
+        auto xs = sc.make_hot_observable({
+            on.next(220, 2),
+            on.error(300, ex)
+        });
+
+        rxsub::window_subject<int> s;
+
+        auto results1 = w.make_subscriber<int>();
+
+        auto results2 = w.make_subscriber<int>();
+
+        WHEN("subscribers are added before and after the error"){
+
+            w.schedule_absolute(100, [&xs, &s](const rxsc::schedulable&){
+                xs.subscribe(s.get_subscriber());});
+            w.schedule_absolute(200, [&s, &results1](const rxsc::schedulable&){
+                s.get_observable().subscribe(results1);});
+            w.schedule_absolute(400, [&s, &results2](const rxsc::schedulable&){
+                s.get_observable().subscribe(results2);});
+
+            w.start();
+
+            THEN("result1 contains the items and the error"){
+                auto required = rxu::to_vector({
+                    on.next(220, 2),
+                    on.error(300, ex)
+                });
+                auto actual = results1.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("result2 contains the error"){
+                auto required = rxu::to_vector({
+                    on.error(400, ex)
+                });
+                auto actual = results2.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("unicast_subject - items before the subscriber", "[unicast_subject][subjects]"){
+    GIVEN("a unicast_subject and a hot source"){
+
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(110, 1),
+            on.next(150, 2),
+            on.next(220, 3),
+            on.next(270, 4),
+            on.completed(400)
+        });
+
+        rxsub::unicast_subject<int> s;
+
+        auto results1 = w.make_subscriber<int>();
+
+        auto results2 = w.make_subscriber<int>();
+
+        WHEN("two subscribers are added"){
+
+            w.schedule_absolute(100, [&xs, &s](const rxsc::schedulable&){
+                xs.subscribe(s.get_subscriber());});
+            w.schedule_absolute(200, [&s, &results1](const rxsc::schedulable&){
+                s.get_observable().subscribe(results1);});
+            w.schedule_absolute(300, [&s, &results2](const rxsc::schedulable&){
+                s.get_observable().subscribe(results2);});
+
+            w.start();
+
+            THEN("result1 contains the queued items and then the later items"){
+                auto required = rxu::to_vector({
+                    on.next(200, 1),
+                    on.next(200, 2),
+                    on.next(220, 3),
+                    on.next(270, 4),
+                    on.completed(400)
+                });
+                auto actual = results1.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("result2 is refused"){
+                auto required = rxu::to_vector({
+                    on.error(300, rxcpp::unicast_subject_error("unicast_subject already has a subscriber"))
+                });
+                auto actual = results2.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("unicast_subject - subscriber after completion", "[unicast_subject][subjects]"){
+    GIVEN("a unicast_subject and a hot source"){
+
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(110, 1),
+            on.next(150, 2),
+            on.completed(160)
+        });
+
+        rxsub::unicast_subject<int> s;
+
+        auto results1 = w.make_subscriber<int>();
+
+        WHEN("the subscriber is added after the source completed"){
+
+            w.schedule_absolute(100, [&xs, &s](const rxsc::schedulable&){
+                xs.subscribe(s.get_subscriber());});
+            w.schedule_absolute(200, [&s, &results1](const rxsc::schedulable&){
+                s.get_observable().subscribe(results1);});
+
+            w.start();
+
+            THEN("result1 contains the queued items and the completion"){
+                auto required = rxu::to_vector({
+                    on.next(200, 1),
+                    on.next(200, 2),
+                    on.completed(200)
+                });
+                auto actual = results1.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("unicast_subject - bounded queue", "[unicast_subject][subjects]"){
+    GIVEN("a unicast_subject with a capacity of 2 and a hot source"){
+
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(110, 1),
+            on.next(120, 2),
+            on.next(130, 3),
+            on.next(220, 4),
+            on.completed(400)
+        });
+
+        rxsub::unicast_subject<int> s(2);
+
+        auto results1 = w.make_subscriber<int>();
+
+        WHEN("more items than the capacity arrive before the subscriber"){
+
+            w.schedule_absolute(100, [&xs, &s](const rxsc::schedulable&){
+                xs.subscribe(s.get_subscriber());});
+            w.schedule_absolute(200, [&s, &results1](const rxsc::schedulable&){
+                s.get_observable().subscribe(results1);});
+
+            w.start();
+
+            THEN("result1 contains the queued items and the overflow error"){
+                auto required = rxu::to_vector({
+                    on.next(200, 1),
+                    on.next(200, 2),
+                    on.error(200, rxcpp::unicast_subject_error("unicast_subject queue overflow"))
+                });
+                auto actual = results1.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("the source was unsubscribed when the queue overflowed"){
+                auto required = rxu::to_vector({
+                    on.subscribe(100, 130)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
@@ -0,0 +1,197 @@
+#include "../test.h"
+#include "rxcpp/operators/rx-observe_on.hpp"
+#include "rxcpp/operators/rx-reduce.hpp"
+#include "rxcpp/operators/rx-take.hpp"
+
+SCENARIO("blocking methods return when the source finishes during subscribe", "[blocking][subscriptions]"){
+    GIVEN("a range on the current thread"){
+        auto xs = rxs::range(1, 5);
+
+        WHEN("each blocking method is called"){
+
+            THEN("the values are reduced"){
+                REQUIRE(1 == xs.as_blocking().first());
+                REQUIRE(5 == xs.as_blocking().last());
+                REQUIRE(5 == xs.as_blocking().count());
+                REQUIRE(15 == xs.as_blocking().sum());
+                REQUIRE(1 == xs.as_blocking().min());
+                REQUIRE(5 == xs.as_blocking().max());
+            }
+        }
+    }
+}
+
+SCENARIO("blocking methods wait for a source on another thread", "[blocking][subscriptions]"){
+    GIVEN("a range on a new thread"){
+        auto xs = rxs::range(1, 1000, rx::observe_on_new_thread());
+
+        WHEN("each blocking method is called"){
+
+            THEN("the values are reduced"){
+                REQUIRE(1 == xs.as_blocking().first());
+                REQUIRE(1000 == xs.as_blocking().last());
+                REQUIRE(1000 == xs.as_blocking().count());
+                REQUIRE(500500 == xs.as_blocking().sum());
+                REQUIRE(1 == xs.as_blocking().min());
+                REQUIRE(1000 == xs.as_blocking().max());
+            }
+        }
+
+        WHEN("first is called many times"){
+
+            int total = 0;
+            for (int i = 0; i < 200; ++i) {
+                total += xs.take(1).as_blocking().first();
+            }
+
+            THEN("each call returned the first value"){
+                REQUIRE(200 == total);
+            }
+        }
+    }
+}
+
+SCENARIO("blocking methods rethrow errors and reject empty sources", "[blocking][subscriptions]"){
+    GIVEN("a source that fails and a source that is empty"){
+        std::runtime_error ex("blocking on_error from source");
+
+        auto xs = rxs::error<int>(ex);
+        auto ys = rxs::empty<int>();
+
+        WHEN("the failing source is counted"){
+
+            bool thrown = false;
+            RXCPP_TRY {
+                xs.as_blocking().count();
+            } RXCPP_CATCH(const std::runtime_error&) {
+                thrown = true;
+            }
+
+            THEN("the error was rethrown"){
+                REQUIRE(thrown);
+            }
+        }
+
+        WHEN("the empty source is reduced"){
+
+            int thrown = 0;
+            RXCPP_TRY {
+                ys.as_blocking().sum();
+            } RXCPP_CATCH(const rx::empty_error&) {
+                ++thrown;
+            }
+            RXCPP_TRY {
+                ys.as_blocking().min();
+            } RXCPP_CATCH(const rx::empty_error&) {
+                ++thrown;
+            }
+            RXCPP_TRY {
+                ys.as_blocking().max();
+            } RXCPP_CATCH(const rx::empty_error&) {
+                ++thrown;
+            }
+
+            THEN("each method threw empty_error"){
+                REQUIRE(3 == thrown);
+                REQUIRE(0 == ys.as_blocking().count());
+            }
+        }
+    }
+}
+
+SCENARIO("blocking sum, min and max reduce an iterate source in one batch", "[blocking][subscriptions]"){
+    GIVEN("an iterate source over a vector"){
+        std::vector<int> values(10000);
+        for (int i = 0; i < 10000; ++i) {
+            values[i] = (i * 7919) % 10000 + 1;
+        }
+        auto xs = rxs::iterate(values);
+        auto ys = rxs::iterate(std::vector<int>());
+
+        WHEN("the types are checked"){
+
+            typedef decltype(blocking_batch_reducible(xs, rx::sum_tag(), 0)) iterate_sum;
+            typedef decltype(blocking_batch_reducible(xs, rx::max_tag(), 0)) iterate_max;
+            typedef decltype(blocking_batch_reducible(xs, rx::min_tag(), 0)) iterate_min;
+            auto zs = rxs::range(1, 5);
+            typedef decltype(blocking_batch_reducible(zs, rx::sum_tag(), 0)) range_sum;
+            auto ds = zs.as_dynamic();
+            typedef decltype(blocking_batch_reducible(ds, rx::sum_tag(), 0)) dynamic_sum;
+
+            THEN("only the iterate and range sources take the batch path"){
+                REQUIRE(iterate_sum::value);
+                REQUIRE(iterate_max::value);
+                REQUIRE(iterate_min::value);
+                REQUIRE(range_sum::value);
+                REQUIRE_FALSE(dynamic_sum::value);
+            }
+        }
+
+        WHEN("each blocking method is called"){
+
+            THEN("the values are reduced"){
+                REQUIRE(50005000 == xs.as_blocking().sum());
+                REQUIRE(1 == xs.as_blocking().min());
+                REQUIRE(10000 == xs.as_blocking().max());
+            }
+        }
+
+        WHEN("the empty source is reduced"){
+
+            int thrown = 0;
+            RXCPP_TRY {
+                ys.as_blocking().sum();
+            } RXCPP_CATCH(const rx::empty_error&) {
+                ++thrown;
+            }
+            RXCPP_TRY {
+                ys.as_blocking().min();
+            } RXCPP_CATCH(const rx::empty_error&) {
+                ++thrown;
+            }
+            RXCPP_TRY {
+                ys.as_blocking().max();
+            } RXCPP_CATCH(const rx::empty_error&) {
+                ++thrown;
+            }
+
+            THEN("each method threw empty_error"){
+                REQUIRE(3 == thrown);
+            }
+        }
+    }
+}
+
+SCENARIO("blocking completion hands off to the waiting thread", "[blocking][subscriptions]"){
+    GIVEN("completions that are set on another thread"){
+
+        WHEN("each completion is destroyed as soon as the wait returns"){
+
+            int completed = 0;
+            for (int i = 0; i < 500; ++i) {
+                std::unique_ptr<rx::detail::blocking_completion> completion(new rx::detail::blocking_completion());
+                std::thread setter([&](){
+                    completion->set();
+                });
+                completion->wait();
+                REQUIRE(completion->is_set());
+                completion.reset();
+                ++completed;
+                setter.join();
+            }
+
+            THEN("every wait returned"){
+                REQUIRE(500 == completed);
+            }
+        }
+
+#if defined(__cpp_lib_atomic_wait) && !defined(RXCPP_FORCE_USE_ATOMIC_WAIT)
+        WHEN("the standard library has std::atomic wait"){
+
+            THEN("the completion waits on the atomic"){
+                REQUIRE(1 == RXCPP_USE_ATOMIC_WAIT);
+            }
+        }
+#endif
+    }
+}
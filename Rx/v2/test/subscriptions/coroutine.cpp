@@ -1,8 +1,385 @@
 #include "../test.h"
+#include "rxcpp/operators/rx-observe_on.hpp"
+#include "rxcpp/operators/rx-reduce.hpp"
+#include "rxcpp/operators/rx-take.hpp"
 
 #include <rxcpp/rx-coroutine.hpp>
 
-#ifdef _RESUMABLE_FUNCTIONS_SUPPORTED
+#if RXCPP_USE_STD_COROUTINES
+
+namespace {
+
+// starts when called and runs until the coroutine finishes
+struct co_task
+{
+    struct promise_type
+    {
+        co_task get_return_object() { return co_task(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+}
+
+SCENARIO("co_await sends the last value of an observable", "[coroutine]"){
+    GIVEN("a source") {
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(110, 1),
+            on.next(210, 2),
+            on.next(310, 10),
+            on.completed(350)
+        });
+
+        WHEN("the first value is awaited"){
+
+            std::vector<typename rxsc::test::messages<int>::recorded_type> messages;
+
+            w.advance_to(rxsc::test::subscribed_time);
+
+            auto run = [&]() -> co_task {
+                auto n = co_await xs.first();
+                messages.push_back(on.next(w.clock(), n));
+            };
+            run();
+
+            w.advance_to(rxsc::test::unsubscribed_time);
+
+            THEN("the output only contains the first value"){
+                auto required = rxu::to_vector({
+                    on.next(210, 2)
+                });
+                auto actual = messages;
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 210)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("the last value is awaited"){
+
+            std::vector<typename rxsc::test::messages<int>::recorded_type> messages;
+
+            w.advance_to(rxsc::test::subscribed_time);
+
+            auto run = [&]() -> co_task {
+                auto n = co_await xs.last();
+                messages.push_back(on.next(w.clock(), n));
+            };
+            run();
+
+            w.advance_to(rxsc::test::unsubscribed_time);
+
+            THEN("the output only contains the last value"){
+                auto required = rxu::to_vector({
+                    on.next(350, 10)
+                });
+                auto actual = messages;
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("all the values are awaited"){
+
+            std::vector<int> actual;
+            bool resumed = false;
+
+            auto run = [&]() -> co_task {
+                actual = co_await rxcpp::coroutine::to_vector(rxs::range(1, 5));
+                resumed = true;
+            };
+            run();
+
+            THEN("the coroutine finished during the call"){
+                REQUIRE(resumed);
+            }
+
+            THEN("the output contains all the values"){
+                auto required = rxu::to_vector({1, 2, 3, 4, 5});
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("co_await throws the error of an observable", "[coroutine]"){
+    GIVEN("a source") {
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        std::runtime_error ex("error in source");
+
+        auto xs = sc.make_hot_observable({
+            on.next(110, 1),
+            on.error(310, ex)
+        });
+
+        auto ys = sc.make_hot_observable({
+            on.next(110, 1),
+            on.completed(250)
+        });
+
+        WHEN("the last value is awaited"){
+
+            std::vector<typename rxsc::test::messages<int>::recorded_type> messages;
+
+            w.advance_to(rxsc::test::subscribed_time);
+
+            auto run = [&]() -> co_task {
+                RXCPP_TRY {
+                    messages.push_back(on.next(w.clock(), co_await xs.last()));
+                } RXCPP_CATCH(...) {
+                    messages.push_back(on.error(w.clock(), rxu::current_exception()));
+                }
+            };
+            run();
+
+            w.advance_to(rxsc::test::unsubscribed_time);
+
+            THEN("the output only contains the error"){
+                auto required = rxu::to_vector({
+                    on.error(310, ex)
+                });
+                auto actual = messages;
+                REQUIRE(required == actual);
+            }
+        }
+
+        WHEN("an empty source is awaited"){
+
+            bool empty = false;
+
+            w.advance_to(rxsc::test::subscribed_time);
+
+            auto run = [&]() -> co_task {
+                RXCPP_TRY {
+                    co_await (ys | rxo::as_dynamic());
+                } RXCPP_CATCH(const rx::empty_error&) {
+                    empty = true;
+                }
+            };
+            run();
+
+            w.advance_to(rxsc::test::unsubscribed_time);
+
+            THEN("empty_error was thrown"){
+                REQUIRE(empty);
+            }
+        }
+    }
+}
+
+SCENARIO("from_generator sends the values yielded by a coroutine", "[coroutine]"){
+    GIVEN("a source") {
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(110, 1),
+            on.next(210, 2),
+            on.completed(250)
+        });
+
+        WHEN("the generator awaits the source between values"){
+
+            auto res = w.start(
+                [&]() {
+                    return rxcpp::coroutine::from_generator([xs]() -> rxcpp::coroutine::async_generator<int> {
+                        co_yield 1;
+                        co_yield co_await xs.first();
+                        co_yield 3;
+                    });
+                }
+            );
+
+            THEN("the output contains the yielded values"){
+                auto required = rxu::to_vector({
+                    on.next(200, 1),
+                    on.next(210, 2),
+                    on.next(210, 3),
+                    on.completed(210)
+                });
+                auto actual = res.get_observer().messages();
+                REQUIRE(required == actual);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 210)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("from_generator destroys the coroutine when unsubscribed", "[coroutine]"){
+    GIVEN("a generator that never completes") {
+        auto sc = rxsc::make_test();
+        auto w = sc.create_worker();
+        const rxsc::test::messages<int> on;
+
+        auto xs = sc.make_hot_observable({
+            on.next(110, 1)
+        });
+
+        int destroyed = 0;
+        struct destroy_counter
+        {
+            int* count;
+            ~destroy_counter() { ++*count; }
+        };
+
+        WHEN("the subscriber takes three values"){
+
+            std::vector<int> actual;
+
+            rxcpp::coroutine::from_generator([&]() -> rxcpp::coroutine::async_generator<int> {
+                    destroy_counter counter{&destroyed};
+                    for (int i = 0;; ++i) {
+                        co_yield i;
+                    }
+                })
+                .take(3)
+                .subscribe([&](int v){ actual.push_back(v); });
+
+            THEN("the output contains three values"){
+                auto required = rxu::to_vector({0, 1, 2});
+                REQUIRE(required == actual);
+            }
+
+            THEN("the coroutine was destroyed"){
+                REQUIRE(1 == destroyed);
+            }
+        }
+
+        WHEN("the subscriber is unsubscribed while the generator awaits the source"){
+
+            w.advance_to(rxsc::test::subscribed_time);
+
+            rx::composite_subscription cs;
+            rxcpp::coroutine::from_generator([&]() -> rxcpp::coroutine::async_generator<int> {
+                    destroy_counter counter{&destroyed};
+                    co_yield co_await xs.first();
+                })
+                .subscribe(cs, [](int){});
+
+            int before = destroyed;
+            cs.unsubscribe();
+
+            THEN("the coroutine was destroyed by unsubscribe"){
+                REQUIRE(0 == before);
+                REQUIRE(1 == destroyed);
+            }
+
+            THEN("there was 1 subscription/unsubscription to the source"){
+                auto required = rxu::to_vector({
+                    on.subscribe(200, 200)
+                });
+                auto actual = xs.subscriptions();
+                REQUIRE(required == actual);
+            }
+        }
+    }
+}
+
+SCENARIO("a buffered iterator sends the values of an observable", "[coroutine]"){
+    GIVEN("sources") {
+        WHEN("a range is iterated through a buffer of two values"){
+
+            std::vector<int> actual;
+            bool completed = false;
+
+            auto xs = rxs::range(1, 5);
+            auto run = [&]() -> co_task {
+                for (auto it = co_await rxcpp::coroutine::begin(xs, 2); it != rxcpp::coroutine::end(xs); co_await ++it) {
+                    actual.push_back(*it);
+                }
+                completed = true;
+            };
+            run();
+
+            THEN("the output contains all the values"){
+                auto required = rxu::to_vector({1, 2, 3, 4, 5});
+                REQUIRE(required == actual);
+                REQUIRE(completed);
+            }
+        }
+
+        WHEN("a subject is iterated and then fails"){
+
+            std::runtime_error ex("error in subject");
+
+            std::vector<int> actual;
+            bool failed = false;
+
+            rxsub::subject<int> s;
+            auto xs = s.get_observable();
+            auto run = [&]() -> co_task {
+                RXCPP_TRY {
+                    for (auto it = co_await rxcpp::coroutine::begin(xs, 2); it != rxcpp::coroutine::end(xs); co_await ++it) {
+                        actual.push_back(*it);
+                    }
+                } RXCPP_CATCH(...) {
+                    failed = true;
+                }
+            };
+            run();
+
+            auto o = s.get_subscriber();
+            o.on_next(1);
+            o.on_next(2);
+            auto before = actual;
+            o.on_error(rxu::make_error_ptr(ex));
+
+            THEN("each value was sent to the coroutine when it arrived"){
+                auto required = rxu::to_vector({1, 2});
+                REQUIRE(required == before);
+            }
+
+            THEN("the error was thrown in the coroutine"){
+                REQUIRE(failed);
+            }
+        }
+
+        WHEN("a range on a new thread is iterated"){
+
+            std::promise<long> result;
+            auto sum = result.get_future();
+
+            auto xs = rxs::range(1, 1000, rx::observe_on_new_thread());
+            auto run = [&]() -> co_task {
+                long total = 0;
+                for (auto it = co_await rxcpp::coroutine::begin(xs, 16); it != rxcpp::coroutine::end(xs); co_await ++it) {
+                    total += *it;
+                }
+                result.set_value(total);
+            };
+            run();
+
+            THEN("the output contains all the values"){
+                REQUIRE(500500 == sum.get());
+            }
+        }
+    }
+}
+
+#elif defined(_RESUMABLE_FUNCTIONS_SUPPORTED)
 
 SCENARIO("coroutine completes", "[coroutine]"){
     GIVEN("a source") {